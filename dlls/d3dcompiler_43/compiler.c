@@ -39,10 +39,6 @@ struct mem_file_desc
     unsigned int pos;
 };
 
-static struct mem_file_desc current_shader;
-static ID3DInclude *current_include;
-static const char *initial_filename;
-
 #define INCLUDES_INITIAL_CAPACITY 4
 
 struct loaded_include
@@ -51,19 +47,30 @@ struct loaded_include
     const char *data;
 };
 
-static struct loaded_include *includes;
-static int includes_capacity, includes_size;
-static const char *parent_include;
+/* The state of one preprocess_shader() call. The output belongs to the
+ * caller afterwards. */
+struct preprocess_state
+{
+    struct mem_file_desc shader;
+    ID3DInclude *include;
+    const char *initial_filename;
+
+    struct loaded_include *includes;
+    int includes_capacity, includes_size;
+    const char *parent_include;
 
-static char *wpp_output;
-static int wpp_output_capacity, wpp_output_size;
+    char *output;
+    int output_capacity, output_size;
 
-static char *wpp_messages;
-static int wpp_messages_capacity, wpp_messages_size;
+    char *messages;
+    int messages_capacity, messages_size;
+};
 
-/* Mutex used to guarantee a single invocation
-   of the D3DXAssembleShader function (or its variants) at a time.
-   This is needed as wpp isn't thread-safe */
+/* wpp isn't thread-safe and has no way to pass a context to its callbacks.
+ * wpp_mutex serializes preprocess_shader(), the state of the call in
+ * progress is in wpp_state. Everything after preprocessing runs outside of
+ * it. */
+static struct preprocess_state *wpp_state;
 static CRITICAL_SECTION wpp_mutex;
 static CRITICAL_SECTION_DEBUG wpp_mutex_debug =
 {
@@ -74,42 +81,53 @@ static CRITICAL_SECTION_DEBUG wpp_mutex_debug =
 };
 static CRITICAL_SECTION wpp_mutex = { &wpp_mutex_debug, -1, 0, 0, 0, 0 };
 
+/* The assembler and HLSL parsers keep their state in globals as well. */
+static CRITICAL_SECTION parser_mutex;
+static CRITICAL_SECTION_DEBUG parser_mutex_debug =
+{
+    0, 0, &parser_mutex,
+    { &parser_mutex_debug.ProcessLocksList,
+      &parser_mutex_debug.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": parser_mutex") }
+};
+static CRITICAL_SECTION parser_mutex = { &parser_mutex_debug, -1, 0, 0, 0, 0 };
+
 /* Preprocessor error reporting functions */
 static void wpp_write_message(const char *fmt, va_list args)
 {
     char* newbuffer;
     int rc, newsize;
 
-    if(wpp_messages_capacity == 0)
+    if(wpp_state->messages_capacity == 0)
     {
-        wpp_messages = HeapAlloc(GetProcessHeap(), 0, MESSAGEBUFFER_INITIAL_SIZE);
-        if(wpp_messages == NULL)
+        wpp_state->messages = HeapAlloc(GetProcessHeap(), 0, MESSAGEBUFFER_INITIAL_SIZE);
+        if(wpp_state->messages == NULL)
             return;
 
-        wpp_messages_capacity = MESSAGEBUFFER_INITIAL_SIZE;
+        wpp_state->messages_capacity = MESSAGEBUFFER_INITIAL_SIZE;
     }
 
     while(1)
     {
-        rc = vsnprintf(wpp_messages + wpp_messages_size,
-                       wpp_messages_capacity - wpp_messages_size, fmt, args);
+        rc = vsnprintf(wpp_state->messages + wpp_state->messages_size,
+                       wpp_state->messages_capacity - wpp_state->messages_size, fmt, args);
 
         if (rc < 0 ||                                           /* C89 */
-            rc >= wpp_messages_capacity - wpp_messages_size) {  /* C99 */
+            rc >= wpp_state->messages_capacity - wpp_state->messages_size) {  /* C99 */
             /* Resize the buffer */
-            newsize = wpp_messages_capacity * 2;
-            newbuffer = HeapReAlloc(GetProcessHeap(), 0, wpp_messages, newsize);
+            newsize = wpp_state->messages_capacity * 2;
+            newbuffer = HeapReAlloc(GetProcessHeap(), 0, wpp_state->messages, newsize);
             if(newbuffer == NULL)
             {
                 ERR("Error reallocating memory for parser messages\n");
                 return;
             }
-            wpp_messages = newbuffer;
-            wpp_messages_capacity = newsize;
+            wpp_state->messages = newbuffer;
+            wpp_state->messages_capacity = newsize;
         }
         else
         {
-            wpp_messages_size += rc;
+            wpp_state->messages_size += rc;
             return;
         }
     }
@@ -152,18 +170,18 @@ static char *wpp_lookup_mem(const char *filename, int type, const char *parent_n
 
     TRACE("Looking for include %s, parent %s.\n", debugstr_a(filename), debugstr_a(parent_name));
 
-    parent_include = NULL;
-    if (strcmp(parent_name, initial_filename))
+    wpp_state->parent_include = NULL;
+    if (strcmp(parent_name, wpp_state->initial_filename))
     {
-        for(i = 0; i < includes_size; i++)
+        for(i = 0; i < wpp_state->includes_size; i++)
         {
-            if(!strcmp(parent_name, includes[i].name))
+            if(!strcmp(parent_name, wpp_state->includes[i].name))
             {
-                parent_include = includes[i].data;
+                wpp_state->parent_include = wpp_state->includes[i].data;
                 break;
             }
         }
-        if(parent_include == NULL)
+        if(wpp_state->parent_include == NULL)
         {
             ERR("Parent include %s missing.\n", debugstr_a(parent_name));
             return NULL;
@@ -183,58 +201,59 @@ static void *wpp_open_mem(const char *filename, int type)
 
     TRACE("Opening include %s.\n", debugstr_a(filename));
 
-    if(!strcmp(filename, initial_filename))
+    if(!strcmp(filename, wpp_state->initial_filename))
     {
-        current_shader.pos = 0;
-        return &current_shader;
+        wpp_state->shader.pos = 0;
+        return &wpp_state->shader;
     }
 
-    if(current_include == NULL) return NULL;
+    if(wpp_state->include == NULL) return NULL;
     desc = HeapAlloc(GetProcessHeap(), 0, sizeof(*desc));
     if(!desc)
         return NULL;
 
-    if (FAILED(hr = ID3DInclude_Open(current_include, type ? D3D_INCLUDE_LOCAL : D3D_INCLUDE_SYSTEM,
-            filename, parent_include, (const void **)&desc->buffer, &desc->size)))
+    if (FAILED(hr = ID3DInclude_Open(wpp_state->include, type ? D3D_INCLUDE_LOCAL : D3D_INCLUDE_SYSTEM,
+            filename, wpp_state->parent_include, (const void **)&desc->buffer, &desc->size)))
     {
         HeapFree(GetProcessHeap(), 0, desc);
         return NULL;
     }
 
-    if(includes_capacity == includes_size)
+    if(wpp_state->includes_capacity == wpp_state->includes_size)
     {
-        if(includes_capacity == 0)
+        if(wpp_state->includes_capacity == 0)
         {
-            includes = HeapAlloc(GetProcessHeap(), 0, INCLUDES_INITIAL_CAPACITY * sizeof(*includes));
-            if(includes == NULL)
+            wpp_state->includes = HeapAlloc(GetProcessHeap(), 0,
+                    INCLUDES_INITIAL_CAPACITY * sizeof(*wpp_state->includes));
+            if(wpp_state->includes == NULL)
             {
                 ERR("Error allocating memory for the loaded includes structure\n");
                 goto error;
             }
-            includes_capacity = INCLUDES_INITIAL_CAPACITY * sizeof(*includes);
+            wpp_state->includes_capacity = INCLUDES_INITIAL_CAPACITY * sizeof(*wpp_state->includes);
         }
         else
         {
-            int newcapacity = includes_capacity * 2;
+            int newcapacity = wpp_state->includes_capacity * 2;
             struct loaded_include *newincludes =
-                HeapReAlloc(GetProcessHeap(), 0, includes, newcapacity);
+                HeapReAlloc(GetProcessHeap(), 0, wpp_state->includes, newcapacity);
             if(newincludes == NULL)
             {
                 ERR("Error reallocating memory for the loaded includes structure\n");
                 goto error;
             }
-            includes = newincludes;
-            includes_capacity = newcapacity;
+            wpp_state->includes = newincludes;
+            wpp_state->includes_capacity = newcapacity;
         }
     }
-    includes[includes_size].name = filename;
-    includes[includes_size++].data = desc->buffer;
+    wpp_state->includes[wpp_state->includes_size].name = filename;
+    wpp_state->includes[wpp_state->includes_size++].data = desc->buffer;
 
     desc->pos = 0;
     return desc;
 
 error:
-    ID3DInclude_Close(current_include, desc->buffer);
+    ID3DInclude_Close(wpp_state->include, desc->buffer);
     HeapFree(GetProcessHeap(), 0, desc);
     return NULL;
 }
@@ -243,12 +262,12 @@ static void wpp_close_mem(void *file)
 {
     struct mem_file_desc *desc = file;
 
-    if(desc != &current_shader)
+    if(desc != &wpp_state->shader)
     {
-        if(current_include)
-            ID3DInclude_Close(current_include, desc->buffer);
+        if(wpp_state->include)
+            ID3DInclude_Close(wpp_state->include, desc->buffer);
         else
-            ERR("current_include == NULL, desc == %p, buffer = %s\n",
+            ERR("include == NULL, desc == %p, buffer = %s\n",
                 desc, desc->buffer);
 
         HeapFree(GetProcessHeap(), 0, desc);
@@ -269,50 +288,50 @@ static void wpp_write_mem(const char *buffer, unsigned int len)
 {
     char *new_wpp_output;
 
-    if(wpp_output_capacity == 0)
+    if(wpp_state->output_capacity == 0)
     {
-        wpp_output = HeapAlloc(GetProcessHeap(), 0, BUFFER_INITIAL_CAPACITY);
-        if(!wpp_output)
+        wpp_state->output = HeapAlloc(GetProcessHeap(), 0, BUFFER_INITIAL_CAPACITY);
+        if(!wpp_state->output)
             return;
 
-        wpp_output_capacity = BUFFER_INITIAL_CAPACITY;
+        wpp_state->output_capacity = BUFFER_INITIAL_CAPACITY;
     }
-    if(len > wpp_output_capacity - wpp_output_size)
+    if(len > wpp_state->output_capacity - wpp_state->output_size)
     {
-        while(len > wpp_output_capacity - wpp_output_size)
+        while(len > wpp_state->output_capacity - wpp_state->output_size)
         {
-            wpp_output_capacity *= 2;
+            wpp_state->output_capacity *= 2;
         }
-        new_wpp_output = HeapReAlloc(GetProcessHeap(), 0, wpp_output,
-                                     wpp_output_capacity);
+        new_wpp_output = HeapReAlloc(GetProcessHeap(), 0, wpp_state->output,
+                                     wpp_state->output_capacity);
         if(!new_wpp_output)
         {
             ERR("Error allocating memory\n");
             return;
         }
-        wpp_output = new_wpp_output;
+        wpp_state->output = new_wpp_output;
     }
-    memcpy(wpp_output + wpp_output_size, buffer, len);
-    wpp_output_size += len;
+    memcpy(wpp_state->output + wpp_state->output_size, buffer, len);
+    wpp_state->output_size += len;
 }
 
 static int wpp_close_output(void)
 {
-    char *new_wpp_output = HeapReAlloc(GetProcessHeap(), 0, wpp_output,
-                                       wpp_output_size + 1);
+    char *new_wpp_output = HeapReAlloc(GetProcessHeap(), 0, wpp_state->output,
+                                       wpp_state->output_size + 1);
     if(!new_wpp_output) return 0;
-    wpp_output = new_wpp_output;
-    wpp_output[wpp_output_size]='\0';
-    wpp_output_size++;
+    wpp_state->output = new_wpp_output;
+    wpp_state->output[wpp_state->output_size]='\0';
+    wpp_state->output_size++;
     return 1;
 }
 
-static HRESULT preprocess_shader(const void *data, SIZE_T data_size, const char *filename,
-        const D3D_SHADER_MACRO *defines, ID3DInclude *include, ID3DBlob **error_messages)
+static HRESULT preprocess_shader(struct preprocess_state *state, const void *data, SIZE_T data_size,
+        const char *filename, const D3D_SHADER_MACRO *defines, ID3DInclude *include, ID3DBlob **error_messages)
 {
     int ret;
     HRESULT hr = S_OK;
-    const D3D_SHADER_MACRO *def = defines;
+    const D3D_SHADER_MACRO *def;
 
     static const struct wpp_callbacks wpp_callbacks =
     {
@@ -325,7 +344,16 @@ static HRESULT preprocess_shader(const void *data, SIZE_T data_size, const char
         wpp_warning,
     };
 
-    if (def != NULL)
+    memset(state, 0, sizeof(*state));
+    state->include = include;
+    state->shader.buffer = data;
+    state->shader.size = data_size;
+    state->initial_filename = filename ? filename : "";
+
+    EnterCriticalSection(&wpp_mutex);
+    wpp_state = state;
+
+    if ((def = defines))
     {
         while (def->Name != NULL)
         {
@@ -333,39 +361,42 @@ static HRESULT preprocess_shader(const void *data, SIZE_T data_size, const char
             def++;
         }
     }
-    current_include = include;
-    includes_size = 0;
-
-    wpp_output_size = wpp_output_capacity = 0;
-    wpp_output = NULL;
 
     wpp_set_callbacks(&wpp_callbacks);
-    wpp_messages_size = wpp_messages_capacity = 0;
-    wpp_messages = NULL;
-    current_shader.buffer = data;
-    current_shader.size = data_size;
-    initial_filename = filename ? filename : "";
-
-    ret = wpp_parse(initial_filename, NULL);
+    ret = wpp_parse(state->initial_filename, NULL);
     if (!wpp_close_output())
         ret = 1;
+
+    /* Remove the previously added defines */
+    if ((def = defines))
+    {
+        while (def->Name != NULL)
+        {
+            wpp_del_define(def->Name);
+            def++;
+        }
+    }
+
+    wpp_state = NULL;
+    LeaveCriticalSection(&wpp_mutex);
+
     if (ret)
     {
         TRACE("Error during shader preprocessing\n");
-        if (wpp_messages)
+        if (state->messages)
         {
             int size;
             ID3DBlob *buffer;
 
-            TRACE("Preprocessor messages:\n%s\n", debugstr_a(wpp_messages));
+            TRACE("Preprocessor messages:\n%s\n", debugstr_a(state->messages));
 
             if (error_messages)
             {
-                size = strlen(wpp_messages) + 1;
+                size = strlen(state->messages) + 1;
                 hr = D3DCreateBlob(size, &buffer);
                 if (FAILED(hr))
                     goto cleanup;
-                CopyMemory(ID3D10Blob_GetBufferPointer(buffer), wpp_messages, size);
+                CopyMemory(ID3D10Blob_GetBufferPointer(buffer), state->messages, size);
                 *error_messages = buffer;
             }
         }
@@ -375,16 +406,8 @@ static HRESULT preprocess_shader(const void *data, SIZE_T data_size, const char
     }
 
 cleanup:
-    /* Remove the previously added defines */
-    if (defines != NULL)
-    {
-        while (defines->Name != NULL)
-        {
-            wpp_del_define(defines->Name);
-            defines++;
-        }
-    }
-    HeapFree(GetProcessHeap(), 0, wpp_messages);
+    HeapFree(GetProcessHeap(), 0, state->messages);
+    HeapFree(GetProcessHeap(), 0, state->includes);
     return hr;
 }
 
@@ -398,7 +421,9 @@ static HRESULT assemble_shader(const char *preproc_shader,
     ID3DBlob *buffer;
     char *pos;
 
+    EnterCriticalSection(&parser_mutex);
     shader = SlAssembleShader(preproc_shader, &messages);
+    LeaveCriticalSection(&parser_mutex);
 
     if (messages)
     {
@@ -469,26 +494,24 @@ HRESULT WINAPI D3DAssemble(const void *data, SIZE_T datasize, const char *filena
         const D3D_SHADER_MACRO *defines, ID3DInclude *include, UINT flags,
         ID3DBlob **shader, ID3DBlob **error_messages)
 {
+    struct preprocess_state state;
     HRESULT hr;
 
     TRACE("data %p, datasize %lu, filename %s, defines %p, include %p, sflags %#x, "
             "shader %p, error_messages %p.\n",
             data, datasize, debugstr_a(filename), defines, include, flags, shader, error_messages);
 
-    EnterCriticalSection(&wpp_mutex);
-
     /* TODO: flags */
     if (flags) FIXME("flags %x\n", flags);
 
     if (shader) *shader = NULL;
     if (error_messages) *error_messages = NULL;
 
-    hr = preprocess_shader(data, datasize, filename, defines, include, error_messages);
+    hr = preprocess_shader(&state, data, datasize, filename, defines, include, error_messages);
     if (SUCCEEDED(hr))
-        hr = assemble_shader(wpp_output, shader, error_messages);
+        hr = assemble_shader(state.output, shader, error_messages);
 
-    HeapFree(GetProcessHeap(), 0, wpp_output);
-    LeaveCriticalSection(&wpp_mutex);
+    HeapFree(GetProcessHeap(), 0, state.output);
     return hr;
 }
 
@@ -625,7 +648,9 @@ static HRESULT compile_shader(const char *preproc_shader, const char *target, co
         }
     }
 
+    EnterCriticalSection(&parser_mutex);
     shader = parse_hlsl_shader(preproc_shader, shader_type, major, minor, entrypoint, &messages);
+    LeaveCriticalSection(&parser_mutex);
 
     if (messages)
     {
@@ -692,12 +717,262 @@ static HRESULT compile_shader(const char *preproc_shader, const char *target, co
     return S_OK;
 }
 
+/* The results of compile_shader() depend only on the preprocessed source, the
+ * target, the entry point and the compilation flags. They are cached under
+ * that key, so compiling the same permutation again only costs preprocessing. */
+#define COMPILE_CACHE_MAX_SIZE (16 * 1024 * 1024)
+
+struct compile_cache_key
+{
+    DWORD hash;
+    SIZE_T size;
+    const char *data;
+};
+
+struct compile_cache_entry
+{
+    struct wine_rb_entry entry;
+    struct list lru_entry;
+    struct compile_cache_key key;
+    HRESULT hr;
+    SIZE_T bytecode_size;
+    SIZE_T messages_size;
+    char data[1];
+};
+
+static int compile_cache_compare(const void *key, const struct wine_rb_entry *entry)
+{
+    const struct compile_cache_entry *e = WINE_RB_ENTRY_VALUE(entry, const struct compile_cache_entry, entry);
+    const struct compile_cache_key *k = key;
+
+    if (k->hash != e->key.hash)
+        return k->hash < e->key.hash ? -1 : 1;
+    if (k->size != e->key.size)
+        return k->size < e->key.size ? -1 : 1;
+    return memcmp(k->data, e->key.data, k->size);
+}
+
+static CRITICAL_SECTION compile_cache_mutex;
+static CRITICAL_SECTION_DEBUG compile_cache_mutex_debug =
+{
+    0, 0, &compile_cache_mutex,
+    { &compile_cache_mutex_debug.ProcessLocksList,
+      &compile_cache_mutex_debug.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": compile_cache_mutex") }
+};
+static CRITICAL_SECTION compile_cache_mutex = { &compile_cache_mutex_debug, -1, 0, 0, 0, 0 };
+
+/* Protected by compile_cache_mutex. */
+static struct wine_rb_tree compile_cache = {compile_cache_compare, NULL};
+static struct list compile_cache_lru = LIST_INIT(compile_cache_lru);
+static SIZE_T compile_cache_size;
+static unsigned int compile_cache_hits, compile_cache_misses;
+
+static char *compile_cache_build_key(const char *preproc_shader, const char *target,
+        const char *entrypoint, UINT sflags, UINT eflags, struct compile_cache_key *key)
+{
+    SIZE_T source_size = strlen(preproc_shader) + 1, target_size = strlen(target) + 1;
+    SIZE_T entrypoint_size = strlen(entrypoint) + 1, i;
+    UINT flags[2] = {sflags, eflags};
+    DWORD hash = 0x811c9dc5;
+    char *data;
+
+    key->size = sizeof(flags) + source_size + target_size + entrypoint_size;
+    if (!(data = HeapAlloc(GetProcessHeap(), 0, key->size)))
+        return NULL;
+    memcpy(data, flags, sizeof(flags));
+    memcpy(data + sizeof(flags), preproc_shader, source_size);
+    memcpy(data + sizeof(flags) + source_size, target, target_size);
+    memcpy(data + sizeof(flags) + source_size + target_size, entrypoint, entrypoint_size);
+
+    for (i = 0; i < key->size; ++i)
+        hash = (hash ^ (BYTE)data[i]) * 0x01000193;
+    key->hash = hash;
+    key->data = data;
+    return data;
+}
+
+static HRESULT compile_cache_create_blob(const char *data, SIZE_T size, ID3DBlob **blob)
+{
+    HRESULT hr;
+
+    if (!size || !blob)
+        return S_OK;
+    if (FAILED(hr = D3DCreateBlob(size, blob)))
+        return hr;
+    memcpy(ID3D10Blob_GetBufferPointer(*blob), data, size);
+    return S_OK;
+}
+
+/* Append the compiler messages to the preprocessor messages that may already be
+ * in *error_messages, like compile_shader() does. */
+static HRESULT compile_cache_append_messages(const char *messages, SIZE_T size, ID3DBlob **error_messages)
+{
+    const char *preproc_messages;
+    SIZE_T preproc_size;
+    ID3DBlob *buffer;
+    HRESULT hr;
+
+    if (!size || !error_messages)
+        return S_OK;
+    if (!*error_messages)
+        return compile_cache_create_blob(messages, size, error_messages);
+
+    preproc_messages = ID3D10Blob_GetBufferPointer(*error_messages);
+    preproc_size = strlen(preproc_messages);
+    if (FAILED(hr = D3DCreateBlob(preproc_size + size, &buffer)))
+        return hr;
+    memcpy(ID3D10Blob_GetBufferPointer(buffer), preproc_messages, preproc_size);
+    memcpy((char *)ID3D10Blob_GetBufferPointer(buffer) + preproc_size, messages, size);
+
+    ID3D10Blob_Release(*error_messages);
+    *error_messages = buffer;
+    return S_OK;
+}
+
+static BOOL compile_cache_get(const struct compile_cache_key *key, ID3DBlob **shader_blob,
+        ID3DBlob **error_messages, HRESULT *hr)
+{
+    struct compile_cache_entry *entry;
+    struct wine_rb_entry *rb_entry;
+
+    if (!(rb_entry = wine_rb_get(&compile_cache, key)))
+    {
+        ++compile_cache_misses;
+        return FALSE;
+    }
+    entry = WINE_RB_ENTRY_VALUE(rb_entry, struct compile_cache_entry, entry);
+
+    if (FAILED(*hr = compile_cache_create_blob(entry->data + key->size,
+            entry->bytecode_size, shader_blob)))
+        return TRUE;
+    if (FAILED(*hr = compile_cache_append_messages(entry->data + key->size + entry->bytecode_size,
+            entry->messages_size, error_messages)))
+    {
+        if (shader_blob && *shader_blob)
+        {
+            ID3D10Blob_Release(*shader_blob);
+            *shader_blob = NULL;
+        }
+        return TRUE;
+    }
+
+    list_remove(&entry->lru_entry);
+    list_add_head(&compile_cache_lru, &entry->lru_entry);
+    ++compile_cache_hits;
+    TRACE("Cache hit, %u hits, %u misses.\n", compile_cache_hits, compile_cache_misses);
+    *hr = entry->hr;
+    return TRUE;
+}
+
+static void compile_cache_put(const struct compile_cache_key *key, HRESULT hr,
+        ID3DBlob *shader_blob, ID3DBlob *error_messages)
+{
+    SIZE_T bytecode_size = shader_blob ? ID3D10Blob_GetBufferSize(shader_blob) : 0;
+    SIZE_T messages_size = error_messages ? ID3D10Blob_GetBufferSize(error_messages) : 0;
+    SIZE_T size = FIELD_OFFSET(struct compile_cache_entry, data[key->size + bytecode_size + messages_size]);
+    struct compile_cache_entry *entry;
+
+    if (size > COMPILE_CACHE_MAX_SIZE / 4 || wine_rb_get(&compile_cache, key))
+        return;
+
+    while (compile_cache_size + size > COMPILE_CACHE_MAX_SIZE)
+    {
+        entry = LIST_ENTRY(list_tail(&compile_cache_lru), struct compile_cache_entry, lru_entry);
+        compile_cache_size -= FIELD_OFFSET(struct compile_cache_entry,
+                data[entry->key.size + entry->bytecode_size + entry->messages_size]);
+        list_remove(&entry->lru_entry);
+        wine_rb_remove(&compile_cache, &entry->entry);
+        HeapFree(GetProcessHeap(), 0, entry);
+    }
+
+    if (!(entry = HeapAlloc(GetProcessHeap(), 0, size)))
+        return;
+    memcpy(entry->data, key->data, key->size);
+    if (bytecode_size)
+        memcpy(entry->data + key->size, ID3D10Blob_GetBufferPointer(shader_blob), bytecode_size);
+    if (messages_size)
+        memcpy(entry->data + key->size + bytecode_size,
+                ID3D10Blob_GetBufferPointer(error_messages), messages_size);
+    entry->key.hash = key->hash;
+    entry->key.size = key->size;
+    entry->key.data = entry->data;
+    entry->hr = hr;
+    entry->bytecode_size = bytecode_size;
+    entry->messages_size = messages_size;
+
+    if (wine_rb_put(&compile_cache, &entry->key, &entry->entry) == -1)
+    {
+        HeapFree(GetProcessHeap(), 0, entry);
+        return;
+    }
+    list_add_head(&compile_cache_lru, &entry->lru_entry);
+    compile_cache_size += size;
+}
+
+static HRESULT compile_shader_cached(const char *preproc_shader, const char *target, const char *entrypoint,
+        UINT sflags, UINT eflags, ID3DBlob **shader_blob, ID3DBlob **error_messages)
+{
+    ID3DBlob *bytecode = NULL, *messages = NULL;
+    struct compile_cache_key key;
+    char *key_data = NULL;
+    HRESULT hr, append_hr;
+    BOOL found;
+
+    if (target && entrypoint
+            && (key_data = compile_cache_build_key(preproc_shader, target, entrypoint, sflags, eflags, &key)))
+    {
+        EnterCriticalSection(&compile_cache_mutex);
+        found = compile_cache_get(&key, shader_blob, error_messages, &hr);
+        LeaveCriticalSection(&compile_cache_mutex);
+        if (found)
+        {
+            HeapFree(GetProcessHeap(), 0, key_data);
+            return hr;
+        }
+    }
+
+    /* Concurrent misses on the same key each compile it, the first result to
+     * be put in the cache is kept. */
+    hr = compile_shader(preproc_shader, target, entrypoint, &bytecode, &messages);
+    if (key_data && hr != E_OUTOFMEMORY)
+    {
+        EnterCriticalSection(&compile_cache_mutex);
+        compile_cache_put(&key, hr, bytecode, messages);
+        LeaveCriticalSection(&compile_cache_mutex);
+    }
+    HeapFree(GetProcessHeap(), 0, key_data);
+
+    if (shader_blob)
+        *shader_blob = bytecode;
+    else if (bytecode)
+        ID3D10Blob_Release(bytecode);
+    if (messages)
+    {
+        append_hr = compile_cache_append_messages(ID3D10Blob_GetBufferPointer(messages),
+                ID3D10Blob_GetBufferSize(messages), error_messages);
+        ID3D10Blob_Release(messages);
+        if (FAILED(append_hr))
+        {
+            if (shader_blob && *shader_blob)
+            {
+                ID3D10Blob_Release(*shader_blob);
+                *shader_blob = NULL;
+            }
+            return append_hr;
+        }
+    }
+
+    return hr;
+}
+
 HRESULT WINAPI D3DCompile2(const void *data, SIZE_T data_size, const char *filename,
         const D3D_SHADER_MACRO *defines, ID3DInclude *include, const char *entrypoint,
         const char *target, UINT sflags, UINT eflags, UINT secondary_flags,
         const void *secondary_data, SIZE_T secondary_data_size, ID3DBlob **shader,
         ID3DBlob **error_messages)
 {
+    struct preprocess_state state;
     HRESULT hr;
 
     TRACE("data %p, data_size %lu, filename %s, defines %p, include %p, entrypoint %s, "
@@ -713,14 +988,11 @@ HRESULT WINAPI D3DCompile2(const void *data, SIZE_T data_size, const char *filen
     if (shader) *shader = NULL;
     if (error_messages) *error_messages = NULL;
 
-    EnterCriticalSection(&wpp_mutex);
-
-    hr = preprocess_shader(data, data_size, filename, defines, include, error_messages);
+    hr = preprocess_shader(&state, data, data_size, filename, defines, include, error_messages);
     if (SUCCEEDED(hr))
-        hr = compile_shader(wpp_output, target, entrypoint, shader, error_messages);
+        hr = compile_shader_cached(state.output, target, entrypoint, sflags, eflags, shader, error_messages);
 
-    HeapFree(GetProcessHeap(), 0, wpp_output);
-    LeaveCriticalSection(&wpp_mutex);
+    HeapFree(GetProcessHeap(), 0, state.output);
     return hr;
 }
 
@@ -741,6 +1013,7 @@ HRESULT WINAPI D3DPreprocess(const void *data, SIZE_T size, const char *filename
         const D3D_SHADER_MACRO *defines, ID3DInclude *include,
         ID3DBlob **shader, ID3DBlob **error_messages)
 {
+    struct preprocess_state state;
     HRESULT hr;
     ID3DBlob *buffer;
 
@@ -750,21 +1023,19 @@ HRESULT WINAPI D3DPreprocess(const void *data, SIZE_T size, const char *filename
     if (!data)
         return E_INVALIDARG;
 
-    EnterCriticalSection(&wpp_mutex);
-
     if (shader) *shader = NULL;
     if (error_messages) *error_messages = NULL;
 
-    hr = preprocess_shader(data, size, filename, defines, include, error_messages);
+    hr = preprocess_shader(&state, data, size, filename, defines, include, error_messages);
 
     if (SUCCEEDED(hr))
     {
         if (shader)
         {
-            hr = D3DCreateBlob(wpp_output_size, &buffer);
+            hr = D3DCreateBlob(state.output_size, &buffer);
             if (FAILED(hr))
                 goto cleanup;
-            CopyMemory(ID3D10Blob_GetBufferPointer(buffer), wpp_output, wpp_output_size);
+            CopyMemory(ID3D10Blob_GetBufferPointer(buffer), state.output, state.output_size);
             *shader = buffer;
         }
         else
@@ -772,8 +1043,7 @@ HRESULT WINAPI D3DPreprocess(const void *data, SIZE_T size, const char *filename
     }
 
 cleanup:
-    HeapFree(GetProcessHeap(), 0, wpp_output);
-    LeaveCriticalSection(&wpp_mutex);
+    HeapFree(GetProcessHeap(), 0, state.output);
     return hr;
 }
 
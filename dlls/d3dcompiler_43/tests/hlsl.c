@@ -21,6 +21,7 @@
 #include "d3dcompiler.h"
 
 #include <math.h>
+#include <stdio.h>
 
 struct vertex
 {
@@ -649,6 +650,150 @@ static void test_fail(IDirect3DDevice9 *device, IDirect3DVertexBuffer9 *qquad_ge
     ID3D10Blob_Release(errors);
 }
 
+static void test_repeated_compile(void)
+{
+    static const char *undefined_variable_shader =
+        "float4 test(float2 pos: TEXCOORD0) : COLOR\n"
+        "{\n"
+        "   return y;\n"
+        "}";
+    static const D3D_SHADER_MACRO defines[] =
+    {
+        {"y", "undefined_variable"},
+        {NULL, NULL}
+    };
+
+    ID3D10Blob *compiled = NULL, *errors = NULL, *errors2 = NULL;
+    HRESULT hr, hr2;
+
+    /* The first compilation doesn't ask for messages, the second one still
+     * gets them. */
+    hr = D3DCompile(undefined_variable_shader, strlen(undefined_variable_shader), NULL, NULL, NULL,
+            "test", "ps_2_0", 0, 0, &compiled, NULL);
+    ok(hr != D3D_OK, "Pixel shader compilation succeeded on shader with undefined variable\n");
+    ok(compiled == NULL, "A shader blob was returned for a shader with undefined variables\n");
+
+    hr = D3DCompile(undefined_variable_shader, strlen(undefined_variable_shader), NULL, NULL, NULL,
+            "test", "ps_2_0", 0, 0, &compiled, &errors);
+    ok(hr != D3D_OK, "Pixel shader compilation succeeded on shader with undefined variable\n");
+    ok(errors != NULL, "No errors returned for a shader with undefined variables\n");
+    ok(compiled == NULL, "A shader blob was returned for a shader with undefined variables\n");
+
+    hr2 = D3DCompile(undefined_variable_shader, strlen(undefined_variable_shader), NULL, NULL, NULL,
+            "test", "ps_2_0", 0, 0, &compiled, &errors2);
+    ok(hr2 == hr, "Got unexpected hr %#x, expected %#x.\n", hr2, hr);
+    ok(errors2 != NULL, "No errors returned for a shader with undefined variables\n");
+    ok(errors2 != errors, "Got the same error blob twice\n");
+    if (errors && errors2)
+    {
+        ok(ID3D10Blob_GetBufferSize(errors2) == ID3D10Blob_GetBufferSize(errors),
+                "Got unexpected error messages size %lu, expected %lu.\n",
+                ID3D10Blob_GetBufferSize(errors2), ID3D10Blob_GetBufferSize(errors));
+        ok(!strcmp(ID3D10Blob_GetBufferPointer(errors2), ID3D10Blob_GetBufferPointer(errors)),
+                "Got unexpected error messages %s.\n", (char *)ID3D10Blob_GetBufferPointer(errors2));
+    }
+    if (errors2)
+        ID3D10Blob_Release(errors2);
+    errors2 = NULL;
+
+    /* Defines change the preprocessed source, so the cached messages must not
+     * be returned. */
+    hr2 = D3DCompile(undefined_variable_shader, strlen(undefined_variable_shader), NULL, defines, NULL,
+            "test", "ps_2_0", 0, 0, &compiled, &errors2);
+    ok(hr2 != D3D_OK, "Pixel shader compilation succeeded on shader with undefined variable\n");
+    ok(compiled == NULL, "A shader blob was returned for a shader with undefined variables\n");
+    ok(errors2 != NULL, "No errors returned for a shader with undefined variables\n");
+    if (errors && errors2)
+        ok(strcmp(ID3D10Blob_GetBufferPointer(errors2), ID3D10Blob_GetBufferPointer(errors)),
+                "Got the same error messages %s.\n", (char *)ID3D10Blob_GetBufferPointer(errors2));
+
+    if (compiled)
+        ID3D10Blob_Release(compiled);
+    if (errors2)
+        ID3D10Blob_Release(errors2);
+    if (errors)
+        ID3D10Blob_Release(errors);
+}
+
+struct compile_benchmark
+{
+    unsigned int permutations;
+    unsigned int iterations;
+    LONG failures;
+};
+
+static DWORD WINAPI compile_benchmark_thread(void *arg)
+{
+    static const char shader_source[] =
+        "float4 test(float2 pos: TEXCOORD0) : COLOR\n"
+        "{\n"
+        "    return float4(pos.x * SCALE, pos.y, SCALE, 1.0);\n"
+        "}";
+    struct compile_benchmark *benchmark = arg;
+    D3D_SHADER_MACRO defines[] = {{"SCALE", NULL}, {NULL, NULL}};
+    ID3D10Blob *compiled;
+    unsigned int i, j;
+    char scale[16];
+    HRESULT hr;
+
+    for (i = 0; i < benchmark->iterations; ++i)
+    {
+        for (j = 0; j < benchmark->permutations; ++j)
+        {
+            sprintf(scale, "%u.0", j);
+            defines[0].Definition = scale;
+            hr = D3DCompile(shader_source, strlen(shader_source), NULL, defines, NULL,
+                    "test", "ps_2_0", 0, 0, &compiled, NULL);
+            if (FAILED(hr))
+                InterlockedIncrement(&benchmark->failures);
+            else
+                ID3D10Blob_Release(compiled);
+        }
+    }
+    return 0;
+}
+
+/* Run with "d3dcompiler_43_test.exe hlsl bench [threads] [permutations] [iterations]".
+ * The first pass compiles every permutation, the following ones hit the cache. */
+static void benchmark_compile(unsigned int thread_count, unsigned int permutations, unsigned int iterations)
+{
+    struct compile_benchmark benchmark;
+    LARGE_INTEGER start, end, freq;
+    HANDLE *threads;
+    unsigned int i;
+    double time;
+
+    threads = HeapAlloc(GetProcessHeap(), 0, thread_count * sizeof(*threads));
+    benchmark.permutations = permutations;
+    benchmark.failures = 0;
+    QueryPerformanceFrequency(&freq);
+
+    benchmark.iterations = 1;
+    QueryPerformanceCounter(&start);
+    compile_benchmark_thread(&benchmark);
+    QueryPerformanceCounter(&end);
+    time = (end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+    trace("First compilation of %u permutations: %.3f ms, %.1f compiles/s.\n",
+            permutations, time * 1000.0, permutations / time);
+
+    benchmark.iterations = iterations;
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < thread_count; ++i)
+        threads[i] = CreateThread(NULL, 0, compile_benchmark_thread, &benchmark, 0, NULL);
+    for (i = 0; i < thread_count; ++i)
+    {
+        WaitForSingleObject(threads[i], INFINITE);
+        CloseHandle(threads[i]);
+    }
+    QueryPerformanceCounter(&end);
+    time = (end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+    trace("%u threads, %u cached compiles each: %.3f ms, %.1f compiles/s.\n", thread_count,
+            permutations * iterations, time * 1000.0, thread_count * permutations * iterations / time);
+
+    ok(!benchmark.failures, "%u compilations failed.\n", benchmark.failures);
+    HeapFree(GetProcessHeap(), 0, threads);
+}
+
 START_TEST(hlsl)
 {
     D3DCAPS9 caps;
@@ -657,6 +802,18 @@ START_TEST(hlsl)
     IDirect3DVertexDeclaration9 *vdeclaration;
     IDirect3DVertexBuffer9 *quad_geometry;
     IDirect3DVertexShader9 *vshader_passthru;
+    char **argv;
+    int argc;
+
+    argc = winetest_get_mainargs(&argv);
+    if (argc >= 3 && !strcmp(argv[2], "bench"))
+    {
+        benchmark_compile(argc >= 4 ? atoi(argv[3]) : 4, argc >= 5 ? atoi(argv[4]) : 64,
+                argc >= 6 ? atoi(argv[5]) : 10);
+        return;
+    }
+
+    test_repeated_compile();
 
     device = init_d3d9(&vdeclaration, &quad_geometry, &vshader_passthru);
     if (!device) return;
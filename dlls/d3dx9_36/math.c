@@ -1309,31 +1309,122 @@ D3DXPLANE * WINAPI D3DXPlaneNormalize(D3DXPLANE *out, const D3DXPLANE *p)
     return out;
 }
 
-D3DXPLANE* WINAPI D3DXPlaneTransform(D3DXPLANE *pout, const D3DXPLANE *pplane, const D3DXMATRIX *pm)
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+
+/* The transform array functions multiply every element by the same matrix.
+ * The SSE2 kernel keeps the matrix rows in registers and transforms a whole
+ * element with four multiplies and three adds, summing in the same order as
+ * the scalar code. */
+typedef float sse2_vec4 __attribute__((vector_size(16)));
+
+static BOOL sse2_supported(void)
 {
-    const D3DXPLANE plane = *pplane;
+#ifdef __x86_64__
+    return TRUE;
+#else
+    static LONG supported = -1;
 
-    TRACE("pout %p, pplane %p, pm %p\n", pout, pplane, pm);
+    if (supported == -1)
+        InterlockedExchange(&supported, IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE));
+    return supported;
+#endif
+}
+
+static void __attribute__((target("sse2"))) transform_array_sse2(void *out, UINT outstride,
+        const void *in, UINT instride, const D3DXMATRIX *matrix, UINT components, UINT elements)
+{
+    sse2_vec4 row0, row1, row2, row3, r;
+    const float *v;
+    UINT i;
+
+    memcpy(&row0, matrix->u.m[0], sizeof(row0));
+    memcpy(&row1, matrix->u.m[1], sizeof(row1));
+    memcpy(&row2, matrix->u.m[2], sizeof(row2));
+    memcpy(&row3, matrix->u.m[3], sizeof(row3));
+
+    switch (components)
+    {
+        case 2:
+            for (i = 0; i < elements; ++i)
+            {
+                v = (const float *)((const char *)in + instride * i);
+                r = row0 * (sse2_vec4){v[0], v[0], v[0], v[0]} + row1 * (sse2_vec4){v[1], v[1], v[1], v[1]}
+                        + row3;
+                memcpy((char *)out + outstride * i, &r, sizeof(r));
+            }
+            break;
+
+        case 3:
+            for (i = 0; i < elements; ++i)
+            {
+                v = (const float *)((const char *)in + instride * i);
+                r = row0 * (sse2_vec4){v[0], v[0], v[0], v[0]} + row1 * (sse2_vec4){v[1], v[1], v[1], v[1]}
+                        + row2 * (sse2_vec4){v[2], v[2], v[2], v[2]} + row3;
+                memcpy((char *)out + outstride * i, &r, sizeof(r));
+            }
+            break;
+
+        case 4:
+            for (i = 0; i < elements; ++i)
+            {
+                v = (const float *)((const char *)in + instride * i);
+                r = row0 * (sse2_vec4){v[0], v[0], v[0], v[0]} + row1 * (sse2_vec4){v[1], v[1], v[1], v[1]}
+                        + row2 * (sse2_vec4){v[2], v[2], v[2], v[2]} + row3 * (sse2_vec4){v[3], v[3], v[3], v[3]};
+                memcpy((char *)out + outstride * i, &r, sizeof(r));
+            }
+            break;
+    }
+}
+
+#endif
+
+/* Transforms elements vectors of components floats into four component
+ * vectors, a missing w is 1. Returns FALSE if the caller has to use the
+ * scalar code. */
+static BOOL transform_array(void *out, UINT outstride, const void *in, UINT instride,
+        const D3DXMATRIX *matrix, UINT components, UINT elements)
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    if (sse2_supported())
+    {
+        transform_array_sse2(out, outstride, in, instride, matrix, components, elements);
+        return TRUE;
+    }
+#endif
+    return FALSE;
+}
+
+static inline void plane_transform(D3DXPLANE *pout, const D3DXPLANE *pplane, const D3DXMATRIX *pm)
+{
+    const D3DXPLANE plane = *pplane;
 
     pout->a = pm->u.m[0][0] * plane.a + pm->u.m[1][0] * plane.b + pm->u.m[2][0] * plane.c + pm->u.m[3][0] * plane.d;
     pout->b = pm->u.m[0][1] * plane.a + pm->u.m[1][1] * plane.b + pm->u.m[2][1] * plane.c + pm->u.m[3][1] * plane.d;
     pout->c = pm->u.m[0][2] * plane.a + pm->u.m[1][2] * plane.b + pm->u.m[2][2] * plane.c + pm->u.m[3][2] * plane.d;
     pout->d = pm->u.m[0][3] * plane.a + pm->u.m[1][3] * plane.b + pm->u.m[2][3] * plane.c + pm->u.m[3][3] * plane.d;
+}
+
+D3DXPLANE* WINAPI D3DXPlaneTransform(D3DXPLANE *pout, const D3DXPLANE *pplane, const D3DXMATRIX *pm)
+{
+    TRACE("pout %p, pplane %p, pm %p\n", pout, pplane, pm);
+
+    plane_transform(pout, pplane, pm);
     return pout;
 }
 
 D3DXPLANE* WINAPI D3DXPlaneTransformArray(D3DXPLANE* out, UINT outstride, const D3DXPLANE* in, UINT instride, const D3DXMATRIX* matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXPlaneTransform(
-            (D3DXPLANE*)((char*)out + outstride * i),
-            (const D3DXPLANE*)((const char*)in + instride * i),
-            matrix);
-    }
+    if (transform_array(out, outstride, in, instride, matrix, 4, elements))
+        return out;
+
+    for (i = 0; i < elements; ++i)
+        plane_transform((D3DXPLANE *)((char *)out + outstride * i),
+                (const D3DXPLANE *)((const char *)in + instride * i), &m);
     return out;
 }
 
@@ -1711,89 +1802,100 @@ D3DXVECTOR2* WINAPI D3DXVec2Normalize(D3DXVECTOR2 *pout, const D3DXVECTOR2 *pv)
     return pout;
 }
 
-D3DXVECTOR4* WINAPI D3DXVec2Transform(D3DXVECTOR4 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
+static inline void vec2_transform(D3DXVECTOR4 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
 {
     D3DXVECTOR4 out;
 
-    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
-
     out.x = pm->u.m[0][0] * pv->x + pm->u.m[1][0] * pv->y  + pm->u.m[3][0];
     out.y = pm->u.m[0][1] * pv->x + pm->u.m[1][1] * pv->y  + pm->u.m[3][1];
     out.z = pm->u.m[0][2] * pv->x + pm->u.m[1][2] * pv->y  + pm->u.m[3][2];
     out.w = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y  + pm->u.m[3][3];
     *pout = out;
+}
+
+D3DXVECTOR4* WINAPI D3DXVec2Transform(D3DXVECTOR4 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
+{
+    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
+
+    vec2_transform(pout, pv, pm);
     return pout;
 }
 
 D3DXVECTOR4* WINAPI D3DXVec2TransformArray(D3DXVECTOR4* out, UINT outstride, const D3DXVECTOR2* in, UINT instride, const D3DXMATRIX* matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec2Transform(
-            (D3DXVECTOR4*)((char*)out + outstride * i),
-            (const D3DXVECTOR2*)((const char*)in + instride * i),
-            matrix);
-    }
+    if (transform_array(out, outstride, in, instride, matrix, 2, elements))
+        return out;
+
+    for (i = 0; i < elements; ++i)
+        vec2_transform((D3DXVECTOR4 *)((char *)out + outstride * i),
+                (const D3DXVECTOR2 *)((const char *)in + instride * i), &m);
     return out;
 }
 
-D3DXVECTOR2* WINAPI D3DXVec2TransformCoord(D3DXVECTOR2 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
+static inline void vec2_transform_coord(D3DXVECTOR2 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
 {
     D3DXVECTOR2 v;
     FLOAT norm;
 
-    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
-
     v = *pv;
     norm = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y + pm->u.m[3][3];
 
     pout->x = (pm->u.m[0][0] * v.x + pm->u.m[1][0] * v.y + pm->u.m[3][0]) / norm;
     pout->y = (pm->u.m[0][1] * v.x + pm->u.m[1][1] * v.y + pm->u.m[3][1]) / norm;
+}
 
+D3DXVECTOR2* WINAPI D3DXVec2TransformCoord(D3DXVECTOR2 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
+{
+    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
+
+    vec2_transform_coord(pout, pv, pm);
     return pout;
 }
 
 D3DXVECTOR2* WINAPI D3DXVec2TransformCoordArray(D3DXVECTOR2* out, UINT outstride, const D3DXVECTOR2* in, UINT instride, const D3DXMATRIX* matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec2TransformCoord(
-            (D3DXVECTOR2*)((char*)out + outstride * i),
-            (const D3DXVECTOR2*)((const char*)in + instride * i),
-            matrix);
-    }
+    for (i = 0; i < elements; ++i)
+        vec2_transform_coord((D3DXVECTOR2 *)((char *)out + outstride * i),
+                (const D3DXVECTOR2 *)((const char *)in + instride * i), &m);
     return out;
 }
 
-D3DXVECTOR2* WINAPI D3DXVec2TransformNormal(D3DXVECTOR2 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
+static inline void vec2_transform_normal(D3DXVECTOR2 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
 {
     const D3DXVECTOR2 v = *pv;
 
-    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
-
     pout->x = pm->u.m[0][0] * v.x + pm->u.m[1][0] * v.y;
     pout->y = pm->u.m[0][1] * v.x + pm->u.m[1][1] * v.y;
+}
+
+D3DXVECTOR2* WINAPI D3DXVec2TransformNormal(D3DXVECTOR2 *pout, const D3DXVECTOR2 *pv, const D3DXMATRIX *pm)
+{
+    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
+
+    vec2_transform_normal(pout, pv, pm);
     return pout;
 }
 
 D3DXVECTOR2* WINAPI D3DXVec2TransformNormalArray(D3DXVECTOR2* out, UINT outstride, const D3DXVECTOR2 *in, UINT instride, const D3DXMATRIX *matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec2TransformNormal(
-            (D3DXVECTOR2*)((char*)out + outstride * i),
-            (const D3DXVECTOR2*)((const char*)in + instride * i),
-            matrix);
-    }
+    for (i = 0; i < elements; ++i)
+        vec2_transform_normal((D3DXVECTOR2 *)((char *)out + outstride * i),
+                (const D3DXVECTOR2 *)((const char *)in + instride * i), &m);
     return out;
 }
 
@@ -1859,18 +1961,31 @@ D3DXVECTOR3* WINAPI D3DXVec3Normalize(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv)
     return pout;
 }
 
-D3DXVECTOR3* WINAPI D3DXVec3Project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+static inline void vec3_transform_coord(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
 {
-    D3DXMATRIX m;
+    D3DXVECTOR3 out;
+    FLOAT norm;
 
-    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworld %p\n", pout, pv, pviewport, pprojection, pview, pworld);
+    norm = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y + pm->u.m[2][3] *pv->z + pm->u.m[3][3];
 
-    D3DXMatrixIdentity(&m);
-    if (pworld) D3DXMatrixMultiply(&m, &m, pworld);
-    if (pview) D3DXMatrixMultiply(&m, &m, pview);
-    if (pprojection) D3DXMatrixMultiply(&m, &m, pprojection);
+    out.x = (pm->u.m[0][0] * pv->x + pm->u.m[1][0] * pv->y + pm->u.m[2][0] * pv->z + pm->u.m[3][0]) / norm;
+    out.y = (pm->u.m[0][1] * pv->x + pm->u.m[1][1] * pv->y + pm->u.m[2][1] * pv->z + pm->u.m[3][1]) / norm;
+    out.z = (pm->u.m[0][2] * pv->x + pm->u.m[1][2] * pv->y + pm->u.m[2][2] * pv->z + pm->u.m[3][2]) / norm;
 
-    D3DXVec3TransformCoord(pout, pv, &m);
+    *pout = out;
+}
+
+static void get_world_view_projection(D3DXMATRIX *m, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+{
+    D3DXMatrixIdentity(m);
+    if (pworld) D3DXMatrixMultiply(m, m, pworld);
+    if (pview) D3DXMatrixMultiply(m, m, pview);
+    if (pprojection) D3DXMatrixMultiply(m, m, pprojection);
+}
+
+static inline void vec3_project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *m)
+{
+    vec3_transform_coord(pout, pv, m);
 
     if (pviewport)
     {
@@ -1878,127 +1993,122 @@ D3DXVECTOR3* WINAPI D3DXVec3Project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, co
         pout->y = pviewport->Y +  ( 1.0f - pout->y ) * pviewport->Height / 2.0f;
         pout->z = pviewport->MinZ + pout->z * ( pviewport->MaxZ - pviewport->MinZ );
     }
+}
+
+D3DXVECTOR3* WINAPI D3DXVec3Project(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+{
+    D3DXMATRIX m;
+
+    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworld %p\n", pout, pv, pviewport, pprojection, pview, pworld);
+
+    get_world_view_projection(&m, pprojection, pview, pworld);
+    vec3_project(pout, pv, pviewport, &m);
     return pout;
 }
 
 D3DXVECTOR3* WINAPI D3DXVec3ProjectArray(D3DXVECTOR3* out, UINT outstride, const D3DXVECTOR3* in, UINT instride, const D3DVIEWPORT9* viewport, const D3DXMATRIX* projection, const D3DXMATRIX* view, const D3DXMATRIX* world, UINT elements)
 {
+    D3DXMATRIX m;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, viewport %p, projection %p, view %p, world %p, elements %u\n",
         out, outstride, in, instride, viewport, projection, view, world, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec3Project(
-            (D3DXVECTOR3*)((char*)out + outstride * i),
-            (const D3DXVECTOR3*)((const char*)in + instride * i),
-            viewport, projection, view, world);
-    }
+    get_world_view_projection(&m, projection, view, world);
+    for (i = 0; i < elements; ++i)
+        vec3_project((D3DXVECTOR3 *)((char *)out + outstride * i),
+                (const D3DXVECTOR3 *)((const char *)in + instride * i), viewport, &m);
     return out;
 }
 
-D3DXVECTOR4* WINAPI D3DXVec3Transform(D3DXVECTOR4 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
+static inline void vec3_transform(D3DXVECTOR4 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
 {
     D3DXVECTOR4 out;
 
-    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
-
     out.x = pm->u.m[0][0] * pv->x + pm->u.m[1][0] * pv->y + pm->u.m[2][0] * pv->z + pm->u.m[3][0];
     out.y = pm->u.m[0][1] * pv->x + pm->u.m[1][1] * pv->y + pm->u.m[2][1] * pv->z + pm->u.m[3][1];
     out.z = pm->u.m[0][2] * pv->x + pm->u.m[1][2] * pv->y + pm->u.m[2][2] * pv->z + pm->u.m[3][2];
     out.w = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y + pm->u.m[2][3] * pv->z + pm->u.m[3][3];
     *pout = out;
+}
+
+D3DXVECTOR4* WINAPI D3DXVec3Transform(D3DXVECTOR4 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
+{
+    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
+
+    vec3_transform(pout, pv, pm);
     return pout;
 }
 
 D3DXVECTOR4* WINAPI D3DXVec3TransformArray(D3DXVECTOR4* out, UINT outstride, const D3DXVECTOR3* in, UINT instride, const D3DXMATRIX* matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec3Transform(
-            (D3DXVECTOR4*)((char*)out + outstride * i),
-            (const D3DXVECTOR3*)((const char*)in + instride * i),
-            matrix);
-    }
+    if (transform_array(out, outstride, in, instride, matrix, 3, elements))
+        return out;
+
+    for (i = 0; i < elements; ++i)
+        vec3_transform((D3DXVECTOR4 *)((char *)out + outstride * i),
+                (const D3DXVECTOR3 *)((const char *)in + instride * i), &m);
     return out;
 }
 
 D3DXVECTOR3* WINAPI D3DXVec3TransformCoord(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
 {
-    D3DXVECTOR3 out;
-    FLOAT norm;
-
     TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
 
-    norm = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y + pm->u.m[2][3] *pv->z + pm->u.m[3][3];
-
-    out.x = (pm->u.m[0][0] * pv->x + pm->u.m[1][0] * pv->y + pm->u.m[2][0] * pv->z + pm->u.m[3][0]) / norm;
-    out.y = (pm->u.m[0][1] * pv->x + pm->u.m[1][1] * pv->y + pm->u.m[2][1] * pv->z + pm->u.m[3][1]) / norm;
-    out.z = (pm->u.m[0][2] * pv->x + pm->u.m[1][2] * pv->y + pm->u.m[2][2] * pv->z + pm->u.m[3][2]) / norm;
-
-    *pout = out;
-
+    vec3_transform_coord(pout, pv, pm);
     return pout;
 }
 
 D3DXVECTOR3* WINAPI D3DXVec3TransformCoordArray(D3DXVECTOR3* out, UINT outstride, const D3DXVECTOR3* in, UINT instride, const D3DXMATRIX* matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec3TransformCoord(
-            (D3DXVECTOR3*)((char*)out + outstride * i),
-            (const D3DXVECTOR3*)((const char*)in + instride * i),
-            matrix);
-    }
+    for (i = 0; i < elements; ++i)
+        vec3_transform_coord((D3DXVECTOR3 *)((char *)out + outstride * i),
+                (const D3DXVECTOR3 *)((const char *)in + instride * i), &m);
     return out;
 }
 
-D3DXVECTOR3* WINAPI D3DXVec3TransformNormal(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
+static inline void vec3_transform_normal(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
 {
     const D3DXVECTOR3 v = *pv;
 
-    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
-
     pout->x = pm->u.m[0][0] * v.x + pm->u.m[1][0] * v.y + pm->u.m[2][0] * v.z;
     pout->y = pm->u.m[0][1] * v.x + pm->u.m[1][1] * v.y + pm->u.m[2][1] * v.z;
     pout->z = pm->u.m[0][2] * v.x + pm->u.m[1][2] * v.y + pm->u.m[2][2] * v.z;
-    return pout;
+}
+
+D3DXVECTOR3* WINAPI D3DXVec3TransformNormal(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DXMATRIX *pm)
+{
+    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
 
+    vec3_transform_normal(pout, pv, pm);
+    return pout;
 }
 
 D3DXVECTOR3* WINAPI D3DXVec3TransformNormalArray(D3DXVECTOR3* out, UINT outstride, const D3DXVECTOR3* in, UINT instride, const D3DXMATRIX* matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec3TransformNormal(
-            (D3DXVECTOR3*)((char*)out + outstride * i),
-            (const D3DXVECTOR3*)((const char*)in + instride * i),
-            matrix);
-    }
+    for (i = 0; i < elements; ++i)
+        vec3_transform_normal((D3DXVECTOR3 *)((char *)out + outstride * i),
+                (const D3DXVECTOR3 *)((const char *)in + instride * i), &m);
     return out;
 }
 
-D3DXVECTOR3* WINAPI D3DXVec3Unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+static inline void vec3_unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *m)
 {
-    D3DXMATRIX m;
-
-    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworlds %p\n", pout, pv, pviewport, pprojection, pview, pworld);
-
-    D3DXMatrixIdentity(&m);
-    if (pworld) D3DXMatrixMultiply(&m, &m, pworld);
-    if (pview) D3DXMatrixMultiply(&m, &m, pview);
-    if (pprojection) D3DXMatrixMultiply(&m, &m, pprojection);
-    D3DXMatrixInverse(&m, NULL, &m);
-
     *pout = *pv;
     if (pviewport)
     {
@@ -2006,23 +2116,34 @@ D3DXVECTOR3* WINAPI D3DXVec3Unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv,
         pout->y = 1.0f - 2.0f * ( pout->y - pviewport->Y ) / pviewport->Height;
         pout->z = ( pout->z - pviewport->MinZ) / ( pviewport->MaxZ - pviewport->MinZ );
     }
-    D3DXVec3TransformCoord(pout, pout, &m);
+    vec3_transform_coord(pout, pout, m);
+}
+
+D3DXVECTOR3* WINAPI D3DXVec3Unproject(D3DXVECTOR3 *pout, const D3DXVECTOR3 *pv, const D3DVIEWPORT9 *pviewport, const D3DXMATRIX *pprojection, const D3DXMATRIX *pview, const D3DXMATRIX *pworld)
+{
+    D3DXMATRIX m;
+
+    TRACE("pout %p, pv %p, pviewport %p, pprojection %p, pview %p, pworlds %p\n", pout, pv, pviewport, pprojection, pview, pworld);
+
+    get_world_view_projection(&m, pprojection, pview, pworld);
+    D3DXMatrixInverse(&m, NULL, &m);
+    vec3_unproject(pout, pv, pviewport, &m);
     return pout;
 }
 
 D3DXVECTOR3* WINAPI D3DXVec3UnprojectArray(D3DXVECTOR3* out, UINT outstride, const D3DXVECTOR3* in, UINT instride, const D3DVIEWPORT9* viewport, const D3DXMATRIX* projection, const D3DXMATRIX* view, const D3DXMATRIX* world, UINT elements)
 {
+    D3DXMATRIX m;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, viewport %p, projection %p, view %p, world %p, elements %u\n",
         out, outstride, in, instride, viewport, projection, view, world, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec3Unproject(
-            (D3DXVECTOR3*)((char*)out + outstride * i),
-            (const D3DXVECTOR3*)((const char*)in + instride * i),
-            viewport, projection, view, world);
-    }
+    get_world_view_projection(&m, projection, view, world);
+    D3DXMatrixInverse(&m, NULL, &m);
+    for (i = 0; i < elements; ++i)
+        vec3_unproject((D3DXVECTOR3 *)((char *)out + outstride * i),
+                (const D3DXVECTOR3 *)((const char *)in + instride * i), viewport, &m);
     return out;
 }
 
@@ -2098,32 +2219,38 @@ D3DXVECTOR4* WINAPI D3DXVec4Normalize(D3DXVECTOR4 *pout, const D3DXVECTOR4 *pv)
     return pout;
 }
 
-D3DXVECTOR4* WINAPI D3DXVec4Transform(D3DXVECTOR4 *pout, const D3DXVECTOR4 *pv, const D3DXMATRIX *pm)
+static inline void vec4_transform(D3DXVECTOR4 *pout, const D3DXVECTOR4 *pv, const D3DXMATRIX *pm)
 {
     D3DXVECTOR4 out;
 
-    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
-
     out.x = pm->u.m[0][0] * pv->x + pm->u.m[1][0] * pv->y + pm->u.m[2][0] * pv->z + pm->u.m[3][0] * pv->w;
     out.y = pm->u.m[0][1] * pv->x + pm->u.m[1][1] * pv->y + pm->u.m[2][1] * pv->z + pm->u.m[3][1] * pv->w;
     out.z = pm->u.m[0][2] * pv->x + pm->u.m[1][2] * pv->y + pm->u.m[2][2] * pv->z + pm->u.m[3][2] * pv->w;
     out.w = pm->u.m[0][3] * pv->x + pm->u.m[1][3] * pv->y + pm->u.m[2][3] * pv->z + pm->u.m[3][3] * pv->w;
     *pout = out;
+}
+
+D3DXVECTOR4* WINAPI D3DXVec4Transform(D3DXVECTOR4 *pout, const D3DXVECTOR4 *pv, const D3DXMATRIX *pm)
+{
+    TRACE("pout %p, pv %p, pm %p\n", pout, pv, pm);
+
+    vec4_transform(pout, pv, pm);
     return pout;
 }
 
 D3DXVECTOR4* WINAPI D3DXVec4TransformArray(D3DXVECTOR4* out, UINT outstride, const D3DXVECTOR4* in, UINT instride, const D3DXMATRIX* matrix, UINT elements)
 {
+    const D3DXMATRIX m = *matrix;
     UINT i;
 
     TRACE("out %p, outstride %u, in %p, instride %u, matrix %p, elements %u\n", out, outstride, in, instride, matrix, elements);
 
-    for (i = 0; i < elements; ++i) {
-        D3DXVec4Transform(
-            (D3DXVECTOR4*)((char*)out + outstride * i),
-            (const D3DXVECTOR4*)((const char*)in + instride * i),
-            matrix);
-    }
+    if (transform_array(out, outstride, in, instride, matrix, 4, elements))
+        return out;
+
+    for (i = 0; i < elements; ++i)
+        vec4_transform((D3DXVECTOR4 *)((char *)out + outstride * i),
+                (const D3DXVECTOR4 *)((const char *)in + instride * i), &m);
     return out;
 }
 
@@ -28,6 +28,7 @@
 #include "wincodec.h"
 
 #include "wine/wined3d.h"
+#include "wine/bands.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3dx);
 
@@ -1622,6 +1623,274 @@ void copy_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pitch,
     }
 }
 
+static void convert_row_a8r8g8b8_x8r8g8b8(const BYTE *src, BYTE *dst, UINT width)
+{
+    const DWORD *s = (const DWORD *)src;
+    DWORD *d = (DWORD *)dst;
+    UINT x;
+
+    for (x = 0; x < width; ++x)
+        d[x] = s[x] & 0x00ffffff;
+}
+
+static void convert_row_x8r8g8b8_a8r8g8b8(const BYTE *src, BYTE *dst, UINT width)
+{
+    const DWORD *s = (const DWORD *)src;
+    DWORD *d = (DWORD *)dst;
+    UINT x;
+
+    for (x = 0; x < width; ++x)
+        d[x] = s[x] | 0xff000000;
+}
+
+static void convert_row_a8r8g8b8_a8b8g8r8(const BYTE *src, BYTE *dst, UINT width)
+{
+    const DWORD *s = (const DWORD *)src;
+    DWORD *d = (DWORD *)dst;
+    UINT x;
+
+    for (x = 0; x < width; ++x)
+        d[x] = (s[x] & 0xff00ff00) | (s[x] & 0x00ff0000) >> 16 | (s[x] & 0x000000ff) << 16;
+}
+
+static void convert_row_x8r8g8b8_a8b8g8r8(const BYTE *src, BYTE *dst, UINT width)
+{
+    const DWORD *s = (const DWORD *)src;
+    DWORD *d = (DWORD *)dst;
+    UINT x;
+
+    for (x = 0; x < width; ++x)
+        d[x] = 0xff000000 | (s[x] & 0x0000ff00) | (s[x] & 0x00ff0000) >> 16 | (s[x] & 0x000000ff) << 16;
+}
+
+static void convert_row_r8g8b8_a8r8g8b8(const BYTE *src, BYTE *dst, UINT width)
+{
+    DWORD *d = (DWORD *)dst;
+    UINT x;
+
+    for (x = 0; x < width; ++x, src += 3)
+        d[x] = 0xff000000 | src[2] << 16 | src[1] << 8 | src[0];
+}
+
+static void convert_row_r5g6b5_a8r8g8b8(const BYTE *src, BYTE *dst, UINT width)
+{
+    const WORD *s = (const WORD *)src;
+    DWORD *d = (DWORD *)dst;
+    UINT x;
+
+    for (x = 0; x < width; ++x)
+    {
+        /* Replicate the top bits into the new low bits, like make_argb_color(). */
+        DWORD r = (s[x] & 0xf800) >> 11, g = (s[x] & 0x07e0) >> 5, b = s[x] & 0x001f;
+
+        d[x] = 0xff000000 | (r << 3 | r >> 2) << 16 | (g << 2 | g >> 4) << 8 | (b << 3 | b >> 2);
+    }
+}
+
+/* Specialized kernels for common conversions without color keying. They give
+ * the same results as the generic per-channel code. */
+static const struct
+{
+    D3DFORMAT src_format;
+    D3DFORMAT dst_format;
+    void (*convert_row)(const BYTE *src, BYTE *dst, UINT width);
+}
+argb_row_converters[] =
+{
+    {D3DFMT_A8R8G8B8, D3DFMT_X8R8G8B8, convert_row_a8r8g8b8_x8r8g8b8},
+    {D3DFMT_X8R8G8B8, D3DFMT_A8R8G8B8, convert_row_x8r8g8b8_a8r8g8b8},
+    {D3DFMT_A8R8G8B8, D3DFMT_A8B8G8R8, convert_row_a8r8g8b8_a8b8g8r8},
+    {D3DFMT_A8B8G8R8, D3DFMT_A8R8G8B8, convert_row_a8r8g8b8_a8b8g8r8},
+    {D3DFMT_X8R8G8B8, D3DFMT_A8B8G8R8, convert_row_x8r8g8b8_a8b8g8r8},
+    {D3DFMT_X8B8G8R8, D3DFMT_A8R8G8B8, convert_row_x8r8g8b8_a8b8g8r8},
+    {D3DFMT_R8G8B8,   D3DFMT_A8R8G8B8, convert_row_r8g8b8_a8r8g8b8},
+    {D3DFMT_R5G6B5,   D3DFMT_A8R8G8B8, convert_row_r5g6b5_a8r8g8b8},
+};
+
+/* Large conversions are split into bands of destination rows that are
+ * processed on the thread pool. Rows are independent, so the result doesn't
+ * depend on the split. */
+struct argb_job
+{
+    const BYTE *src;
+    UINT src_row_pitch, src_slice_pitch;
+    const struct volume *src_size;
+    const struct pixel_format_desc *src_format;
+    BYTE *dst;
+    UINT dst_row_pitch, dst_slice_pitch;
+    const struct volume *dst_size;
+    const struct pixel_format_desc *dst_format;
+    D3DCOLOR color_key;
+    const PALETTEENTRY *palette;
+
+    struct argb_conversion_info conv_info, ck_conv_info;
+    const struct pixel_format_desc *ck_format;
+    BOOL argb_path;
+    void (*convert_row)(const BYTE *src, BYTE *dst, UINT width);
+    /* Set when a box or linear filter halves a 32 bpp image in both
+     * directions without conversion, the bits of the result to keep. */
+    DWORD halve_mask;
+    void (*process_row)(const struct argb_job *job, UINT z, UINT y);
+
+    /* Rows are numbered z * height + y. */
+    UINT height, row_count, band_size;
+};
+
+static void argb_job_init(struct argb_job *job, const BYTE *src, UINT src_row_pitch, UINT src_slice_pitch,
+        const struct volume *src_size, const struct pixel_format_desc *src_format, BYTE *dst,
+        UINT dst_row_pitch, UINT dst_slice_pitch, const struct volume *dst_size,
+        const struct pixel_format_desc *dst_format, D3DCOLOR color_key, const PALETTEENTRY *palette)
+{
+    memset(job, 0, sizeof(*job));
+    job->src = src;
+    job->src_row_pitch = src_row_pitch;
+    job->src_slice_pitch = src_slice_pitch;
+    job->src_size = src_size;
+    job->src_format = src_format;
+    job->dst = dst;
+    job->dst_row_pitch = dst_row_pitch;
+    job->dst_slice_pitch = dst_slice_pitch;
+    job->dst_size = dst_size;
+    job->dst_format = dst_format;
+    job->color_key = color_key;
+    job->palette = palette;
+
+    init_argb_conversion_info(src_format, dst_format, &job->conv_info);
+    if (color_key)
+    {
+        /* Color keys are always represented in D3DFMT_A8R8G8B8 format. */
+        job->ck_format = get_format_info(D3DFMT_A8R8G8B8);
+        init_argb_conversion_info(src_format, job->ck_format, &job->ck_conv_info);
+    }
+
+    job->argb_path = !src_format->to_rgba && !dst_format->from_rgba
+            && src_format->type == dst_format->type
+            && src_format->bytes_per_pixel <= 4 && dst_format->bytes_per_pixel <= 4;
+}
+
+/* Reads a source pixel as RGBA, color keyed pixels become transparent. */
+static void argb_job_read_pixel(const struct argb_job *job, const BYTE *src_ptr, struct vec4 *rgba)
+{
+    struct vec4 color;
+
+    format_to_vec4(job->src_format, src_ptr, &color);
+    if (job->src_format->to_rgba)
+        job->src_format->to_rgba(&color, rgba, job->palette);
+    else
+        *rgba = color;
+
+    if (job->ck_format)
+    {
+        DWORD ck_pixel;
+
+        format_from_vec4(job->ck_format, rgba, (BYTE *)&ck_pixel);
+        if (ck_pixel == job->color_key)
+            rgba->w = 0.0f;
+    }
+}
+
+static void argb_job_write_pixel(const struct argb_job *job, const struct vec4 *rgba, BYTE *dst_ptr)
+{
+    struct vec4 color;
+
+    if (job->dst_format->from_rgba)
+        job->dst_format->from_rgba(rgba, &color);
+    else
+        color = *rgba;
+
+    format_from_vec4(job->dst_format, &color, dst_ptr);
+}
+
+static void argb_job_convert_pixel(const struct argb_job *job, const BYTE *src_ptr, BYTE *dst_ptr)
+{
+    if (job->argb_path)
+    {
+        DWORD channels[4] = {0};
+        DWORD val;
+
+        get_relevant_argb_components(&job->conv_info, src_ptr, channels);
+        val = make_argb_color(&job->conv_info, channels);
+
+        if (job->color_key)
+        {
+            DWORD ck_pixel;
+
+            get_relevant_argb_components(&job->ck_conv_info, src_ptr, channels);
+            ck_pixel = make_argb_color(&job->ck_conv_info, channels);
+            if (ck_pixel == job->color_key)
+                val &= ~job->conv_info.destmask[0];
+        }
+        memcpy(dst_ptr, &val, job->dst_format->bytes_per_pixel);
+    }
+    else
+    {
+        struct vec4 color;
+
+        argb_job_read_pixel(job, src_ptr, &color);
+        argb_job_write_pixel(job, &color, dst_ptr);
+    }
+}
+
+static void argb_job_run_band(void *param, unsigned int band)
+{
+    const struct argb_job *job = param;
+    UINT row = band * job->band_size, end = min(row + job->band_size, job->row_count);
+
+    for (; row < end; ++row)
+        job->process_row(job, row / job->height, row % job->height);
+}
+
+UINT get_thread_count(void)
+{
+    static LONG thread_count;
+    SYSTEM_INFO info;
+
+    if (!thread_count)
+    {
+        GetSystemInfo(&info);
+        InterlockedExchange(&thread_count, max(info.dwNumberOfProcessors, 1));
+    }
+    return thread_count;
+}
+
+/* Processes height rows in each of depth slices of the destination, on the
+ * calling thread and, for large images, on the thread pool. */
+static void argb_job_execute(struct argb_job *job, UINT width, UINT height, UINT depth)
+{
+    UINT threads = get_thread_count(), count;
+
+    job->height = height;
+    job->row_count = height * depth;
+    count = wine_split_bands(job->row_count, width, threads, &job->band_size);
+    wine_run_bands(argb_job_run_band, job, count, threads);
+}
+
+static void convert_argb_row(const struct argb_job *job, UINT z, UINT y)
+{
+    UINT width = min(job->src_size->width, job->dst_size->width);
+    const BYTE *src_ptr = job->src + z * job->src_slice_pitch + y * job->src_row_pitch;
+    BYTE *dst_ptr = job->dst + z * job->dst_slice_pitch + y * job->dst_row_pitch;
+    UINT x;
+
+    if (job->convert_row)
+    {
+        job->convert_row(src_ptr, dst_ptr, width);
+        dst_ptr += width * job->dst_format->bytes_per_pixel;
+    }
+    else
+    {
+        for (x = 0; x < width; x++)
+        {
+            argb_job_convert_pixel(job, src_ptr, dst_ptr);
+            src_ptr += job->src_format->bytes_per_pixel;
+            dst_ptr += job->dst_format->bytes_per_pixel;
+        }
+    }
+
+    if (job->src_size->width < job->dst_size->width) /* black out remaining pixels */
+        memset(dst_ptr, 0, job->dst_format->bytes_per_pixel * (job->dst_size->width - job->src_size->width));
+}
+
 /************************************************************
  * convert_argb_pixels
  *
@@ -1634,95 +1903,108 @@ void convert_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pit
         const struct volume *dst_size, const struct pixel_format_desc *dst_format, D3DCOLOR color_key,
         const PALETTEENTRY *palette)
 {
-    struct argb_conversion_info conv_info, ck_conv_info;
-    const struct pixel_format_desc *ck_format = NULL;
-    DWORD channels[4];
     UINT min_width, min_height, min_depth;
-    UINT x, y, z;
-
-    ZeroMemory(channels, sizeof(channels));
-    init_argb_conversion_info(src_format, dst_format, &conv_info);
+    struct argb_job job;
+    unsigned int i;
 
-    min_width = min(src_size->width, dst_size->width);
-    min_height = min(src_size->height, dst_size->height);
-    min_depth = min(src_size->depth, dst_size->depth);
+    argb_job_init(&job, src, src_row_pitch, src_slice_pitch, src_size, src_format,
+            dst, dst_row_pitch, dst_slice_pitch, dst_size, dst_format, color_key, palette);
+    job.process_row = convert_argb_row;
 
-    if (color_key)
+    if (!color_key)
     {
-        /* Color keys are always represented in D3DFMT_A8R8G8B8 format. */
-        ck_format = get_format_info(D3DFMT_A8R8G8B8);
-        init_argb_conversion_info(src_format, ck_format, &ck_conv_info);
+        for (i = 0; i < ARRAY_SIZE(argb_row_converters); ++i)
+        {
+            if (argb_row_converters[i].src_format == src_format->format
+                    && argb_row_converters[i].dst_format == dst_format->format)
+            {
+                job.convert_row = argb_row_converters[i].convert_row;
+                break;
+            }
+        }
     }
 
-    for (z = 0; z < min_depth; z++) {
-        const BYTE *src_slice_ptr = src + z * src_slice_pitch;
-        BYTE *dst_slice_ptr = dst + z * dst_slice_pitch;
-
-        for (y = 0; y < min_height; y++) {
-            const BYTE *src_ptr = src_slice_ptr + y * src_row_pitch;
-            BYTE *dst_ptr = dst_slice_ptr + y * dst_row_pitch;
-
-            for (x = 0; x < min_width; x++) {
-                if (!src_format->to_rgba && !dst_format->from_rgba
-                        && src_format->type == dst_format->type
-                        && src_format->bytes_per_pixel <= 4 && dst_format->bytes_per_pixel <= 4)
-                {
-                    DWORD val;
+    min_width = min(src_size->width, dst_size->width);
+    min_height = min(src_size->height, dst_size->height);
+    min_depth = min(src_size->depth, dst_size->depth);
 
-                    get_relevant_argb_components(&conv_info, src_ptr, channels);
-                    val = make_argb_color(&conv_info, channels);
+    argb_job_execute(&job, min_width, min_height, min_depth);
 
-                    if (color_key)
-                    {
-                        DWORD ck_pixel;
+    if (min_depth && src_size->height < dst_size->height) /* black out remaining pixels */
+        memset(dst + src_size->height * dst_row_pitch, 0, dst_row_pitch * (dst_size->height - src_size->height));
+    if (src_size->depth < dst_size->depth) /* black out remaining pixels */
+        memset(dst + src_size->depth * dst_slice_pitch, 0, dst_slice_pitch * (dst_size->depth - src_size->depth));
+}
 
-                        get_relevant_argb_components(&ck_conv_info, src_ptr, channels);
-                        ck_pixel = make_argb_color(&ck_conv_info, channels);
-                        if (ck_pixel == color_key)
-                            val &= ~conv_info.destmask[0];
-                    }
-                    memcpy(dst_ptr, &val, dst_format->bytes_per_pixel);
-                }
-                else
-                {
-                    struct vec4 color, tmp;
+static void point_filter_argb_row(const struct argb_job *job, UINT z, UINT y)
+{
+    const struct volume *src_size = job->src_size, *dst_size = job->dst_size;
+    BYTE *dst_ptr = job->dst + z * job->dst_slice_pitch + y * job->dst_row_pitch;
+    const BYTE *src_row_ptr = job->src + job->src_slice_pitch * (z * src_size->depth / dst_size->depth)
+            + job->src_row_pitch * (y * src_size->height / dst_size->height);
+    UINT x;
 
-                    format_to_vec4(src_format, src_ptr, &color);
-                    if (src_format->to_rgba)
-                        src_format->to_rgba(&color, &tmp, palette);
-                    else
-                        tmp = color;
+    if (job->convert_row && src_size->width == dst_size->width)
+    {
+        job->convert_row(src_row_ptr, dst_ptr, dst_size->width);
+        return;
+    }
 
-                    if (ck_format)
-                    {
-                        DWORD ck_pixel;
+    for (x = 0; x < dst_size->width; x++)
+    {
+        const BYTE *src_ptr = src_row_ptr + (x * src_size->width / dst_size->width) * job->src_format->bytes_per_pixel;
 
-                        format_from_vec4(ck_format, &tmp, (BYTE *)&ck_pixel);
-                        if (ck_pixel == color_key)
-                            tmp.w = 0.0f;
-                    }
+        argb_job_convert_pixel(job, src_ptr, dst_ptr);
+        dst_ptr += job->dst_format->bytes_per_pixel;
+    }
+}
 
-                    if (dst_format->from_rgba)
-                        dst_format->from_rgba(&tmp, &color);
-                    else
-                        color = tmp;
+static void filter_argb_pixels(void (*process_row)(const struct argb_job *job, UINT z, UINT y),
+        const BYTE *src, UINT src_row_pitch, UINT src_slice_pitch, const struct volume *src_size,
+        const struct pixel_format_desc *src_format, BYTE *dst, UINT dst_row_pitch, UINT dst_slice_pitch,
+        const struct volume *dst_size, const struct pixel_format_desc *dst_format, D3DCOLOR color_key,
+        const PALETTEENTRY *palette)
+{
+    struct argb_job job;
+    unsigned int i;
 
-                    format_from_vec4(dst_format, &color, dst_ptr);
-                }
+    argb_job_init(&job, src, src_row_pitch, src_slice_pitch, src_size, src_format,
+            dst, dst_row_pitch, dst_slice_pitch, dst_size, dst_format, color_key, palette);
+    job.process_row = process_row;
 
-                src_ptr += src_format->bytes_per_pixel;
-                dst_ptr += dst_format->bytes_per_pixel;
+    if (!color_key)
+    {
+        for (i = 0; i < ARRAY_SIZE(argb_row_converters); ++i)
+        {
+            if (argb_row_converters[i].src_format == src_format->format
+                    && argb_row_converters[i].dst_format == dst_format->format)
+            {
+                job.convert_row = argb_row_converters[i].convert_row;
+                break;
             }
-
-            if (src_size->width < dst_size->width) /* black out remaining pixels */
-                memset(dst_ptr, 0, dst_format->bytes_per_pixel * (dst_size->width - src_size->width));
         }
+    }
 
-        if (src_size->height < dst_size->height) /* black out remaining pixels */
-            memset(dst + src_size->height * dst_row_pitch, 0, dst_row_pitch * (dst_size->height - src_size->height));
+    if (process_row != point_filter_argb_row && !color_key && src_format == dst_format
+            && src_size->width == dst_size->width * 2 && src_size->height == dst_size->height * 2
+            && src_size->depth == dst_size->depth)
+    {
+        switch (src_format->format)
+        {
+            case D3DFMT_A8R8G8B8:
+            case D3DFMT_A8B8G8R8:
+                job.halve_mask = 0xffffffff;
+                break;
+            case D3DFMT_X8R8G8B8:
+            case D3DFMT_X8B8G8R8:
+                job.halve_mask = 0x00ffffff;
+                break;
+            default:
+                break;
+        }
     }
-    if (src_size->depth < dst_size->depth) /* black out remaining pixels */
-        memset(dst + src_size->depth * dst_slice_pitch, 0, dst_slice_pitch * (dst_size->depth - src_size->depth));
+
+    argb_job_execute(&job, dst_size->width, dst_size->height, dst_size->depth);
 }
 
 /************************************************************
@@ -1737,88 +2019,187 @@ void point_filter_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slic
         const struct volume *dst_size, const struct pixel_format_desc *dst_format, D3DCOLOR color_key,
         const PALETTEENTRY *palette)
 {
-    struct argb_conversion_info conv_info, ck_conv_info;
-    const struct pixel_format_desc *ck_format = NULL;
-    DWORD channels[4];
-    UINT x, y, z;
+    filter_argb_pixels(point_filter_argb_row, src, src_row_pitch, src_slice_pitch, src_size, src_format,
+            dst, dst_row_pitch, dst_slice_pitch, dst_size, dst_format, color_key, palette);
+}
 
-    ZeroMemory(channels, sizeof(channels));
-    init_argb_conversion_info(src_format, dst_format, &conv_info);
+/* Averages 2x2 blocks of 8 bit channels, two channels at a time. */
+static inline DWORD average_8888(DWORD a, DWORD b, DWORD c, DWORD d)
+{
+    DWORD lo = (a & 0x00ff00ff) + (b & 0x00ff00ff) + (c & 0x00ff00ff) + (d & 0x00ff00ff) + 0x00020002;
+    DWORD hi = ((a >> 8) & 0x00ff00ff) + ((b >> 8) & 0x00ff00ff)
+            + ((c >> 8) & 0x00ff00ff) + ((d >> 8) & 0x00ff00ff) + 0x00020002;
 
-    if (color_key)
+    return ((lo >> 2) & 0x00ff00ff) | ((hi << 6) & 0xff00ff00);
+}
+
+static void halve_8888_row(const struct argb_job *job, UINT z, UINT y)
+{
+    const DWORD *src0 = (const DWORD *)(job->src + z * job->src_slice_pitch + 2 * y * job->src_row_pitch);
+    const DWORD *src1 = (const DWORD *)((const BYTE *)src0 + job->src_row_pitch);
+    DWORD *dst = (DWORD *)(job->dst + z * job->dst_slice_pitch + y * job->dst_row_pitch);
+    UINT x;
+
+    for (x = 0; x < job->dst_size->width; ++x)
+        dst[x] = average_8888(src0[2 * x], src0[2 * x + 1], src1[2 * x], src1[2 * x + 1]) & job->halve_mask;
+}
+
+static void get_box_footprint(UINT dst, UINT src_size, UINT dst_size, UINT *start, UINT *end)
+{
+    *start = dst * src_size / dst_size;
+    *end = max((dst + 1) * src_size / dst_size, *start + 1);
+}
+
+/* Each destination pixel is the average of the source pixels it covers.
+ * When magnifying that is a single pixel, as with the point filter. */
+static void box_filter_argb_row(const struct argb_job *job, UINT z, UINT y)
+{
+    const struct volume *src_size = job->src_size, *dst_size = job->dst_size;
+    UINT bpp = job->src_format->bytes_per_pixel;
+    BYTE *dst_ptr = job->dst + z * job->dst_slice_pitch + y * job->dst_row_pitch;
+    UINT x, sx, sy, sz, x0, x1, y0, y1, z0, z1;
+    struct vec4 sum, color;
+    float scale;
+
+    if (job->halve_mask)
     {
-        /* Color keys are always represented in D3DFMT_A8R8G8B8 format. */
-        ck_format = get_format_info(D3DFMT_A8R8G8B8);
-        init_argb_conversion_info(src_format, ck_format, &ck_conv_info);
+        halve_8888_row(job, z, y);
+        return;
     }
 
-    for (z = 0; z < dst_size->depth; z++)
+    get_box_footprint(z, src_size->depth, dst_size->depth, &z0, &z1);
+    get_box_footprint(y, src_size->height, dst_size->height, &y0, &y1);
+
+    for (x = 0; x < dst_size->width; ++x)
     {
-        BYTE *dst_slice_ptr = dst + z * dst_slice_pitch;
-        const BYTE *src_slice_ptr = src + src_slice_pitch * (z * src_size->depth / dst_size->depth);
+        get_box_footprint(x, src_size->width, dst_size->width, &x0, &x1);
+        sum.x = sum.y = sum.z = sum.w = 0.0f;
 
-        for (y = 0; y < dst_size->height; y++)
+        for (sz = z0; sz < z1; ++sz)
         {
-            BYTE *dst_ptr = dst_slice_ptr + y * dst_row_pitch;
-            const BYTE *src_row_ptr = src_slice_ptr + src_row_pitch * (y * src_size->height / dst_size->height);
-
-            for (x = 0; x < dst_size->width; x++)
+            for (sy = y0; sy < y1; ++sy)
             {
-                const BYTE *src_ptr = src_row_ptr + (x * src_size->width / dst_size->width) * src_format->bytes_per_pixel;
+                const BYTE *src_ptr = job->src + sz * job->src_slice_pitch + sy * job->src_row_pitch + x0 * bpp;
 
-                if (!src_format->to_rgba && !dst_format->from_rgba
-                        && src_format->type == dst_format->type
-                        && src_format->bytes_per_pixel <= 4 && dst_format->bytes_per_pixel <= 4)
+                for (sx = x0; sx < x1; ++sx, src_ptr += bpp)
                 {
-                    DWORD val;
+                    argb_job_read_pixel(job, src_ptr, &color);
+                    sum.x += color.x;
+                    sum.y += color.y;
+                    sum.z += color.z;
+                    sum.w += color.w;
+                }
+            }
+        }
 
-                    get_relevant_argb_components(&conv_info, src_ptr, channels);
-                    val = make_argb_color(&conv_info, channels);
+        scale = 1.0f / ((x1 - x0) * (y1 - y0) * (z1 - z0));
+        sum.x *= scale;
+        sum.y *= scale;
+        sum.z *= scale;
+        sum.w *= scale;
+        argb_job_write_pixel(job, &sum, dst_ptr);
+        dst_ptr += job->dst_format->bytes_per_pixel;
+    }
+}
 
-                    if (color_key)
-                    {
-                        DWORD ck_pixel;
+/************************************************************
+ * box_filter_argb_pixels
+ *
+ * Copies the source buffer to the destination buffer, performing
+ * any necessary format conversion, color keying and stretching
+ * using a box filter.
+ */
+void box_filter_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pitch, const struct volume *src_size,
+        const struct pixel_format_desc *src_format, BYTE *dst, UINT dst_row_pitch, UINT dst_slice_pitch,
+        const struct volume *dst_size, const struct pixel_format_desc *dst_format, D3DCOLOR color_key,
+        const PALETTEENTRY *palette)
+{
+    filter_argb_pixels(box_filter_argb_row, src, src_row_pitch, src_slice_pitch, src_size, src_format,
+            dst, dst_row_pitch, dst_slice_pitch, dst_size, dst_format, color_key, palette);
+}
 
-                        get_relevant_argb_components(&ck_conv_info, src_ptr, channels);
-                        ck_pixel = make_argb_color(&ck_conv_info, channels);
-                        if (ck_pixel == color_key)
-                            val &= ~conv_info.destmask[0];
-                    }
-                    memcpy(dst_ptr, &val, dst_format->bytes_per_pixel);
-                }
-                else
-                {
-                    struct vec4 color, tmp;
+/* Returns the two source texels around the center of a destination texel
+ * and the weight of the second one, clamping at the edges. */
+static void get_linear_taps(UINT dst, UINT src_size, UINT dst_size, UINT *pos0, UINT *pos1, float *weight)
+{
+    float pos = (dst + 0.5f) * src_size / dst_size - 0.5f;
 
-                    format_to_vec4(src_format, src_ptr, &color);
-                    if (src_format->to_rgba)
-                        src_format->to_rgba(&color, &tmp, palette);
-                    else
-                        tmp = color;
+    *weight = 0.0f;
+    if (pos <= 0.0f)
+    {
+        *pos0 = *pos1 = 0;
+        return;
+    }
+    *pos0 = min((UINT)pos, src_size - 1);
+    *pos1 = min(*pos0 + 1, src_size - 1);
+    if (*pos1 != *pos0)
+        *weight = pos - *pos0;
+}
 
-                    if (ck_format)
-                    {
-                        DWORD ck_pixel;
+static void lerp_vec4(struct vec4 *dst, const struct vec4 *a, const struct vec4 *b, float weight)
+{
+    dst->x = a->x + (b->x - a->x) * weight;
+    dst->y = a->y + (b->y - a->y) * weight;
+    dst->z = a->z + (b->z - a->z) * weight;
+    dst->w = a->w + (b->w - a->w) * weight;
+}
 
-                        format_from_vec4(ck_format, &tmp, (BYTE *)&ck_pixel);
-                        if (ck_pixel == color_key)
-                            tmp.w = 0.0f;
-                    }
+/* Bilinear filter within the nearest source slice. Halving hits the texel
+ * corners exactly, so that case is the same as the box filter. */
+static void linear_filter_argb_row(const struct argb_job *job, UINT z, UINT y)
+{
+    const struct volume *src_size = job->src_size, *dst_size = job->dst_size;
+    UINT bpp = job->src_format->bytes_per_pixel;
+    BYTE *dst_ptr = job->dst + z * job->dst_slice_pitch + y * job->dst_row_pitch;
+    const BYTE *src_slice, *src_row0, *src_row1;
+    struct vec4 c00, c01, c10, c11, top, bottom;
+    UINT x, x0, x1, y0, y1;
+    float wx, wy;
+
+    if (job->halve_mask)
+    {
+        halve_8888_row(job, z, y);
+        return;
+    }
 
-                    if (dst_format->from_rgba)
-                        dst_format->from_rgba(&tmp, &color);
-                    else
-                        color = tmp;
+    src_slice = job->src + job->src_slice_pitch * (z * src_size->depth / dst_size->depth);
+    get_linear_taps(y, src_size->height, dst_size->height, &y0, &y1, &wy);
+    src_row0 = src_slice + y0 * job->src_row_pitch;
+    src_row1 = src_slice + y1 * job->src_row_pitch;
 
-                    format_from_vec4(dst_format, &color, dst_ptr);
-                }
+    for (x = 0; x < dst_size->width; ++x)
+    {
+        get_linear_taps(x, src_size->width, dst_size->width, &x0, &x1, &wx);
 
-                dst_ptr += dst_format->bytes_per_pixel;
-            }
-        }
+        argb_job_read_pixel(job, src_row0 + x0 * bpp, &c00);
+        argb_job_read_pixel(job, src_row0 + x1 * bpp, &c01);
+        argb_job_read_pixel(job, src_row1 + x0 * bpp, &c10);
+        argb_job_read_pixel(job, src_row1 + x1 * bpp, &c11);
+        lerp_vec4(&top, &c00, &c01, wx);
+        lerp_vec4(&bottom, &c10, &c11, wx);
+        lerp_vec4(&top, &top, &bottom, wy);
+
+        argb_job_write_pixel(job, &top, dst_ptr);
+        dst_ptr += job->dst_format->bytes_per_pixel;
     }
 }
 
+/************************************************************
+ * linear_filter_argb_pixels
+ *
+ * Copies the source buffer to the destination buffer, performing
+ * any necessary format conversion, color keying and stretching
+ * using a bilinear filter.
+ */
+void linear_filter_argb_pixels(const BYTE *src, UINT src_row_pitch, UINT src_slice_pitch, const struct volume *src_size,
+        const struct pixel_format_desc *src_format, BYTE *dst, UINT dst_row_pitch, UINT dst_slice_pitch,
+        const struct volume *dst_size, const struct pixel_format_desc *dst_format, D3DCOLOR color_key,
+        const PALETTEENTRY *palette)
+{
+    filter_argb_pixels(linear_filter_argb_row, src, src_row_pitch, src_slice_pitch, src_size, src_format,
+            dst, dst_row_pitch, dst_slice_pitch, dst_size, dst_format, color_key, palette);
+}
+
 typedef BOOL (*dxtn_conversion_func)(const BYTE *src, BYTE *dst, DWORD pitch_in, DWORD pitch_out,
                                      enum wined3d_format_id format, unsigned int w, unsigned int h);
 
@@ -2022,20 +2403,32 @@ HRESULT WINAPI D3DXLoadSurfaceFromMemory(IDirect3DSurface9 *dst_surface,
             tmp_dst_pitch  = lockrect.Pitch;
         }
 
-        if ((filter & 0xf) == D3DX_FILTER_NONE)
+        switch (filter & 0xf)
         {
-            convert_argb_pixels(tmp_src_memory, tmp_src_pitch, 0, &src_size, srcformatdesc,
-                    tmp_dst_memory, tmp_dst_pitch, 0, &dst_size, destformatdesc, color_key, src_palette);
-        }
-        else /* if ((filter & 0xf) == D3DX_FILTER_POINT) */
-        {
-            if ((filter & 0xf) != D3DX_FILTER_POINT)
+            case D3DX_FILTER_NONE:
+                convert_argb_pixels(tmp_src_memory, tmp_src_pitch, 0, &src_size, srcformatdesc,
+                        tmp_dst_memory, tmp_dst_pitch, 0, &dst_size, destformatdesc, color_key, src_palette);
+                break;
+
+            case D3DX_FILTER_LINEAR:
+                linear_filter_argb_pixels(tmp_src_memory, tmp_src_pitch, 0, &src_size, srcformatdesc,
+                        tmp_dst_memory, tmp_dst_pitch, 0, &dst_size, destformatdesc, color_key, src_palette);
+                break;
+
+            /* The triangle filter is approximated with a box filter. */
+            case D3DX_FILTER_TRIANGLE:
+            case D3DX_FILTER_BOX:
+                box_filter_argb_pixels(tmp_src_memory, tmp_src_pitch, 0, &src_size, srcformatdesc,
+                        tmp_dst_memory, tmp_dst_pitch, 0, &dst_size, destformatdesc, color_key, src_palette);
+                break;
+
+            default:
                 FIXME("Unhandled filter %#x.\n", filter);
-
-            /* Always apply a point filter until D3DX_FILTER_LINEAR,
-             * D3DX_FILTER_TRIANGLE and D3DX_FILTER_BOX are implemented. */
-            point_filter_argb_pixels(tmp_src_memory, tmp_src_pitch, 0, &src_size, srcformatdesc,
-                    tmp_dst_memory, tmp_dst_pitch, 0, &dst_size, destformatdesc, color_key, src_palette);
+                /* fall through */
+            case D3DX_FILTER_POINT:
+                point_filter_argb_pixels(tmp_src_memory, tmp_src_pitch, 0, &src_size, srcformatdesc,
+                        tmp_dst_memory, tmp_dst_pitch, 0, &dst_size, destformatdesc, color_key, src_palette);
+                break;
         }
 
         /* handle post-conversion */
@@ -2446,6 +2446,180 @@ static void test_D3DXVec_Array(void)
     }
 }
 
+static void test_D3DXVec_Array_batch(void)
+{
+    struct
+    {
+        D3DXVECTOR3 v;
+        float pad[2];
+    } inp[67], out[67];
+    D3DXMATRIX mat, projection, view;
+    D3DXVECTOR3 expected;
+    D3DXVECTOR4 expected4, inp4[67], out4[67];
+    D3DXPLANE expected_plane, out_plane[67];
+    D3DVIEWPORT9 viewport;
+    unsigned int i;
+
+    viewport.X = 10; viewport.Y = 5;
+    viewport.Width = 800; viewport.Height = 680;
+    viewport.MinZ = 0.2f; viewport.MaxZ = 0.9f;
+
+    for (i = 0; i < ARRAY_SIZE(inp); ++i)
+    {
+        inp[i].v.x = i * 0.25f - 3.0f;
+        inp[i].v.y = 2.0f - i * 0.125f;
+        inp[i].v.z = i * 0.5f + 1.0f;
+        inp[i].pad[0] = inp[i].pad[1] = -1.0f;
+    }
+
+    D3DXMatrixRotationYawPitchRoll(&mat, 0.3f, -0.7f, 1.1f);
+    U(mat).m[3][0] = 4.0f; U(mat).m[3][1] = -2.0f; U(mat).m[3][2] = 9.0f;
+    D3DXMatrixPerspectiveFovLH(&projection, D3DX_PI / 4.0f, 20.0f / 17.0f, 1.0f, 1000.0f);
+    D3DXMatrixLookAtLH(&view, &inp[3].v, &inp[40].v, &inp[7].v);
+
+    /* The array functions work on the whole batch at once and have to give
+     * the same results as the single element functions, with padded
+     * strides and in place. */
+    memcpy(out, inp, sizeof(out));
+    D3DXVec3TransformCoordArray(&out[0].v, sizeof(*out), &out[0].v, sizeof(*out), &mat, ARRAY_SIZE(out));
+    for (i = 0; i < ARRAY_SIZE(inp); ++i)
+    {
+        D3DXVec3TransformCoord(&expected, &inp[i].v, &mat);
+        expect_vec3(&expected, &out[i].v, 1);
+        ok(out[i].pad[0] == -1.0f && out[i].pad[1] == -1.0f, "Got unexpected padding at index %u.\n", i);
+    }
+
+    memcpy(out, inp, sizeof(out));
+    D3DXVec3TransformNormalArray(&out[0].v, sizeof(*out), &out[0].v, sizeof(*out), &mat, ARRAY_SIZE(out));
+    for (i = 0; i < ARRAY_SIZE(inp); ++i)
+    {
+        D3DXVec3TransformNormal(&expected, &inp[i].v, &mat);
+        expect_vec3(&expected, &out[i].v, 1);
+    }
+
+    memcpy(out, inp, sizeof(out));
+    D3DXVec3ProjectArray(&out[0].v, sizeof(*out), &out[0].v, sizeof(*out),
+            &viewport, &projection, &view, &mat, ARRAY_SIZE(out));
+    for (i = 0; i < ARRAY_SIZE(inp); ++i)
+    {
+        D3DXVec3Project(&expected, &inp[i].v, &viewport, &projection, &view, &mat);
+        expect_vec3(&expected, &out[i].v, 8);
+    }
+
+    memcpy(out, inp, sizeof(out));
+    D3DXVec3UnprojectArray(&out[0].v, sizeof(*out), &out[0].v, sizeof(*out),
+            &viewport, &projection, &view, &mat, ARRAY_SIZE(out));
+    for (i = 0; i < ARRAY_SIZE(inp); ++i)
+    {
+        D3DXVec3Unproject(&expected, &inp[i].v, &viewport, &projection, &view, &mat);
+        expect_vec3(&expected, &out[i].v, 8);
+    }
+
+    /* The transform arrays may use SIMD code, while the single element
+     * functions may keep intermediate results in extended precision. Use
+     * data without cancellation so the two differ by rounding only. */
+    for (i = 0; i < ARRAY_SIZE(inp4); ++i)
+    {
+        inp4[i].x = i * 0.25f + 0.5f;
+        inp4[i].y = i * 0.125f + 1.0f;
+        inp4[i].z = i * 0.5f + 1.0f;
+        inp4[i].w = 2.0f - i * 0.0078125f;
+    }
+    for (i = 0; i < 16; ++i)
+        U(mat).m[i / 4][i % 4] = (i + 1) * 0.1f;
+
+    D3DXVec2TransformArray(out4, sizeof(*out4), (D3DXVECTOR2 *)inp4, sizeof(*inp4), &mat, ARRAY_SIZE(out4));
+    for (i = 0; i < ARRAY_SIZE(inp4); ++i)
+    {
+        D3DXVec2Transform(&expected4, (D3DXVECTOR2 *)&inp4[i], &mat);
+        expect_vec4(&expected4, &out4[i], 2);
+    }
+
+    D3DXVec3TransformArray(out4, sizeof(*out4), (D3DXVECTOR3 *)inp4, sizeof(*inp4), &mat, ARRAY_SIZE(out4));
+    for (i = 0; i < ARRAY_SIZE(inp4); ++i)
+    {
+        D3DXVec3Transform(&expected4, (D3DXVECTOR3 *)&inp4[i], &mat);
+        expect_vec4(&expected4, &out4[i], 2);
+    }
+
+    memcpy(out4, inp4, sizeof(out4));
+    D3DXVec4TransformArray(out4, sizeof(*out4), out4, sizeof(*out4), &mat, ARRAY_SIZE(out4));
+    for (i = 0; i < ARRAY_SIZE(inp4); ++i)
+    {
+        D3DXVec4Transform(&expected4, &inp4[i], &mat);
+        expect_vec4(&expected4, &out4[i], 2);
+    }
+
+    memcpy(out_plane, inp4, sizeof(out_plane));
+    D3DXPlaneTransformArray(out_plane, sizeof(*out_plane), out_plane, sizeof(*out_plane), &mat, ARRAY_SIZE(out_plane));
+    for (i = 0; i < ARRAY_SIZE(inp4); ++i)
+    {
+        D3DXPlaneTransform(&expected_plane, (D3DXPLANE *)&inp4[i], &mat);
+        expect_plane(&expected_plane, &out_plane[i], 2);
+    }
+}
+
+/* Run with "d3dx9_36_test.exe math bench [elements] [iterations]". */
+static void benchmark_transform_arrays(unsigned int elements, unsigned int iterations)
+{
+    LARGE_INTEGER start, end, freq;
+    D3DXVECTOR4 *in, *out;
+    double array_time, loop_time;
+    unsigned int i, j;
+    D3DXMATRIX mat;
+
+    in = HeapAlloc(GetProcessHeap(), 0, elements * sizeof(*in));
+    out = HeapAlloc(GetProcessHeap(), 0, elements * sizeof(*out));
+    for (i = 0; i < elements; ++i)
+    {
+        in[i].x = i * 0.25f;
+        in[i].y = 2.0f - i * 0.125f;
+        in[i].z = i * 0.5f + 1.0f;
+        in[i].w = 1.0f;
+    }
+    D3DXMatrixRotationYawPitchRoll(&mat, 0.3f, -0.7f, 1.1f);
+    QueryPerformanceFrequency(&freq);
+
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < iterations; ++i)
+        D3DXVec3TransformArray(out, sizeof(*out), (D3DXVECTOR3 *)in, sizeof(*in), &mat, elements);
+    QueryPerformanceCounter(&end);
+    array_time = (end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < iterations; ++i)
+    {
+        for (j = 0; j < elements; ++j)
+            D3DXVec3Transform(&out[j], (D3DXVECTOR3 *)&in[j], &mat);
+    }
+    QueryPerformanceCounter(&end);
+    loop_time = (end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+
+    trace("D3DXVec3TransformArray: %.2f ns per element, D3DXVec3Transform loop: %.2f ns per element.\n",
+            array_time * 1e9 / ((double)elements * iterations), loop_time * 1e9 / ((double)elements * iterations));
+
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < iterations; ++i)
+        D3DXVec4TransformArray(out, sizeof(*out), in, sizeof(*in), &mat, elements);
+    QueryPerformanceCounter(&end);
+    array_time = (end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < iterations; ++i)
+    {
+        for (j = 0; j < elements; ++j)
+            D3DXVec4Transform(&out[j], &in[j], &mat);
+    }
+    QueryPerformanceCounter(&end);
+    loop_time = (end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+
+    trace("D3DXVec4TransformArray: %.2f ns per element, D3DXVec4Transform loop: %.2f ns per element.\n",
+            array_time * 1e9 / ((double)elements * iterations), loop_time * 1e9 / ((double)elements * iterations));
+
+    HeapFree(GetProcessHeap(), 0, out);
+    HeapFree(GetProcessHeap(), 0, in);
+}
+
 static void test_D3DXFloat_Array(void)
 {
     unsigned int i;
@@ -3612,6 +3786,16 @@ static void test_D3DXSHScale(void)
 
 START_TEST(math)
 {
+    char **argv;
+    int argc;
+
+    argc = winetest_get_mainargs(&argv);
+    if (argc >= 3 && !strcmp(argv[2], "bench"))
+    {
+        benchmark_transform_arrays(argc >= 4 ? atoi(argv[3]) : 4096, argc >= 5 ? atoi(argv[4]) : 1000);
+        return;
+    }
+
     D3DXColorTest();
     D3DXFresnelTest();
     D3DXMatrixTest();
@@ -3625,6 +3809,7 @@ START_TEST(math)
     test_Matrix_Decompose();
     test_Matrix_Transformation2D();
     test_D3DXVec_Array();
+    test_D3DXVec_Array_batch();
     test_D3DXFloat_Array();
     test_D3DXSHAdd();
     test_D3DXSHDot();
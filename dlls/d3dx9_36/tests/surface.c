@@ -1256,6 +1256,188 @@ static void test_D3DXLoadSurface(IDirect3DDevice9 *device)
     if(testbitmap_ok) DeleteFileA("testbitmap.bmp");
 }
 
+/* Large images are converted in bands on several threads, the result must
+ * match loading the image in strips that are small enough to be converted
+ * sequentially. */
+static void test_large_conversion(IDirect3DDevice9 *device)
+{
+    static const struct
+    {
+        D3DFORMAT format;
+        unsigned int bpp;
+    }
+    tests[] =
+    {
+        {D3DFMT_X8R8G8B8,     4},
+        {D3DFMT_X1R5G5B5,     2},
+        {D3DFMT_A16B16G16R16, 8},
+    };
+    const unsigned int width = 512, height = 512, strip = 64, dst_height = height / 2 + strip * 2;
+    IDirect3DSurface9 *surf, *ref;
+    D3DLOCKED_RECT lock, ref_lock;
+    unsigned int i, x, y;
+    DWORD *src, color = 0;
+    RECT rect;
+    HRESULT hr;
+
+    src = HeapAlloc(GetProcessHeap(), 0, width * height * sizeof(*src));
+    for (y = 0; y < height; ++y)
+        for (x = 0; x < width; ++x)
+            src[y * width + x] = (x * 0x01000193) ^ (y * 0x9e3779b9);
+
+    for (i = 0; i < sizeof(tests) / sizeof(*tests); ++i)
+    {
+        hr = IDirect3DDevice9_CreateOffscreenPlainSurface(device, width, height, tests[i].format,
+                D3DPOOL_SCRATCH, &surf, NULL);
+        if (FAILED(hr))
+        {
+            skip("Failed to create surface with format %#x, hr %#x.\n", tests[i].format, hr);
+            continue;
+        }
+        hr = IDirect3DDevice9_CreateOffscreenPlainSurface(device, width, height, tests[i].format,
+                D3DPOOL_SCRATCH, &ref, NULL);
+        ok(SUCCEEDED(hr), "Failed to create surface, hr %#x.\n", hr);
+
+        SetRect(&rect, 0, 0, width, height);
+        hr = D3DXLoadSurfaceFromMemory(surf, NULL, NULL, src, D3DFMT_A8R8G8B8, width * sizeof(*src),
+                NULL, &rect, D3DX_FILTER_NONE, 0);
+        ok(hr == D3D_OK, "Test %u: Got unexpected hr %#x.\n", i, hr);
+        for (y = 0; y < height; y += strip)
+        {
+            SetRect(&rect, 0, y, width, y + strip);
+            hr = D3DXLoadSurfaceFromMemory(ref, NULL, &rect, src, D3DFMT_A8R8G8B8, width * sizeof(*src),
+                    NULL, &rect, D3DX_FILTER_NONE, 0);
+            ok(hr == D3D_OK, "Test %u: Got unexpected hr %#x.\n", i, hr);
+        }
+
+        hr = IDirect3DSurface9_LockRect(surf, &lock, NULL, D3DLOCK_READONLY);
+        ok(SUCCEEDED(hr), "Failed to lock surface, hr %#x.\n", hr);
+        hr = IDirect3DSurface9_LockRect(ref, &ref_lock, NULL, D3DLOCK_READONLY);
+        ok(SUCCEEDED(hr), "Failed to lock surface, hr %#x.\n", hr);
+        for (y = 0; y < height; ++y)
+        {
+            if (memcmp((BYTE *)lock.pBits + y * lock.Pitch, (BYTE *)ref_lock.pBits + y * ref_lock.Pitch,
+                    width * tests[i].bpp))
+                break;
+        }
+        ok(y == height, "Test %u: Row %u differs.\n", i, y);
+        IDirect3DSurface9_UnlockRect(ref);
+        IDirect3DSurface9_UnlockRect(surf);
+
+        check_release((IUnknown *)ref, 0);
+        check_release((IUnknown *)surf, 0);
+    }
+
+    /* Point filtering, every destination pixel comes from one source pixel. */
+    hr = IDirect3DDevice9_CreateOffscreenPlainSurface(device, width / 2, dst_height,
+            D3DFMT_X8R8G8B8, D3DPOOL_SCRATCH, &surf, NULL);
+    ok(SUCCEEDED(hr), "Failed to create surface, hr %#x.\n", hr);
+    SetRect(&rect, 0, 0, width, height);
+    hr = D3DXLoadSurfaceFromMemory(surf, NULL, NULL, src, D3DFMT_A8R8G8B8, width * sizeof(*src),
+            NULL, &rect, D3DX_FILTER_POINT, 0);
+    ok(hr == D3D_OK, "Got unexpected hr %#x.\n", hr);
+    hr = IDirect3DSurface9_LockRect(surf, &lock, NULL, D3DLOCK_READONLY);
+    ok(SUCCEEDED(hr), "Failed to lock surface, hr %#x.\n", hr);
+    for (y = 0; y < dst_height; ++y)
+    {
+        const DWORD *row = (const DWORD *)((BYTE *)lock.pBits + y * lock.Pitch);
+        const DWORD *src_row = src + (y * height / dst_height) * width;
+
+        for (x = 0; x < width / 2; ++x)
+        {
+            if ((row[x] & 0x00ffffff) != (src_row[x * 2] & 0x00ffffff))
+            {
+                color = row[x];
+                break;
+            }
+        }
+        if (x != width / 2)
+            break;
+    }
+    ok(y == dst_height, "Got unexpected color 0x%08x at %u, %u.\n", color, x, y);
+    IDirect3DSurface9_UnlockRect(surf);
+    check_release((IUnknown *)surf, 0);
+
+    HeapFree(GetProcessHeap(), 0, src);
+}
+
+static BOOL color_match(DWORD c1, DWORD c2)
+{
+    unsigned int i;
+
+    for (i = 0; i < 4; ++i)
+    {
+        if (abs((int)((c1 >> (i * 8)) & 0xff) - (int)((c2 >> (i * 8)) & 0xff)) > 1)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static void test_filters(IDirect3DDevice9 *device)
+{
+    static const DWORD pixdata[] =
+    {
+        0xff000000, 0x80402010, 0x00000000, 0xffffffff,
+        0x00402010, 0x80000000, 0x40404040, 0xc0c0c0c0,
+    };
+    static const DWORD pixdata_row[] = {0x00300000, 0x00600000, 0x00900000};
+    static const struct
+    {
+        DWORD filter;
+        D3DFORMAT format;
+        DWORD expected[2];
+    }
+    tests[] =
+    {
+        {D3DX_FILTER_BOX,    D3DFMT_A8R8G8B8, {0x80201008, 0x80808080}},
+        {D3DX_FILTER_BOX,    D3DFMT_X8R8G8B8, {0x00201008, 0x00808080}},
+        {D3DX_FILTER_LINEAR, D3DFMT_A8R8G8B8, {0x80201008, 0x80808080}},
+        {D3DX_FILTER_LINEAR, D3DFMT_X8R8G8B8, {0x00201008, 0x00808080}},
+    };
+    IDirect3DSurface9 *surf;
+    D3DLOCKED_RECT lock;
+    unsigned int i;
+    RECT rect, dst_rect;
+    DWORD color;
+    HRESULT hr;
+
+    for (i = 0; i < sizeof(tests) / sizeof(*tests); ++i)
+    {
+        hr = IDirect3DDevice9_CreateOffscreenPlainSurface(device, 2, 1, tests[i].format,
+                D3DPOOL_SCRATCH, &surf, NULL);
+        ok(SUCCEEDED(hr), "Test %u: Failed to create surface, hr %#x.\n", i, hr);
+
+        SetRect(&rect, 0, 0, 4, 2);
+        hr = D3DXLoadSurfaceFromMemory(surf, NULL, NULL, pixdata, D3DFMT_A8R8G8B8, 4 * sizeof(DWORD),
+                NULL, &rect, tests[i].filter, 0);
+        ok(hr == D3D_OK, "Test %u: Got unexpected hr %#x.\n", i, hr);
+
+        hr = IDirect3DSurface9_LockRect(surf, &lock, NULL, D3DLOCK_READONLY);
+        ok(SUCCEEDED(hr), "Test %u: Failed to lock surface, hr %#x.\n", i, hr);
+        color = ((DWORD *)lock.pBits)[0];
+        ok(color_match(color, tests[i].expected[0]), "Test %u: Got unexpected color 0x%08x.\n", i, color);
+        color = ((DWORD *)lock.pBits)[1];
+        ok(color_match(color, tests[i].expected[1]), "Test %u: Got unexpected color 0x%08x.\n", i, color);
+        IDirect3DSurface9_UnlockRect(surf);
+
+        /* Minifying by 3, the box covers all three pixels and the linear
+         * filter samples the middle one. */
+        SetRect(&rect, 0, 0, 3, 1);
+        SetRect(&dst_rect, 0, 0, 1, 1);
+        hr = D3DXLoadSurfaceFromMemory(surf, NULL, &dst_rect, pixdata_row, D3DFMT_X8R8G8B8, sizeof(pixdata_row),
+                NULL, &rect, tests[i].filter, 0);
+        ok(hr == D3D_OK, "Test %u: Got unexpected hr %#x.\n", i, hr);
+
+        hr = IDirect3DSurface9_LockRect(surf, &lock, NULL, D3DLOCK_READONLY);
+        ok(SUCCEEDED(hr), "Test %u: Failed to lock surface, hr %#x.\n", i, hr);
+        color = ((DWORD *)lock.pBits)[0] & 0x00ffffff;
+        ok(color_match(color, 0x00600000), "Test %u: Got unexpected color 0x%08x.\n", i, color);
+        IDirect3DSurface9_UnlockRect(surf);
+
+        check_release((IUnknown *)surf, 0);
+    }
+}
+
 static void test_D3DXSaveSurfaceToFileInMemory(IDirect3DDevice9 *device)
 {
     HRESULT hr;
@@ -1461,6 +1643,8 @@ START_TEST(surface)
 
     test_D3DXGetImageInfo();
     test_D3DXLoadSurface(device);
+    test_large_conversion(device);
+    test_filters(device);
     test_D3DXSaveSurfaceToFileInMemory(device);
     test_D3DXSaveSurfaceToFile(device);
 
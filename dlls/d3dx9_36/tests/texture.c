@@ -869,6 +869,9 @@ static void test_D3DXFilterTexture(IDirect3DDevice9 *device)
     IDirect3DTexture9 *tex;
     IDirect3DCubeTexture9 *cubetex;
     IDirect3DVolumeTexture9 *voltex;
+    D3DLOCKED_RECT lock_rect;
+    unsigned int face, x, y;
+    DWORD color;
     HRESULT hr;
 
     hr = IDirect3DDevice9_CreateTexture(device, 256, 256, 5, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &tex, NULL);
@@ -951,6 +954,33 @@ static void test_D3DXFilterTexture(IDirect3DDevice9 *device)
 
         hr = D3DXFilterTexture((IDirect3DBaseTexture9*) cubetex, NULL, 5, D3DX_FILTER_NONE); /* Invalid miplevel */
         ok(hr == D3DERR_INVALIDCALL, "D3DXFilterTexture returned %#x, expected %#x\n", hr, D3DERR_INVALIDCALL);
+
+        /* Faces are filtered independently. */
+        for (face = 0; face < 6; ++face)
+        {
+            hr = IDirect3DCubeTexture9_LockRect(cubetex, face, 0, &lock_rect, NULL, 0);
+            ok(hr == D3D_OK, "Failed to lock face %u, hr %#x.\n", face, hr);
+            for (y = 0; y < 256; ++y)
+            {
+                DWORD *row = (DWORD *)((BYTE *)lock_rect.pBits + y * lock_rect.Pitch);
+
+                for (x = 0; x < 256; ++x)
+                    row[x] = (x + y) & 1 ? 0xff000000 | face * 0x202020 : 0xff000000;
+            }
+            IDirect3DCubeTexture9_UnlockRect(cubetex, face, 0);
+        }
+
+        hr = D3DXFilterTexture((IDirect3DBaseTexture9*) cubetex, NULL, 0, D3DX_FILTER_BOX);
+        ok(hr == D3D_OK, "D3DXFilterTexture returned %#x, expected %#x\n", hr, D3D_OK);
+
+        for (face = 0; face < 6; ++face)
+        {
+            hr = IDirect3DCubeTexture9_LockRect(cubetex, face, 1, &lock_rect, NULL, D3DLOCK_READONLY);
+            ok(hr == D3D_OK, "Failed to lock face %u, hr %#x.\n", face, hr);
+            color = ((DWORD *)lock_rect.pBits)[0];
+            ok(color == (0xff000000 | face * 0x101010), "Face %u: got unexpected color 0x%08x.\n", face, color);
+            IDirect3DCubeTexture9_UnlockRect(cubetex, face, 1);
+        }
         IDirect3DCubeTexture9_Release(cubetex);
     }
     else
@@ -23,6 +23,7 @@
 #include "wine/port.h"
 
 #include "d3dx9_private.h"
+#include "wine/bands.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3dx);
 
@@ -62,12 +63,53 @@ static HRESULT get_surface(D3DRESOURCETYPE type, struct IDirect3DBaseTexture9 *t
     }
 }
 
+/* The faces of a cube texture are independent, so they are filtered
+ * concurrently. Each level is generated from the previous one. */
+struct filter_faces_job
+{
+    D3DRESOURCETYPE type;
+    IDirect3DBaseTexture9 *texture;
+    const PALETTEENTRY *palette;
+    UINT srclevel;
+    DWORD filter;
+    HRESULT hr[6];
+};
+
+static void filter_face(void *param, unsigned int face)
+{
+    struct filter_faces_job *job = param;
+    IDirect3DSurface9 *topsurf, *mipsurf;
+    UINT level = job->srclevel + 1;
+    HRESULT hr;
+
+    if (FAILED(get_surface(job->type, job->texture, face, job->srclevel, &topsurf)))
+    {
+        job->hr[face] = D3DERR_INVALIDCALL;
+        return;
+    }
+
+    hr = D3D_OK;
+    while (get_surface(job->type, job->texture, face, level, &mipsurf) == D3D_OK)
+    {
+        hr = D3DXLoadSurfaceFromSurface(mipsurf, job->palette, NULL, topsurf, job->palette, NULL, job->filter, 0);
+        IDirect3DSurface9_Release(topsurf);
+        topsurf = mipsurf;
+
+        if (FAILED(hr))
+            break;
+
+        level++;
+    }
+
+    IDirect3DSurface9_Release(topsurf);
+    job->hr[face] = hr;
+}
+
 HRESULT WINAPI D3DXFilterTexture(IDirect3DBaseTexture9 *texture,
                                  const PALETTEENTRY *palette,
                                  UINT srclevel,
                                  DWORD filter)
 {
-    UINT level;
     HRESULT hr;
     D3DRESOURCETYPE type;
 
@@ -89,7 +131,7 @@ HRESULT WINAPI D3DXFilterTexture(IDirect3DBaseTexture9 *texture,
         case D3DRTYPE_TEXTURE:
         case D3DRTYPE_CUBETEXTURE:
         {
-            IDirect3DSurface9 *topsurf, *mipsurf;
+            struct filter_faces_job job;
             D3DSURFACE_DESC desc;
             int i, numfaces;
 
@@ -112,29 +154,17 @@ HRESULT WINAPI D3DXFilterTexture(IDirect3DBaseTexture9 *texture,
                     filter = D3DX_FILTER_BOX | D3DX_FILTER_DITHER;
             }
 
+            job.type = type;
+            job.texture = texture;
+            job.palette = palette;
+            job.srclevel = srclevel;
+            job.filter = filter;
+            wine_run_bands(filter_face, &job, numfaces, get_thread_count());
+
             for (i = 0; i < numfaces; i++)
             {
-                level = srclevel + 1;
-                hr = get_surface(type, texture, i, srclevel, &topsurf);
-
-                if (FAILED(hr))
-                    return D3DERR_INVALIDCALL;
-
-                while (get_surface(type, texture, i, level, &mipsurf) == D3D_OK)
-                {
-                    hr = D3DXLoadSurfaceFromSurface(mipsurf, palette, NULL, topsurf, palette, NULL, filter, 0);
-                    IDirect3DSurface9_Release(topsurf);
-                    topsurf = mipsurf;
-
-                    if (FAILED(hr))
-                        break;
-
-                    level++;
-                }
-
-                IDirect3DSurface9_Release(topsurf);
-                if (FAILED(hr))
-                    return hr;
+                if (FAILED(job.hr[i]))
+                    return job.hr[i];
             }
 
             return D3D_OK;
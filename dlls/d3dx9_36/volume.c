@@ -204,20 +204,36 @@ HRESULT WINAPI D3DXLoadVolumeFromMemory(IDirect3DVolume9 *dst_volume,
         hr = IDirect3DVolume9_LockBox(dst_volume, &locked_box, dst_box, 0);
         if (FAILED(hr)) return hr;
 
-        if ((filter & 0xf) == D3DX_FILTER_NONE)
+        switch (filter & 0xf)
         {
-            convert_argb_pixels(src_memory, src_row_pitch, src_slice_pitch, &src_size, src_format_desc,
-                    locked_box.pBits, locked_box.RowPitch, locked_box.SlicePitch, &dst_size, dst_format_desc, color_key,
-                    src_palette);
-        }
-        else
-        {
-            if ((filter & 0xf) != D3DX_FILTER_POINT)
+            case D3DX_FILTER_NONE:
+                convert_argb_pixels(src_memory, src_row_pitch, src_slice_pitch, &src_size, src_format_desc,
+                        locked_box.pBits, locked_box.RowPitch, locked_box.SlicePitch, &dst_size, dst_format_desc,
+                        color_key, src_palette);
+                break;
+
+            case D3DX_FILTER_LINEAR:
+                linear_filter_argb_pixels(src_addr, src_row_pitch, src_slice_pitch, &src_size, src_format_desc,
+                        locked_box.pBits, locked_box.RowPitch, locked_box.SlicePitch, &dst_size, dst_format_desc,
+                        color_key, src_palette);
+                break;
+
+            /* The triangle filter is approximated with a box filter. */
+            case D3DX_FILTER_TRIANGLE:
+            case D3DX_FILTER_BOX:
+                box_filter_argb_pixels(src_addr, src_row_pitch, src_slice_pitch, &src_size, src_format_desc,
+                        locked_box.pBits, locked_box.RowPitch, locked_box.SlicePitch, &dst_size, dst_format_desc,
+                        color_key, src_palette);
+                break;
+
+            default:
                 FIXME("Unhandled filter %#x.\n", filter);
-
-            point_filter_argb_pixels(src_addr, src_row_pitch, src_slice_pitch, &src_size, src_format_desc,
-                    locked_box.pBits, locked_box.RowPitch, locked_box.SlicePitch, &dst_size, dst_format_desc, color_key,
-                    src_palette);
+                /* fall through */
+            case D3DX_FILTER_POINT:
+                point_filter_argb_pixels(src_addr, src_row_pitch, src_slice_pitch, &src_size, src_format_desc,
+                        locked_box.pBits, locked_box.RowPitch, locked_box.SlicePitch, &dst_size, dst_format_desc,
+                        color_key, src_palette);
+                break;
         }
 
         IDirect3DVolume9_UnlockBox(dst_volume);
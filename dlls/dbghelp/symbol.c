@@ -694,7 +694,8 @@ static void symt_fill_sym_info(struct module_pair* pair,
     name = symt_get_name(sym);
     if (sym_info->MaxNameLen)
     {
-        if (sym->tag != SymTagPublicSymbol || !(dbghelp_options & SYMOPT_UNDNAME) ||
+        /* only names starting with '?' are decorated, don't bother undecorating others */
+        if (sym->tag != SymTagPublicSymbol || !(dbghelp_options & SYMOPT_UNDNAME) || name[0] != '?' ||
             ((sym_info->NameLen = UnDecorateSymbolName(name, sym_info->Name,
                                                        sym_info->MaxNameLen, UNDNAME_NAME_ONLY)) == 0))
         {
@@ -21,8 +21,11 @@
 #include <assert.h>
 
 #include "gdi_private.h"
+#include "winreg.h"
 #include "dibdrv.h"
 
+#include "wine/unicode.h"
+#include "wine/bands.h"
 #include "wine/debug.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(dib);
@@ -466,6 +469,147 @@ static int get_overlap( const dib_info *dst, const RECT *dst_rect,
     return ret;
 }
 
+/* Large operations can optionally be split into horizontal bands of the
+ * destination that are rendered concurrently on the thread pool.  Bands never
+ * share destination rows and the primitives compute every row independently,
+ * so the result is identical to rendering sequentially. */
+
+#define BAND_MIN_PIXELS (512 * 512)  /* smaller operations are always rendered sequentially */
+#define BAND_MIN_HEIGHT 32
+
+static INIT_ONCE render_threads_once = INIT_ONCE_STATIC_INIT;
+static int render_threads;
+
+static BOOL WINAPI init_render_threads( INIT_ONCE *once, void *param, void **context )
+{
+    static const WCHAR gdi_keyW[] = {'S','o','f','t','w','a','r','e','\\','W','i','n','e','\\','G','D','I',0};
+    static const WCHAR render_threadsW[] = {'R','e','n','d','e','r','T','h','r','e','a','d','s',0};
+    SYSTEM_INFO info;
+    WCHAR buf[12];
+    DWORD type, count = sizeof(buf) - sizeof(WCHAR), value = 0;
+    HKEY key;
+
+    if (RegOpenKeyW( HKEY_CURRENT_USER, gdi_keyW, &key )) return TRUE;
+    if (!RegQueryValueExW( key, render_threadsW, NULL, &type, (BYTE *)buf, &count ))
+    {
+        if (type == REG_DWORD && count == sizeof(value)) memcpy( &value, buf, sizeof(value) );
+        else if (type == REG_SZ)
+        {
+            buf[count / sizeof(WCHAR)] = 0;
+            value = atoiW( buf );
+        }
+    }
+    RegCloseKey( key );
+
+    GetSystemInfo( &info );
+    render_threads = min( value, info.dwNumberOfProcessors );
+    if (render_threads > 1) TRACE( "rendering large operations with %d threads\n", render_threads );
+    return TRUE;
+}
+
+/* number of bands to split an operation into, 1 means sequential rendering */
+static int get_band_count( LONGLONG pixels, int height )
+{
+    int count;
+
+    InitOnceExecuteOnce( &render_threads_once, init_render_threads, NULL, NULL );
+    if (render_threads <= 1 || pixels < BAND_MIN_PIXELS) return 1;
+    count = min( render_threads * 4, height / BAND_MIN_HEIGHT );
+    return max( 1, min( count, WINE_MAX_BANDS ));
+}
+
+enum rect_op_type
+{
+    RECT_OP_COPY,
+    RECT_OP_MASK,
+    RECT_OP_BLEND,
+    RECT_OP_GRADIENT
+};
+
+/* a primitive applied to a list of y-sorted destination rectangles */
+struct rect_op
+{
+    enum rect_op_type type;
+    const dib_info   *dst;
+    const RECT       *dst_rect;
+    const dib_info   *src;
+    const RECT       *src_rect;
+    const RECT       *rects;
+    int               count;
+    int               top;
+    int               band_height;
+    int               rop2;
+    BLENDFUNCTION     blend;
+    const TRIVERTEX  *vert;
+    int               mode;
+    LONG              failed;
+};
+
+static void render_rect_op_band( void *param, unsigned int band )
+{
+    struct rect_op *op = param;
+    int i, top = op->top + (int)band * op->band_height, bottom = top + op->band_height;
+    POINT origin;
+    RECT rc;
+
+    for (i = 0; i < op->count; i++)
+    {
+        if (op->rects[i].top >= bottom) break;
+        rc = op->rects[i];
+        rc.top    = max( rc.top, top );
+        rc.bottom = min( rc.bottom, bottom );
+        if (rc.top >= rc.bottom) continue;
+
+        if (op->src)
+        {
+            origin.x = op->src_rect->left + rc.left - op->dst_rect->left;
+            origin.y = op->src_rect->top  + rc.top  - op->dst_rect->top;
+        }
+
+        switch (op->type)
+        {
+        case RECT_OP_COPY:
+            op->dst->funcs->copy_rect( op->dst, &rc, op->src, &origin, op->rop2, 0 );
+            break;
+        case RECT_OP_MASK:
+            op->dst->funcs->mask_rect( op->dst, &rc, op->src, &origin, op->rop2 );
+            break;
+        case RECT_OP_BLEND:
+            op->dst->funcs->blend_rect( op->dst, &rc, op->src, &origin, op->blend );
+            break;
+        case RECT_OP_GRADIENT:
+            if (!op->dst->funcs->gradient_rect( op->dst, &rc, op->vert, op->mode ))
+                InterlockedExchange( &op->failed, TRUE );
+            break;
+        }
+    }
+}
+
+/* render the operation in parallel bands, returns FALSE if it should be done sequentially */
+static BOOL run_rect_op( struct rect_op *op, const RECT *rects, int count )
+{
+    LONGLONG pixels = 0;
+    int i, bands, bottom = rects[0].bottom;
+
+    for (i = 0; i < count; i++)
+    {
+        pixels += (LONGLONG)(rects[i].right - rects[i].left) * (rects[i].bottom - rects[i].top);
+        bottom = max( bottom, rects[i].bottom );
+    }
+    if ((bands = get_band_count( pixels, bottom - rects[0].top )) <= 1) return FALSE;
+
+    op->rects       = rects;
+    op->count       = count;
+    op->top         = rects[0].top;
+    op->band_height = (bottom - op->top + bands - 1) / bands;
+    op->failed      = FALSE;
+    bands = (bottom - op->top + op->band_height - 1) / op->band_height;
+
+    TRACE( "%d rects, %d bands of %d rows\n", count, bands, op->band_height );
+    wine_run_bands( render_rect_op_band, op, bands, render_threads );
+    return TRUE;
+}
+
 static void copy_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src, const RECT *src_rect,
                         const struct clipped_rects *clipped_rects, INT rop2 )
 {
@@ -499,6 +643,19 @@ static void copy_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src,
     }
 
     overlap = get_overlap( dst, dst_rect, src, src_rect );
+    if (!overlap)
+    {
+        struct rect_op op;
+
+        op.type     = RECT_OP_COPY;
+        op.dst      = dst;
+        op.dst_rect = dst_rect;
+        op.src      = src;
+        op.src_rect = src_rect;
+        op.rop2     = rop2;
+        if (run_rect_op( &op, rects, count )) return;
+    }
+
     if (overlap & OVERLAP_BELOW)
     {
         if (overlap & OVERLAP_RIGHT)  /* right to left, bottom to top */
@@ -557,6 +714,7 @@ static void mask_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src,
 {
     POINT origin;
     const RECT *rects;
+    struct rect_op op;
     int i, count;
 
     if (rop2 == R2_BLACK || rop2 == R2_NOT || rop2 == R2_NOP || rop2 == R2_WHITE)
@@ -573,6 +731,14 @@ static void mask_rect( dib_info *dst, const RECT *dst_rect, const dib_info *src,
         count = 1;
     }
 
+    op.type     = RECT_OP_MASK;
+    op.dst      = dst;
+    op.dst_rect = dst_rect;
+    op.src      = src;
+    op.src_rect = src_rect;
+    op.rop2     = rop2;
+    if (run_rect_op( &op, rects, count )) return;
+
     for (i = 0; i < count; i++)
     {
         origin.x = src_rect->left + rects[i].left - dst_rect->left;
@@ -586,9 +752,23 @@ static DWORD blend_rect( dib_info *dst, const RECT *dst_rect, const dib_info *sr
 {
     POINT origin;
     struct clipped_rects clipped_rects;
+    struct rect_op op;
     int i;
 
     if (!get_clipped_rects( dst, dst_rect, clip, &clipped_rects )) return ERROR_SUCCESS;
+
+    op.type     = RECT_OP_BLEND;
+    op.dst      = dst;
+    op.dst_rect = dst_rect;
+    op.src      = src;
+    op.src_rect = src_rect;
+    op.blend    = blend;
+    if (run_rect_op( &op, clipped_rects.rects, clipped_rects.count ))
+    {
+        free_clipped_rects( &clipped_rects );
+        return ERROR_SUCCESS;
+    }
+
     for (i = 0; i < clipped_rects.count; i++)
     {
         origin.x = src_rect->left + clipped_rects.rects[i].left - dst_rect->left;
@@ -682,9 +862,22 @@ static BOOL gradient_rect( dib_info *dib, TRIVERTEX *v, int mode, HRGN clip, con
 {
     int i;
     struct clipped_rects clipped_rects;
+    struct rect_op op;
     BOOL ret = TRUE;
 
     if (!get_clipped_rects( dib, bounds, clip, &clipped_rects )) return TRUE;
+
+    op.type = RECT_OP_GRADIENT;
+    op.dst  = dib;
+    op.src  = NULL;
+    op.vert = v;
+    op.mode = mode;
+    if (run_rect_op( &op, clipped_rects.rects, clipped_rects.count ))
+    {
+        free_clipped_rects( &clipped_rects );
+        return !op.failed;
+    }
+
     for (i = 0; i < clipped_rects.count; i++)
     {
         if (!(ret = dib->funcs->gradient_rect( dib, &clipped_rects.rects[i], v, mode ))) break;
@@ -1189,6 +1382,134 @@ static DWORD calc_1d_stretch_params( INT dst_start, INT dst_length, INT dst_vis_
 }
 
 
+/* state of the vertical stretch loop at the start of a band */
+struct stretch_band
+{
+    POINT        dst_start;
+    POINT        src_start;
+    int          err;
+    unsigned int length;
+};
+
+struct stretch_op
+{
+    dib_info                     *dst_dib;
+    const dib_info               *src_dib;
+    const struct stretch_params  *v_params;
+    const struct stretch_params  *h_params;
+    BOOL                          vstretch;
+    int                           mode;
+    int                           row_width;
+    void                        (*row_fn)(const dib_info *dst_dib, const POINT *dst_start,
+                                          const dib_info *src_dib, const POINT *src_start,
+                                          const struct stretch_params *params, int mode, BOOL keep_dst);
+    struct stretch_band           bands[WINE_MAX_BANDS];
+};
+
+static void render_stretch_band( void *param, unsigned int band )
+{
+    const struct stretch_op *op = param;
+    const struct stretch_params *v_params = op->v_params;
+    POINT dst_start = op->bands[band].dst_start;
+    POINT src_start = op->bands[band].src_start;
+    unsigned int length = op->bands[band].length;
+    int err = op->bands[band].err;
+
+    if (op->vstretch)
+    {
+        BOOL need_row = TRUE;
+        RECT last_row, this_row;
+        last_row.left = 0;
+        last_row.right = op->row_width;
+
+        while (length--)
+        {
+            if (need_row)
+            {
+                op->row_fn( op->dst_dib, &dst_start, op->src_dib, &src_start, op->h_params, op->mode, FALSE );
+                need_row = FALSE;
+            }
+            else
+            {
+                last_row.top = dst_start.y - v_params->dst_inc;
+                last_row.bottom = last_row.top + 1;
+                this_row = last_row;
+                offset_rect( &this_row, 0, v_params->dst_inc );
+                copy_rect( op->dst_dib, &this_row, op->dst_dib, &last_row, NULL, R2_COPYPEN );
+            }
+
+            if (err > 0)
+            {
+                src_start.y += v_params->src_inc;
+                need_row = TRUE;
+                err += v_params->err_add_1;
+            }
+            else err += v_params->err_add_2;
+            dst_start.y += v_params->dst_inc;
+        }
+    }
+    else
+    {
+        int merged_rows = 0;
+
+        while (length--)
+        {
+            if (op->mode != STRETCH_DELETESCANS || !merged_rows)
+                op->row_fn( op->dst_dib, &dst_start, op->src_dib, &src_start, op->h_params,
+                            op->mode, merged_rows != 0 );
+            merged_rows++;
+
+            if (err > 0)
+            {
+                dst_start.y += v_params->dst_inc;
+                merged_rows = 0;
+                err += v_params->err_add_1;
+            }
+            else err += v_params->err_add_2;
+            src_start.y += v_params->src_inc;
+        }
+    }
+}
+
+/* Split the vertical loop into bands.  A band may only start where a new source row
+ * is fetched (stretching) or a new destination row is started (shrinking), so that
+ * it never depends on rows rendered by the previous band. */
+static int split_stretch_bands( struct stretch_op *op, POINT dst_start, POINT src_start, int err, int count )
+{
+    const struct stretch_params *v_params = op->v_params;
+    unsigned int i, band_length = (v_params->length + count - 1) / count;
+    struct stretch_band *band = op->bands;
+    BOOL boundary = TRUE;
+
+    band->length = 0;
+    for (i = 0; i < v_params->length; i++)
+    {
+        if (boundary && band->length >= band_length && band < op->bands + WINE_MAX_BANDS - 1)
+            (++band)->length = 0;
+        if (!band->length)
+        {
+            band->dst_start = dst_start;
+            band->src_start = src_start;
+            band->err = err;
+        }
+        band->length++;
+
+        boundary = err > 0;
+        if (op->vstretch)
+        {
+            if (boundary) src_start.y += v_params->src_inc;
+            dst_start.y += v_params->dst_inc;
+        }
+        else
+        {
+            if (boundary) dst_start.y += v_params->dst_inc;
+            src_start.y += v_params->src_inc;
+        }
+        err += boundary ? v_params->err_add_1 : v_params->err_add_2;
+    }
+    return band - op->bands + 1;
+}
+
 DWORD stretch_bitmapinfo( const BITMAPINFO *src_info, void *src_bits, struct bitblt_coords *src,
                           const BITMAPINFO *dst_info, void *dst_bits, struct bitblt_coords *dst,
                           INT mode )
@@ -1198,11 +1519,9 @@ DWORD stretch_bitmapinfo( const BITMAPINFO *src_info, void *src_bits, struct bit
     RECT rect;
     BOOL hstretch, vstretch;
     struct stretch_params v_params, h_params;
-    int err;
+    struct stretch_op op;
+    int count;
     DWORD ret;
-    void (* row_fn)(const dib_info *dst_dib, const POINT *dst_start,
-                    const dib_info *src_dib, const POINT *src_start,
-                    const struct stretch_params *params, int mode, BOOL keep_dst);
 
     TRACE("dst %d, %d - %d x %d visrect %s src %d, %d - %d x %d visrect %s\n",
           dst->x, dst->y, dst->width, dst->height, wine_dbgstr_rect(&dst->visrect),
@@ -1236,64 +1555,26 @@ DWORD stretch_bitmapinfo( const BITMAPINFO *src_info, void *src_bits, struct bit
     dst_start.x -= dst->visrect.left;
     dst_start.y -= dst->visrect.top;
 
-    err = v_params.err_start;
-
-    row_fn = hstretch ? dst_dib.funcs->stretch_row : dst_dib.funcs->shrink_row;
-
-    if (vstretch)
-    {
-        BOOL need_row = TRUE;
-        RECT last_row, this_row;
-        if (hstretch) mode = STRETCH_DELETESCANS;
-        last_row.left = 0;
-        last_row.right = dst->visrect.right - dst->visrect.left;
-
-        while (v_params.length--)
-        {
-            if (need_row)
-            {
-                row_fn( &dst_dib, &dst_start, &src_dib, &src_start, &h_params, mode, FALSE );
-                need_row = FALSE;
-            }
-            else
-            {
-                last_row.top = dst_start.y - v_params.dst_inc;
-                last_row.bottom = last_row.top + 1;
-                this_row = last_row;
-                offset_rect( &this_row, 0, v_params.dst_inc );
-                copy_rect( &dst_dib, &this_row, &dst_dib, &last_row, NULL, R2_COPYPEN );
-            }
-
-            if (err > 0)
-            {
-                src_start.y += v_params.src_inc;
-                need_row = TRUE;
-                err += v_params.err_add_1;
-            }
-            else err += v_params.err_add_2;
-            dst_start.y += v_params.dst_inc;
-        }
-    }
+    op.dst_dib   = &dst_dib;
+    op.src_dib   = &src_dib;
+    op.v_params  = &v_params;
+    op.h_params  = &h_params;
+    op.vstretch  = vstretch;
+    op.mode      = (vstretch && hstretch) ? STRETCH_DELETESCANS : mode;
+    op.row_width = dst->visrect.right - dst->visrect.left;
+    op.row_fn    = hstretch ? dst_dib.funcs->stretch_row : dst_dib.funcs->shrink_row;
+
+    count = get_band_count( (LONGLONG)h_params.length * v_params.length, v_params.length );
+    if (count > 1)
+        count = split_stretch_bands( &op, dst_start, src_start, v_params.err_start, count );
     else
     {
-        int merged_rows = 0;
-
-        while (v_params.length--)
-        {
-            if (mode != STRETCH_DELETESCANS || !merged_rows)
-                row_fn( &dst_dib, &dst_start, &src_dib, &src_start, &h_params, mode, merged_rows != 0 );
-            merged_rows++;
-
-            if (err > 0)
-            {
-                dst_start.y += v_params.dst_inc;
-                merged_rows = 0;
-                err += v_params.err_add_1;
-            }
-            else err += v_params.err_add_2;
-            src_start.y += v_params.src_inc;
-        }
+        op.bands[0].dst_start = dst_start;
+        op.bands[0].src_start = src_start;
+        op.bands[0].err       = v_params.err_start;
+        op.bands[0].length    = v_params.length;
     }
+    wine_run_bands( render_stretch_band, &op, count, render_threads );
 
     /* update coordinates, the destination rectangle is always stored at 0,0 */
     *src = *dst;
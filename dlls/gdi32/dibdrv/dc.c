@@ -263,7 +263,7 @@ int get_clipped_rects( const dib_info *dib, const RECT *rc, HRGN clip, struct cl
 {
     const WINEREGION *region;
     RECT rect, *out = clip_rects->buffer;
-    int i;
+    int i, end;
 
     init_clipped_rects( clip_rects );
 
@@ -283,17 +283,23 @@ int get_clipped_rects( const dib_info *dib, const RECT *rc, HRGN clip, struct cl
 
     if (!(region = get_wine_region( clip ))) return 0;
 
-    for (i = region_find_pt( region, rect.left, rect.top, NULL ); i < region->numRects; i++)
+    /* walk the bands, only looking at the rectangles that overlap horizontally */
+    for (i = region_find_pt( region, rect.left, rect.top, NULL ); i < region->numRects; i = end)
     {
         if (region->rects[i].top >= rect.bottom) break;
-        if (!intersect_rect( out, &rect, &region->rects[i] )) continue;
-        out++;
-        if (out == &clip_rects->buffer[sizeof(clip_rects->buffer) / sizeof(RECT)])
+        end = region_band_end( region, i );
+        for (i = region_band_find_x( region, i, end, rect.left ); i < end; i++)
         {
-            clip_rects->rects = HeapAlloc( GetProcessHeap(), 0, region->numRects * sizeof(RECT) );
-            if (!clip_rects->rects) return 0;
-            memcpy( clip_rects->rects, clip_rects->buffer, (out - clip_rects->buffer) * sizeof(RECT) );
-            out = clip_rects->rects + (out - clip_rects->buffer);
+            if (region->rects[i].left >= rect.right) break;
+            if (!intersect_rect( out, &rect, &region->rects[i] )) continue;
+            out++;
+            if (out == &clip_rects->buffer[sizeof(clip_rects->buffer) / sizeof(RECT)])
+            {
+                clip_rects->rects = HeapAlloc( GetProcessHeap(), 0, region->numRects * sizeof(RECT) );
+                if (!clip_rects->rects) return 0;
+                memcpy( clip_rects->rects, clip_rects->buffer, (out - clip_rects->buffer) * sizeof(RECT) );
+                out = clip_rects->rects + (out - clip_rects->buffer);
+            }
         }
     }
     release_wine_region( clip );
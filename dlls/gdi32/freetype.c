@@ -37,6 +37,7 @@
 # include <dirent.h>
 #endif
 #include <stdio.h>
+#include <errno.h>
 #include <assert.h>
 
 #ifdef HAVE_CARBON_CARBON_H
@@ -461,8 +462,66 @@ static struct list gdi_font_list = LIST_INIT(gdi_font_list);
 static struct list unused_gdi_font_list = LIST_INIT(unused_gdi_font_list);
 static unsigned int unused_font_count;
 #define UNUSED_CACHE_SIZE 10
+#define MAX_UNUSED_CACHE_SIZE 64
+static unsigned int unused_cache_size = UNUSED_CACHE_SIZE;
+/* hashes of recently freed fonts, used to grow the unused cache when they get recreated */
+static DWORD evicted_fonts[16];
+static unsigned int evicted_font_pos, evictions_since_reuse;
 static struct list system_links = LIST_INIT(system_links);
 
+/* Process-wide cache of rendered glyph bitmaps.  Entries are keyed by the font
+ * file, face index and font description rather than by font instance, so that
+ * they stay valid when the instance that rendered them is freed. */
+
+#define GLYPH_CACHE_BUCKETS  1024
+#define GLYPH_CACHE_SIZE     4096  /* default size in kilobytes */
+#define MAX_GLYPH_CACHE_SIZE (256 * 1024)
+
+struct glyph_bitmap
+{
+    struct list  entry;      /* entry in the hash bucket */
+    struct list  lru_entry;  /* entry in the LRU list */
+    DWORD        hash;
+    dev_t        dev;
+    ino_t        ino;
+    FT_Long      face_index;
+    FONT_DESC    font_desc;
+    UINT         glyph;
+    UINT         format;
+    GLYPHMETRICS gm;
+    DWORD        size;
+    BYTE         bits[1];
+};
+
+static struct list glyph_buckets[GLYPH_CACHE_BUCKETS];
+static struct list glyph_lru = LIST_INIT(glyph_lru);
+static SIZE_T glyph_cache_size, glyph_cache_max_size = GLYPH_CACHE_SIZE * 1024;
+static unsigned int glyph_cache_hits, glyph_cache_misses, glyph_cache_evictions;
+
+static void init_glyph_cache(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < GLYPH_CACHE_BUCKETS; i++) list_init( &glyph_buckets[i] );
+}
+
+static void free_glyph_bitmap( struct glyph_bitmap *glyph )
+{
+    list_remove( &glyph->entry );
+    list_remove( &glyph->lru_entry );
+    glyph_cache_size -= glyph->size;
+    HeapFree( GetProcessHeap(), 0, glyph );
+}
+
+/* must be called when the font list changes, since font linking may then resolve glyphs differently */
+static void flush_glyph_cache(void)
+{
+    struct glyph_bitmap *glyph, *next;
+
+    LIST_FOR_EACH_ENTRY_SAFE( glyph, next, &glyph_lru, struct glyph_bitmap, lru_entry )
+        free_glyph_bitmap( glyph );
+}
+
 static struct list font_subst_list = LIST_INIT(font_subst_list);
 
 static struct list font_list = LIST_INIT(font_list);
@@ -1921,12 +1980,10 @@ static void get_family_names( FT_Face ft_face, WCHAR **name, WCHAR **english, BO
     }
 }
 
-static Family *get_family( FT_Face ft_face, BOOL vertical )
+/* takes ownership of name and english_name */
+static Family *get_family_by_name( WCHAR *name, WCHAR *english_name )
 {
     Family *family;
-    WCHAR *name, *english_name;
-
-    get_family_names( ft_face, &name, &english_name, vertical );
 
     family = find_family_from_name( name );
 
@@ -2136,14 +2193,8 @@ static Face *create_face( FT_Face ft_face, FT_Long face_index, const char *file,
     return face;
 }
 
-static void AddFaceToList(FT_Face ft_face, const char *file, void *font_data_ptr, DWORD font_data_size,
-                          FT_Long face_index, DWORD flags )
+static void add_face_to_family( Face *face, Family *family, DWORD flags )
 {
-    Face *face;
-    Family *family;
-
-    face = create_face( ft_face, face_index, file, font_data_ptr, font_data_size, flags );
-    family = get_family( ft_face, flags & ADDFONT_VERTICAL_FONT );
     if (strlenW(family->FamilyName) >= LF_FACESIZE)
     {
         WARN("Ignoring %s because name is too long\n", debugstr_w(family->FamilyName));
@@ -2164,6 +2215,572 @@ static void AddFaceToList(FT_Face ft_face, const char *file, void *font_data_ptr
     release_family( family );
 }
 
+/*
+ * Font index
+ *
+ * The font index is a binary file in the prefix that records the faces found
+ * in each font file, keyed by unix path, size and modification time.  It is
+ * mapped when the font list is built, and files that haven't changed are added
+ * straight from it without being opened by FreeType.  It is rewritten whenever
+ * a new or modified file had to be scanned.
+ */
+
+#define FONT_INDEX_MAGIC   0x58444e49  /* 'INDX' */
+#define FONT_INDEX_VERSION 1
+
+struct font_index_header
+{
+    DWORD magic;
+    DWORD version;
+    DWORD ft_version;     /* FreeType version used to build the index */
+    DWORD langid;         /* face names are localized */
+    DWORD file_count;
+    DWORD face_count;
+    DWORD strings_size;
+    DWORD reserved;
+};
+
+struct font_index_file
+{
+    DWORD     name;       /* unix file name, offset in the string pool */
+    DWORD     flags;      /* ADDFONT_ALLOW_BITMAP */
+    ULONGLONG mtime;
+    ULONGLONG size;
+    DWORD     first_face;
+    DWORD     face_count;
+};
+
+struct font_index_face
+{
+    DWORD         family;     /* offsets in the string pool, 0 if not present */
+    DWORD         english;
+    DWORD         style;
+    DWORD         full;
+    DWORD         face_index;
+    DWORD         flags;      /* ADDFONT_VERTICAL_FONT */
+    DWORD         ntm_flags;
+    LONG          font_version;
+    FONTSIGNATURE fs;
+    DWORD         scalable;
+    SHORT         height;
+    SHORT         width;
+    LONG          size;
+    LONG          x_ppem;
+    LONG          y_ppem;
+    SHORT         internal_leading;
+    SHORT         reserved;
+};
+
+struct indexed_face
+{
+    WCHAR *family;
+    WCHAR *english;
+    WCHAR *style;
+    WCHAR *full;
+    struct font_index_face data;  /* string offsets are unused */
+};
+
+struct indexed_file
+{
+    struct list          entry;
+    char                *name;
+    DWORD                flags;
+    ULONGLONG            mtime;
+    ULONGLONG            size;
+    unsigned int         face_count;
+    unsigned int         face_alloc;
+    struct indexed_face *faces;
+};
+
+static const struct font_index_header *font_index;  /* mapped index file */
+static size_t font_index_size;
+static struct list indexed_files = LIST_INIT( indexed_files );
+static unsigned int indexed_file_count;
+static BOOL font_index_recording;
+static BOOL font_index_dirty;
+
+static inline const struct font_index_file *get_index_files( const struct font_index_header *header )
+{
+    return (const struct font_index_file *)(header + 1);
+}
+
+static inline const struct font_index_face *get_index_faces( const struct font_index_header *header )
+{
+    return (const struct font_index_face *)(get_index_files( header ) + header->file_count);
+}
+
+static inline const char *get_index_strings( const struct font_index_header *header )
+{
+    return (const char *)(get_index_faces( header ) + header->face_count);
+}
+
+static inline const WCHAR *get_index_stringW( DWORD offset )
+{
+    if (!offset) return NULL;
+    return (const WCHAR *)(get_index_strings( font_index ) + offset);
+}
+
+static char *get_font_index_path( const char *suffix )
+{
+    const char *dir = wine_get_config_dir();
+    char *path;
+
+    if (!dir) return NULL;
+    path = HeapAlloc( GetProcessHeap(), 0, strlen(dir) + strlen("/fontindex.dat") + strlen(suffix) + 1 );
+    if (path)
+    {
+        strcpy( path, dir );
+        strcat( path, "/fontindex.dat" );
+        strcat( path, suffix );
+    }
+    return path;
+}
+
+static BOOL validate_font_index( const struct font_index_header *header, size_t size )
+{
+    const struct font_index_file *files;
+    const struct font_index_face *faces;
+    const char *strings;
+    DWORD i;
+
+    if (size < sizeof(*header)) return FALSE;
+    if (header->magic != FONT_INDEX_MAGIC || header->version != FONT_INDEX_VERSION) return FALSE;
+    if (header->ft_version != FT_SimpleVersion || header->langid != GetSystemDefaultLangID()) return FALSE;
+    if (header->file_count > 0x100000 || header->face_count > 0x100000) return FALSE;
+    if (header->strings_size < sizeof(WCHAR) || (header->strings_size & 1)) return FALSE;
+    if (size != sizeof(*header) + header->file_count * sizeof(*files) +
+                header->face_count * sizeof(*faces) + header->strings_size) return FALSE;
+
+    files = get_index_files( header );
+    faces = get_index_faces( header );
+    strings = get_index_strings( header );
+
+    /* make sure that all strings are terminated */
+    if (*(const WCHAR *)(strings + header->strings_size - sizeof(WCHAR))) return FALSE;
+
+    for (i = 0; i < header->file_count; i++)
+    {
+        if (!files[i].name || files[i].name >= header->strings_size) return FALSE;
+        if (files[i].first_face > header->face_count ||
+            files[i].face_count > header->face_count - files[i].first_face) return FALSE;
+        if (i && strcmp( strings + files[i - 1].name, strings + files[i].name ) > 0) return FALSE;
+    }
+    for (i = 0; i < header->face_count; i++)
+    {
+        const DWORD *offsets = &faces[i].family;
+        int j;
+
+        if (!faces[i].family || !faces[i].style) return FALSE;
+        for (j = 0; j < 4; j++)
+            if (offsets[j] >= header->strings_size || (offsets[j] & 1)) return FALSE;
+    }
+    return TRUE;
+}
+
+static void load_font_index(void)
+{
+    struct stat st;
+    char *path;
+    void *data;
+    int fd;
+
+    if (font_index) return;
+    if (!(path = get_font_index_path( "" ))) return;
+    fd = open( path, O_RDONLY );
+    HeapFree( GetProcessHeap(), 0, path );
+    if (fd == -1) return;
+
+    if (fstat( fd, &st ) == -1 || !st.st_size)
+    {
+        close( fd );
+        return;
+    }
+    data = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if (data == MAP_FAILED) return;
+
+    if (!validate_font_index( data, st.st_size ))
+    {
+        WARN( "ignoring invalid or outdated font index\n" );
+        munmap( data, st.st_size );
+        return;
+    }
+    font_index = data;
+    font_index_size = st.st_size;
+    TRACE( "loaded font index with %u files, %u faces\n", font_index->file_count, font_index->face_count );
+}
+
+static const struct font_index_file *find_index_file( const char *name, DWORD flags )
+{
+    const struct font_index_file *files = get_index_files( font_index );
+    const char *strings = get_index_strings( font_index );
+    int min = 0, max = font_index->file_count - 1, pos, res;
+
+    /* there may be several entries for the same file, with different flags */
+    while (min <= max)
+    {
+        pos = (min + max) / 2;
+        if (!(res = strcmp( strings + files[pos].name, name )))
+            res = files[pos].flags - flags;
+        if (!res) return &files[pos];
+        if (res < 0) min = pos + 1;
+        else max = pos - 1;
+    }
+    return NULL;
+}
+
+static struct indexed_file *create_indexed_file( const char *name, DWORD flags, const struct stat *st )
+{
+    struct indexed_file *indexed;
+
+    if (!(indexed = HeapAlloc( GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*indexed) ))) return NULL;
+    if (!(indexed->name = HeapAlloc( GetProcessHeap(), 0, strlen(name) + 1 )))
+    {
+        HeapFree( GetProcessHeap(), 0, indexed );
+        return NULL;
+    }
+    strcpy( indexed->name, name );
+    indexed->flags = flags & ADDFONT_ALLOW_BITMAP;
+    indexed->mtime = st->st_mtime;
+    indexed->size  = st->st_size;
+    return indexed;
+}
+
+static void free_indexed_file( struct indexed_file *indexed )
+{
+    unsigned int i;
+
+    for (i = 0; i < indexed->face_count; i++)
+    {
+        HeapFree( GetProcessHeap(), 0, indexed->faces[i].family );
+        HeapFree( GetProcessHeap(), 0, indexed->faces[i].english );
+        HeapFree( GetProcessHeap(), 0, indexed->faces[i].style );
+        HeapFree( GetProcessHeap(), 0, indexed->faces[i].full );
+    }
+    HeapFree( GetProcessHeap(), 0, indexed->faces );
+    HeapFree( GetProcessHeap(), 0, indexed->name );
+    HeapFree( GetProcessHeap(), 0, indexed );
+}
+
+/* keep the record of a file for the next index, or discard it if the file couldn't be fully scanned */
+static void finish_indexed_file( struct indexed_file *indexed, BOOL keep, BOOL scanned )
+{
+    if (!indexed) return;
+    if (!keep)
+    {
+        free_indexed_file( indexed );
+        return;
+    }
+    list_add_tail( &indexed_files, &indexed->entry );
+    indexed_file_count++;
+    if (scanned) font_index_dirty = TRUE;
+}
+
+static void record_indexed_face( struct indexed_file *indexed, const Face *face,
+                                 const WCHAR *family_name, const WCHAR *english_name )
+{
+    struct indexed_face *rec;
+
+    if (!indexed) return;
+    if (indexed->face_count == indexed->face_alloc)
+    {
+        unsigned int count = max( 4, indexed->face_alloc * 2 );
+        struct indexed_face *faces;
+
+        if (indexed->faces)
+            faces = HeapReAlloc( GetProcessHeap(), 0, indexed->faces, count * sizeof(*faces) );
+        else
+            faces = HeapAlloc( GetProcessHeap(), 0, count * sizeof(*faces) );
+        if (!faces) return;
+        indexed->faces = faces;
+        indexed->face_alloc = count;
+    }
+
+    rec = &indexed->faces[indexed->face_count++];
+    memset( rec, 0, sizeof(*rec) );
+    rec->family  = strdupW( family_name );
+    rec->english = english_name ? strdupW( english_name ) : NULL;
+    rec->style   = strdupW( face->StyleName );
+    rec->full    = face->FullName ? strdupW( face->FullName ) : NULL;
+    rec->data.face_index   = face->face_index;
+    rec->data.flags        = face->flags & ADDFONT_VERTICAL_FONT;
+    rec->data.ntm_flags    = face->ntmFlags;
+    rec->data.font_version = face->font_version;
+    rec->data.fs           = face->fs;
+    rec->data.scalable     = face->scalable;
+    rec->data.height       = face->size.height;
+    rec->data.width        = face->size.width;
+    rec->data.size         = face->size.size;
+    rec->data.x_ppem       = face->size.x_ppem;
+    rec->data.y_ppem       = face->size.y_ppem;
+    rec->data.internal_leading = face->size.internal_leading;
+}
+
+static Face *create_face_from_index( const struct font_index_face *data, const WCHAR *style, const WCHAR *full,
+                                     const char *file, const struct stat *st, DWORD flags )
+{
+    Face *face = HeapAlloc( GetProcessHeap(), 0, sizeof(*face) );
+
+    if (!face) return NULL;
+    face->refcount = 1;
+    face->StyleName = strdupW( style );
+    face->FullName = full ? strdupW( full ) : NULL;
+    face->file = towstr( CP_UNIXCP, file );
+    face->dev = st->st_dev;
+    face->ino = st->st_ino;
+    face->font_data_ptr = NULL;
+    face->font_data_size = 0;
+    face->face_index = data->face_index;
+    face->fs = data->fs;
+    face->ntmFlags = data->ntm_flags;
+    face->font_version = data->font_version;
+    face->scalable = data->scalable;
+    face->size.height = data->height;
+    face->size.width = data->width;
+    face->size.size = data->size;
+    face->size.x_ppem = data->x_ppem;
+    face->size.y_ppem = data->y_ppem;
+    face->size.internal_leading = data->internal_leading;
+
+    flags |= data->flags & ADDFONT_VERTICAL_FONT;
+    if (!HIWORD( flags )) flags |= ADDFONT_AA_FLAGS( default_aa_flags );
+    face->flags  = flags;
+    face->family = NULL;
+    face->cached_enum_data = NULL;
+    return face;
+}
+
+/* add the faces of an unmodified file from the index; returns -1 if the file needs to be scanned */
+static INT add_font_from_index( const char *file, DWORD flags )
+{
+    const struct font_index_file *entry;
+    const struct font_index_face *data;
+    struct indexed_file *indexed = NULL;
+    struct stat st;
+    Face **faces;
+    DWORD i;
+
+    if (!font_index || stat( file, &st ) == -1) return -1;
+    if (!(entry = find_index_file( file, flags & ADDFONT_ALLOW_BITMAP ))) return -1;
+    if (entry->mtime != (ULONGLONG)st.st_mtime || entry->size != (ULONGLONG)st.st_size) return -1;
+
+    TRACE( "adding %u faces of %s from the font index\n", entry->face_count, debugstr_a(file) );
+
+    /* create all the faces first, so that the file can still be scanned if we run out of memory */
+    if (!(faces = HeapAlloc( GetProcessHeap(), 0, entry->face_count * sizeof(*faces) ))) return -1;
+    data = get_index_faces( font_index ) + entry->first_face;
+    for (i = 0; i < entry->face_count; i++)
+    {
+        if ((faces[i] = create_face_from_index( data + i, get_index_stringW( data[i].style ),
+                                                get_index_stringW( data[i].full ), file, &st, flags )))
+            continue;
+        while (i) release_face( faces[--i] );
+        HeapFree( GetProcessHeap(), 0, faces );
+        return -1;
+    }
+
+    if (font_index_recording) indexed = create_indexed_file( file, flags, &st );
+
+    for (i = 0; i < entry->face_count; i++)
+    {
+        const WCHAR *family_name = get_index_stringW( data[i].family );
+        const WCHAR *english_name = get_index_stringW( data[i].english );
+        Family *family;
+
+        record_indexed_face( indexed, faces[i], family_name, english_name );
+        family = get_family_by_name( strdupW( family_name ), english_name ? strdupW( english_name ) : NULL );
+        add_face_to_family( faces[i], family, flags );
+    }
+    finish_indexed_file( indexed, TRUE, FALSE );
+    HeapFree( GetProcessHeap(), 0, faces );
+    return entry->face_count;
+}
+
+struct string_pool
+{
+    char *data;
+    DWORD size;
+    DWORD alloc;
+};
+
+static DWORD add_pool_string( struct string_pool *pool, const void *str, DWORD len )
+{
+    DWORD offset;
+
+    if (!str) return 0;
+    offset = (pool->size + 1) & ~1;
+    if (offset + len + sizeof(WCHAR) > pool->alloc)
+    {
+        DWORD alloc = max( pool->alloc * 2, offset + len + sizeof(WCHAR) );
+        char *data = HeapReAlloc( GetProcessHeap(), HEAP_ZERO_MEMORY, pool->data, alloc );
+
+        if (!data) return 0;
+        pool->data = data;
+        pool->alloc = alloc;
+    }
+    memcpy( pool->data + offset, str, len );
+    pool->size = offset + len;
+    return offset;
+}
+
+static int compare_indexed_files( const void *p1, const void *p2 )
+{
+    const struct indexed_file *file1 = *(const struct indexed_file * const *)p1;
+    const struct indexed_file *file2 = *(const struct indexed_file * const *)p2;
+    int res = strcmp( file1->name, file2->name );
+
+    if (!res) res = file1->flags - file2->flags;
+    return res;
+}
+
+static BOOL write_index_data( int fd, const void *data, size_t size )
+{
+    const char *ptr = data;
+
+    while (size)
+    {
+        ssize_t ret = write( fd, ptr, size );
+        if (ret < 0)
+        {
+            if (errno == EINTR) continue;
+            return FALSE;
+        }
+        ptr += ret;
+        size -= ret;
+    }
+    return TRUE;
+}
+
+static void write_font_index( struct indexed_file **sorted, unsigned int file_count )
+{
+    static const WCHAR nullW = 0;
+    struct font_index_header header;
+    struct font_index_file *files = NULL;
+    struct font_index_face *faces = NULL;
+    struct indexed_file *indexed;
+    struct string_pool pool;
+    unsigned int i, j, face_count = 0;
+    char *path = NULL, *tmp_path = NULL;
+    BOOL ret = FALSE;
+    int fd;
+
+    for (i = 0; i < file_count; i++) face_count += sorted[i]->face_count;
+
+    pool.size = pool.alloc = sizeof(WCHAR);  /* offset 0 means no string */
+    pool.data = HeapAlloc( GetProcessHeap(), HEAP_ZERO_MEMORY, pool.alloc );
+    files = HeapAlloc( GetProcessHeap(), 0, max( file_count, 1 ) * sizeof(*files) );
+    faces = HeapAlloc( GetProcessHeap(), HEAP_ZERO_MEMORY, max( face_count, 1 ) * sizeof(*faces) );
+    if (!pool.data || !files || !faces) goto done;
+
+    face_count = 0;
+    for (i = 0; i < file_count; i++)
+    {
+        indexed = sorted[i];
+        files[i].name = add_pool_string( &pool, indexed->name, strlen(indexed->name) + 1 );
+        files[i].flags = indexed->flags;
+        files[i].mtime = indexed->mtime;
+        files[i].size = indexed->size;
+        files[i].first_face = face_count;
+        files[i].face_count = indexed->face_count;
+        if (!files[i].name) goto done;
+
+        for (j = 0; j < indexed->face_count; j++)
+        {
+            struct indexed_face *rec = &indexed->faces[j];
+            struct font_index_face *face = &faces[face_count++];
+
+            *face = rec->data;
+            face->family  = add_pool_string( &pool, rec->family, (strlenW(rec->family) + 1) * sizeof(WCHAR) );
+            face->style   = add_pool_string( &pool, rec->style, (strlenW(rec->style) + 1) * sizeof(WCHAR) );
+            if (rec->english)
+                face->english = add_pool_string( &pool, rec->english, (strlenW(rec->english) + 1) * sizeof(WCHAR) );
+            if (rec->full)
+                face->full = add_pool_string( &pool, rec->full, (strlenW(rec->full) + 1) * sizeof(WCHAR) );
+            if (!face->family || !face->style) goto done;
+        }
+    }
+    /* terminate the pool so that any string offset is guaranteed to be null-terminated */
+    if (!add_pool_string( &pool, &nullW, sizeof(nullW) )) goto done;
+
+    header.magic        = FONT_INDEX_MAGIC;
+    header.version      = FONT_INDEX_VERSION;
+    header.ft_version   = FT_SimpleVersion;
+    header.langid       = GetSystemDefaultLangID();
+    header.file_count   = file_count;
+    header.face_count   = face_count;
+    header.strings_size = pool.size;
+    header.reserved     = 0;
+
+    if (!(path = get_font_index_path( "" )) || !(tmp_path = get_font_index_path( ".tmp" ))) goto done;
+    if ((fd = open( tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0666 )) == -1)
+    {
+        WARN( "cannot create %s\n", debugstr_a(tmp_path) );
+        goto done;
+    }
+    ret = write_index_data( fd, &header, sizeof(header) ) &&
+          write_index_data( fd, files, file_count * sizeof(*files) ) &&
+          write_index_data( fd, faces, face_count * sizeof(*faces) ) &&
+          write_index_data( fd, pool.data, pool.size );
+    close( fd );
+    if (ret && rename( tmp_path, path ) == -1) ret = FALSE;
+    if (!ret) unlink( tmp_path );
+    else TRACE( "wrote font index with %u files, %u faces\n", file_count, face_count );
+
+done:
+    HeapFree( GetProcessHeap(), 0, path );
+    HeapFree( GetProcessHeap(), 0, tmp_path );
+    HeapFree( GetProcessHeap(), 0, pool.data );
+    HeapFree( GetProcessHeap(), 0, files );
+    HeapFree( GetProcessHeap(), 0, faces );
+}
+
+/* stop recording, and update the index if fonts were added, modified or removed */
+static void update_font_index(void)
+{
+    struct indexed_file **sorted, *indexed, *next;
+    unsigned int i, count = 0;
+
+    if (!font_index_recording) return;
+    font_index_recording = FALSE;
+
+    if ((sorted = HeapAlloc( GetProcessHeap(), 0, max( indexed_file_count, 1 ) * sizeof(*sorted) )))
+    {
+        LIST_FOR_EACH_ENTRY( indexed, &indexed_files, struct indexed_file, entry )
+            sorted[count++] = indexed;
+        qsort( sorted, count, sizeof(*sorted), compare_indexed_files );
+
+        /* the same file may be found in several font directories */
+        for (i = count = 0; i < indexed_file_count; i++)
+            if (!count || compare_indexed_files( &sorted[count - 1], &sorted[i] )) sorted[count++] = sorted[i];
+
+        if (font_index_dirty || !font_index || font_index->file_count != count)
+            write_font_index( sorted, count );
+        HeapFree( GetProcessHeap(), 0, sorted );
+    }
+
+    LIST_FOR_EACH_ENTRY_SAFE( indexed, next, &indexed_files, struct indexed_file, entry )
+    {
+        list_remove( &indexed->entry );
+        free_indexed_file( indexed );
+    }
+    indexed_file_count = 0;
+    font_index_dirty = FALSE;
+}
+
+static void AddFaceToList(FT_Face ft_face, const char *file, void *font_data_ptr, DWORD font_data_size,
+                          FT_Long face_index, DWORD flags, struct indexed_file *indexed )
+{
+    Face *face;
+    Family *family;
+    WCHAR *name, *english_name;
+
+    face = create_face( ft_face, face_index, file, font_data_ptr, font_data_size, flags );
+    get_family_names( ft_face, &name, &english_name, flags & ADDFONT_VERTICAL_FONT );
+    record_indexed_face( indexed, face, name, english_name );
+    family = get_family_by_name( name, english_name );
+    add_face_to_family( face, family, flags );
+}
+
 static FT_Face new_ft_face( const char *file, void *font_data_ptr, DWORD font_data_size,
                             FT_Long face_index, BOOL allow_bitmap )
 {
@@ -2244,6 +2861,7 @@ static INT AddFontToList(const char *file, void *font_data_ptr, DWORD font_data_
 {
     FT_Face ft_face;
     FT_Long face_index = 0, num_faces;
+    struct indexed_file *indexed = NULL;
     INT ret = 0;
 
     /* we always load external fonts from files - otherwise we would get a crash in update_reg_entries */
@@ -2270,34 +2888,50 @@ static INT AddFontToList(const char *file, void *font_data_ptr, DWORD font_data_
     }
 #endif /* HAVE_CARBON_CARBON_H */
 
+    if (file)
+    {
+        struct stat st;
+
+        if ((ret = add_font_from_index( file, flags )) >= 0) return ret;
+        ret = 0;
+        if (font_index_recording && !stat( file, &st ))
+            indexed = create_indexed_file( file, flags, &st );
+    }
+
     do {
         const DWORD FS_DBCS_MASK = FS_JISJAPAN|FS_CHINESESIMP|FS_WANSUNG|FS_CHINESETRAD|FS_JOHAB;
         FONTSIGNATURE fs;
 
         ft_face = new_ft_face( file, font_data_ptr, font_data_size, face_index, flags & ADDFONT_ALLOW_BITMAP );
-        if (!ft_face) return 0;
+        if (!ft_face)
+        {
+            finish_indexed_file( indexed, !face_index, TRUE );
+            return 0;
+        }
 
         if(ft_face->family_name[0] == '.') /* Ignore fonts with names beginning with a dot */
         {
             TRACE("Ignoring %s since its family name begins with a dot\n", debugstr_a(file));
             pFT_Done_Face(ft_face);
+            finish_indexed_file( indexed, !face_index, TRUE );
             return 0;
         }
 
-        AddFaceToList(ft_face, file, font_data_ptr, font_data_size, face_index, flags);
+        AddFaceToList(ft_face, file, font_data_ptr, font_data_size, face_index, flags, indexed);
         ++ret;
 
         get_fontsig(ft_face, &fs);
         if (fs.fsCsb[0] & FS_DBCS_MASK)
         {
             AddFaceToList(ft_face, file, font_data_ptr, font_data_size, face_index,
-                          flags | ADDFONT_VERTICAL_FONT);
+                          flags | ADDFONT_VERTICAL_FONT, indexed);
             ++ret;
         }
 
 	num_faces = ft_face->num_faces;
 	pFT_Done_Face(ft_face);
     } while(num_faces > ++face_index);
+    finish_indexed_file( indexed, TRUE, TRUE );
     return ret;
 }
 
@@ -3288,6 +3922,7 @@ INT WineEngAddFontResourceEx(LPCWSTR file, DWORD flags, PVOID pdv)
             }
         }
 
+        if (ret) flush_glyph_cache();
         LeaveCriticalSection( &freetype_cs );
     }
     return ret;
@@ -3311,6 +3946,7 @@ HANDLE WineEngAddFontMemResourceEx(PVOID pbFont, DWORD cbFont, PVOID pdv, DWORD
 
         EnterCriticalSection( &freetype_cs );
         *pcFonts = AddFontToList(NULL, pFontCopy, cbFont, ADDFONT_ALLOW_BITMAP | ADDFONT_ADD_RESOURCE);
+        if (*pcFonts) flush_glyph_cache();
         LeaveCriticalSection( &freetype_cs );
 
         if (*pcFonts == 0)
@@ -3369,6 +4005,7 @@ BOOL WineEngRemoveFontResourceEx(LPCWSTR file, DWORD flags, PVOID pdv)
             }
         }
 
+        if (ret) flush_glyph_cache();
         LeaveCriticalSection( &freetype_cs );
     }
     return ret;
@@ -4373,6 +5010,7 @@ static DWORD WINAPI freetype_lazy_init(RTL_RUN_ONCE *once, void *param, void **c
         static const WCHAR antialias_fake_bold_or_italic[] = { 'A','n','t','i','a','l','i','a','s','F','a','k','e',
                                                                'B','o','l','d','O','r','I','t','a','l','i','c',0 };
         static const WCHAR true_options[] = { 'y','Y','t','T','1',0 };
+        static const WCHAR glyph_cache_sizeW[] = { 'G','l','y','p','h','C','a','c','h','e','S','i','z','e',0 };
         DWORD type, size;
         WCHAR buffer[20];
 
@@ -4382,8 +5020,19 @@ static DWORD WINAPI freetype_lazy_init(RTL_RUN_ONCE *once, void *param, void **c
         {
             antialias_fakes = (strchrW(true_options, buffer[0]) != NULL);
         }
+        /* @@ Wine registry key: HKCU\Software\Wine\Fonts\GlyphCacheSize, in kilobytes, 0 disables it */
+        size = sizeof(buffer);
+        if (!RegQueryValueExW(hkey, glyph_cache_sizeW, NULL, &type, (BYTE*)buffer, &size) &&
+            (type == REG_DWORD || type == REG_SZ))
+        {
+            unsigned long kb = (type == REG_DWORD) ? *(DWORD *)buffer : strtoulW(buffer, NULL, 10);
+
+            glyph_cache_max_size = (SIZE_T)min( kb, MAX_GLYPH_CACHE_SIZE ) * 1024;
+            TRACE("glyph cache size %lu\n", glyph_cache_max_size);
+        }
         RegCloseKey(hkey);
     }
+    init_glyph_cache();
 
     if((font_mutex = CreateMutexW(NULL, FALSE, font_mutex_nameW)) == NULL)
     {
@@ -4395,7 +5044,12 @@ static DWORD WINAPI freetype_lazy_init(RTL_RUN_ONCE *once, void *param, void **c
     create_font_cache_key(&hkey_font_cache, &disposition);
 
     if(disposition == REG_CREATED_NEW_KEY)
+    {
+        load_font_index();
+        font_index_recording = TRUE;
         init_font_list();
+        update_font_index();
+    }
     else
         load_font_list_from_cache(hkey_font_cache);
 
@@ -4934,10 +5588,17 @@ static void release_font( GdiFont *font )
 
         /* add it to the unused list */
         list_add_head( &unused_gdi_font_list, &font->unused_entry );
-        if (unused_font_count > UNUSED_CACHE_SIZE)
+        if (unused_font_count > unused_cache_size)
         {
             font = LIST_ENTRY( list_tail( &unused_gdi_font_list ), struct tagGdiFont, unused_entry );
             TRACE( "freeing %p\n", font );
+            evicted_fonts[evicted_font_pos++ % (sizeof(evicted_fonts) / sizeof(evicted_fonts[0]))] = font->font_desc.hash;
+            /* shrink the cache back slowly if evicted fonts are not needed again */
+            if (++evictions_since_reuse >= 4 * unused_cache_size && unused_cache_size > UNUSED_CACHE_SIZE)
+            {
+                unused_cache_size--;
+                evictions_since_reuse = 0;
+            }
             list_remove( &font->entry );
             list_remove( &font->unused_entry );
             free_font( font );
@@ -4985,6 +5646,7 @@ static GdiFont *find_in_cache(HFONT hfont, const LOGFONTW *plf, const FMAT2 *pma
 {
     GdiFont *ret;
     FONT_DESC fd;
+    unsigned int i;
 
     fd.lf = *plf;
     fd.matrix = *pmat;
@@ -5001,6 +5663,20 @@ static GdiFont *find_in_cache(HFONT hfont, const LOGFONTW *plf, const FMAT2 *pma
         grab_font( ret );
         return ret;
     }
+
+    /* grow the unused cache if a font that was freed recently is needed again */
+    for (i = 0; i < sizeof(evicted_fonts) / sizeof(evicted_fonts[0]); i++)
+    {
+        if (evicted_fonts[i] != fd.hash) continue;
+        evicted_fonts[i] = 0;
+        evictions_since_reuse = 0;
+        if (unused_cache_size < MAX_UNUSED_CACHE_SIZE)
+        {
+            unused_cache_size++;
+            TRACE( "unused font cache size now %u\n", unused_cache_size );
+        }
+        break;
+    }
     return NULL;
 }
 
@@ -7999,6 +8675,138 @@ end:
     return ret;
 }
 
+static BOOL is_bitmap_format( UINT format )
+{
+    switch (format)
+    {
+    case GGO_BITMAP:
+    case GGO_GRAY2_BITMAP:
+    case GGO_GRAY4_BITMAP:
+    case GGO_GRAY8_BITMAP:
+    case WINE_GGO_GRAY16_BITMAP:
+    case WINE_GGO_HRGB_BITMAP:
+    case WINE_GGO_HBGR_BITMAP:
+    case WINE_GGO_VRGB_BITMAP:
+    case WINE_GGO_VBGR_BITMAP:
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static DWORD glyph_bitmap_hash( const GdiFont *font, UINT glyph, UINT format )
+{
+    DWORD hash = font->font_desc.hash ^ font->mapping->ino ^ font->ft_face->face_index;
+
+    hash ^= glyph * 0x9e3779b1 ^ format << 24;
+    return hash ^ (hash >> 16);
+}
+
+static struct glyph_bitmap *find_glyph_bitmap( const GdiFont *font, UINT glyph, UINT format, DWORD hash )
+{
+    struct glyph_bitmap *entry;
+
+    LIST_FOR_EACH_ENTRY( entry, &glyph_buckets[hash % GLYPH_CACHE_BUCKETS], struct glyph_bitmap, entry )
+    {
+        if (entry->hash != hash || entry->glyph != glyph || entry->format != format) continue;
+        if (entry->dev != font->mapping->dev || entry->ino != font->mapping->ino) continue;
+        if (entry->face_index != font->ft_face->face_index) continue;
+        if (fontcmp( font, &entry->font_desc )) continue;
+        list_remove( &entry->lru_entry );
+        list_add_head( &glyph_lru, &entry->lru_entry );
+        return entry;
+    }
+    return NULL;
+}
+
+/* large bitmaps would evict too much of the cache */
+static inline BOOL is_cacheable_glyph_bitmap( DWORD size )
+{
+    return size != GDI_ERROR && size <= glyph_cache_max_size / 16;
+}
+
+static struct glyph_bitmap *alloc_glyph_bitmap( DWORD size )
+{
+    return HeapAlloc( GetProcessHeap(), 0, FIELD_OFFSET( struct glyph_bitmap, bits[size] ));
+}
+
+static void add_glyph_bitmap( const GdiFont *font, struct glyph_bitmap *entry, UINT glyph, UINT format,
+                              const GLYPHMETRICS *gm, DWORD size, DWORD hash )
+{
+    entry->hash       = hash;
+    entry->dev        = font->mapping->dev;
+    entry->ino        = font->mapping->ino;
+    entry->face_index = font->ft_face->face_index;
+    entry->font_desc  = font->font_desc;
+    entry->glyph      = glyph;
+    entry->format     = format;
+    entry->gm         = *gm;
+    entry->size       = size;
+    list_add_head( &glyph_buckets[hash % GLYPH_CACHE_BUCKETS], &entry->entry );
+    list_add_head( &glyph_lru, &entry->lru_entry );
+    glyph_cache_size += size;
+
+    while (glyph_cache_size > glyph_cache_max_size)
+    {
+        free_glyph_bitmap( LIST_ENTRY( list_tail( &glyph_lru ), struct glyph_bitmap, lru_entry ));
+        glyph_cache_evictions++;
+    }
+}
+
+/* retrieve a glyph bitmap through the cache, returns FALSE if the glyph can't be cached */
+static BOOL get_cached_glyph_bitmap( GdiFont *font, UINT glyph, UINT format, GLYPHMETRICS *gm,
+                                     DWORD buflen, void *buf, const MAT2 *mat, DWORD *ret )
+{
+    struct glyph_bitmap *entry;
+    ABC abc;
+    DWORD hash;
+
+    if (!glyph_cache_max_size || !font->mapping) return FALSE;
+    if (!is_bitmap_format( format & ~(GGO_GLYPH_INDEX | GGO_UNHINTED) ) || !is_identity_MAT2( mat ))
+        return FALSE;
+
+    hash = glyph_bitmap_hash( font, glyph, format );
+    if (!(entry = find_glyph_bitmap( font, glyph, format, hash )))
+    {
+        glyph_cache_misses++;
+        if (buf && buflen)
+        {
+            /* render into the caller's buffer and keep a copy */
+            *ret = get_glyph_outline( font, glyph, format, gm, &abc, buflen, buf, mat );
+            if (is_cacheable_glyph_bitmap( *ret ) && (entry = alloc_glyph_bitmap( *ret )))
+            {
+                memcpy( entry->bits, buf, *ret );
+                add_glyph_bitmap( font, entry, glyph, format, gm, *ret, hash );
+            }
+            return TRUE;
+        }
+
+        /* the bits are usually requested next, render them into the cache right away */
+        *ret = get_glyph_outline( font, glyph, format, gm, &abc, 0, NULL, mat );
+        if (!is_cacheable_glyph_bitmap( *ret ) || !(entry = alloc_glyph_bitmap( *ret ))) return TRUE;
+        if (*ret && get_glyph_outline( font, glyph, format, gm, &abc, *ret, entry->bits, mat ) == GDI_ERROR)
+        {
+            HeapFree( GetProcessHeap(), 0, entry );
+            return TRUE;
+        }
+        add_glyph_bitmap( font, entry, glyph, format, gm, *ret, hash );
+        return TRUE;
+    }
+
+    if (!(++glyph_cache_hits % 4096))
+        TRACE( "%u hits, %u misses, %u evictions, %lu bytes\n", glyph_cache_hits, glyph_cache_misses,
+               glyph_cache_evictions, glyph_cache_size );
+
+    *gm = entry->gm;
+    if (!buf || !buflen) *ret = entry->size;
+    else if (!entry->size || entry->size > buflen) *ret = GDI_ERROR;
+    else
+    {
+        memcpy( buf, entry->bits, entry->size );
+        *ret = entry->size;
+    }
+    return TRUE;
+}
+
 /*************************************************************
  * freetype_GetGlyphOutline
  */
@@ -8017,7 +8825,8 @@ static DWORD freetype_GetGlyphOutline( PHYSDEV dev, UINT glyph, UINT format,
 
     GDI_CheckNotLock();
     EnterCriticalSection( &freetype_cs );
-    ret = get_glyph_outline( physdev->font, glyph, format, lpgm, &abc, buflen, buf, lpmat );
+    if (!get_cached_glyph_bitmap( physdev->font, glyph, format, lpgm, buflen, buf, lpmat, &ret ))
+        ret = get_glyph_outline( physdev->font, glyph, format, lpgm, &abc, buflen, buf, lpmat );
     LeaveCriticalSection( &freetype_cs );
     return ret;
 }
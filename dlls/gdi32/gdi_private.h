@@ -408,6 +408,46 @@ static inline int region_find_pt( const WINEREGION *rgn, int x, int y, BOOL *hit
     return h ? i : start;
 }
 
+/**********************************************************
+ *     region_band_end
+ *
+ * Return the index of the first rectangle of the band following the one
+ * that contains rectangle 'start'.
+ */
+static inline int region_band_end( const WINEREGION *rgn, int start )
+{
+    int i, top = rgn->rects[start].top, end = rgn->numRects - 1;
+
+    start++;
+    while (start <= end)
+    {
+        i = (start + end) / 2;
+        if (rgn->rects[i].top == top) start = i + 1;
+        else end = i - 1;
+    }
+    return start;
+}
+
+/**********************************************************
+ *     region_band_find_x
+ *
+ * Return the index of the first rectangle in the band [start,end) whose
+ * right edge is beyond x, or end if there is none.
+ */
+static inline int region_band_find_x( const WINEREGION *rgn, int start, int end, int x )
+{
+    int i;
+
+    end--;
+    while (start <= end)
+    {
+        i = (start + end) / 2;
+        if (rgn->rects[i].right <= x) start = i + 1;
+        else end = i - 1;
+    }
+    return start;
+}
+
 /* null driver entry points */
 extern BOOL nulldrv_AbortPath( PHYSDEV dev ) DECLSPEC_HIDDEN;
 extern BOOL nulldrv_AlphaBlend( PHYSDEV dst_dev, struct bitblt_coords *dst,
@@ -1102,7 +1102,7 @@ BOOL WINAPI RectInRegion( HRGN hrgn, const RECT *rect )
     WINEREGION *obj;
     BOOL ret = FALSE;
     RECT rc;
-    int i;
+    int i, end;
 
     /* swap the coordinates to make right >= left and bottom >= top */
     /* (region building rectangles are normalized the same way) */
@@ -1113,21 +1113,16 @@ BOOL WINAPI RectInRegion( HRGN hrgn, const RECT *rect )
     {
 	if ((obj->numRects > 0) && overlapping(&obj->extents, &rc))
 	{
-	    for (i = region_find_pt( obj, rc.left, rc.top, &ret ); !ret && i < obj->numRects; i++ )
+	    for (i = region_find_pt( obj, rc.left, rc.top, &ret ); !ret && i < obj->numRects; i = end )
 	    {
-	        if (obj->rects[i].bottom <= rc.top)
-		    continue;             /* not far enough down yet */
-
 		if (obj->rects[i].top >= rc.bottom)
 		    break;                /* too far down */
 
-		if (obj->rects[i].right <= rc.left)
-		    continue;              /* not far enough over yet */
-
-		if (obj->rects[i].left >= rc.right)
-		    continue;
-
-		ret = TRUE;
+		/* first rectangle of the band that is far enough over */
+		end = region_band_end( obj, i );
+		i = region_band_find_x( obj, i, end, rc.left );
+		if (i < end && obj->rects[i].left < rc.right)
+		    ret = TRUE;
 	    }
 	}
 	GDI_ReleaseObj(hrgn);
@@ -2072,6 +2067,47 @@ static BOOL REGION_UnionO (WINEREGION *pReg, RECT *r1, RECT *r1End,
 #undef MERGERECT
 }
 
+/***********************************************************************
+ *	     REGION_AppendRegion
+ *
+ *      Union of two regions where all of 'upper' is above 'lower'. The
+ *      bands of the lower region are appended, and the two bands at the
+ *      junction are coalesced if possible.
+ */
+static BOOL REGION_AppendRegion(WINEREGION *newReg, WINEREGION *upper, WINEREGION *lower)
+{
+    WINEREGION tmp;
+    RECT extents;
+    INT prevBand, curBand = upper->numRects, total = upper->numRects + lower->numRects;
+
+    extents.left = min(upper->extents.left, lower->extents.left);
+    extents.top = upper->extents.top;
+    extents.right = max(upper->extents.right, lower->extents.right);
+    extents.bottom = lower->extents.bottom;
+
+    if (newReg == upper)
+    {
+        /* common case of adding rectangles from top to bottom */
+        if (!grow_region( newReg, total )) return FALSE;
+        memcpy( newReg->rects + curBand, lower->rects, lower->numRects * sizeof(RECT) );
+        newReg->numRects = total;
+    }
+    else
+    {
+        if (!init_region( &tmp, total )) return FALSE;
+        memcpy( tmp.rects, upper->rects, curBand * sizeof(RECT) );
+        memcpy( tmp.rects + curBand, lower->rects, lower->numRects * sizeof(RECT) );
+        tmp.numRects = total;
+        move_rects( newReg, &tmp );
+    }
+
+    for (prevBand = curBand - 1; prevBand > 0; prevBand--)
+        if (newReg->rects[prevBand - 1].top != newReg->rects[prevBand].top) break;
+    REGION_Coalesce( newReg, prevBand, curBand );
+    newReg->extents = extents;
+    return TRUE;
+}
+
 /***********************************************************************
  *	     REGION_UnionRegion
  */
@@ -2129,6 +2165,14 @@ static BOOL REGION_UnionRegion(WINEREGION *newReg, WINEREGION *reg1, WINEREGION
 	return ret;
     }
 
+    /*
+     * Regions don't overlap vertically, the bands can simply be appended
+     */
+    if (reg1->extents.bottom <= reg2->extents.top)
+        return REGION_AppendRegion( newReg, reg1, reg2 );
+    if (reg2->extents.bottom <= reg1->extents.top)
+        return REGION_AppendRegion( newReg, reg2, reg1 );
+
     if ((ret = REGION_RegionOp (newReg, reg1, reg2, REGION_UnionO, REGION_UnionNonO, REGION_UnionNonO)))
     {
         newReg->extents.left = min(reg1->extents.left, reg2->extents.left);
@@ -534,6 +534,108 @@ static void test_window_dc_clipping(void)
 }
 
 
+static void test_complex_region(void)
+{
+    static const int cells = 16, cell_size = 4;
+    char bmibuf[FIELD_OFFSET( BITMAPINFO, bmiColors[256] )];
+    BITMAPINFO *bmi = (BITMAPINFO *)bmibuf;
+    HRGN hrgn, tmp;
+    HBITMAP bitmap, old_bitmap;
+    DWORD *bits, size;
+    RGNDATA *data;
+    RECT rc;
+    HDC hdc;
+    int x, y, ret;
+    BOOL inside;
+
+    /* checkerboard built from top to bottom */
+    hrgn = CreateRectRgn( 0, 0, 0, 0 );
+    for (y = 0; y < cells; y++)
+        for (x = (y & 1); x < cells; x += 2)
+        {
+            tmp = CreateRectRgn( x * cell_size, y * cell_size, (x + 1) * cell_size, (y + 1) * cell_size );
+            ret = CombineRgn( hrgn, hrgn, tmp, RGN_OR );
+            ok( ret == (x || y ? COMPLEXREGION : SIMPLEREGION), "%d,%d: CombineRgn returned %d\n", x, y, ret );
+            DeleteObject( tmp );
+        }
+
+    size = GetRegionData( hrgn, 0, NULL );
+    data = HeapAlloc( GetProcessHeap(), 0, size );
+    ret = GetRegionData( hrgn, size, data );
+    ok( ret == size, "GetRegionData returned %d\n", ret );
+    ok( data->rdh.nCount == cells * cells / 2, "got %u rects\n", data->rdh.nCount );
+    SetRect( &rc, 0, 0, cells * cell_size, cells * cell_size );
+    ok( EqualRect( &data->rdh.rcBound, &rc ), "got bounds %s\n", wine_dbgstr_rect( &data->rdh.rcBound ) );
+    HeapFree( GetProcessHeap(), 0, data );
+
+    for (y = 0; y < cells; y++)
+        for (x = 0; x < cells; x++)
+        {
+            inside = !((x ^ y) & 1);
+            ret = PtInRegion( hrgn, x * cell_size + 1, y * cell_size + 2 );
+            ok( ret == inside, "%d,%d: PtInRegion returned %d\n", x, y, ret );
+
+            SetRect( &rc, x * cell_size + 1, y * cell_size + 1, (x + 1) * cell_size - 1, (y + 1) * cell_size - 1 );
+            ret = RectInRegion( hrgn, &rc );
+            ok( ret == inside, "%d,%d: RectInRegion returned %d\n", x, y, ret );
+        }
+
+    /* rectangles spanning several cells always intersect */
+    SetRect( &rc, cell_size + 1, 1, 3 * cell_size - 1, 2 );
+    ok( RectInRegion( hrgn, &rc ), "RectInRegion failed\n" );
+    SetRect( &rc, cell_size + 1, 1, cell_size + 2, 2 * cell_size );
+    ok( RectInRegion( hrgn, &rc ), "RectInRegion failed\n" );
+    SetRect( &rc, cells * cell_size, 0, cells * cell_size + 10, cells * cell_size );
+    ok( !RectInRegion( hrgn, &rc ), "RectInRegion succeeded\n" );
+
+    /* draw through the region as a clip region */
+    memset( bmi, 0, sizeof(bmi->bmiHeader) );
+    bmi->bmiHeader.biSize        = sizeof(bmi->bmiHeader);
+    bmi->bmiHeader.biWidth       = cells * cell_size;
+    bmi->bmiHeader.biHeight      = -cells * cell_size;
+    bmi->bmiHeader.biPlanes      = 1;
+    bmi->bmiHeader.biBitCount    = 32;
+    bmi->bmiHeader.biCompression = BI_RGB;
+    hdc = CreateCompatibleDC( 0 );
+    bitmap = CreateDIBSection( hdc, bmi, DIB_RGB_COLORS, (void **)&bits, NULL, 0 );
+    ok( bitmap != NULL, "CreateDIBSection failed\n" );
+    old_bitmap = SelectObject( hdc, bitmap );
+    memset( bits, 0, cells * cell_size * cells * cell_size * sizeof(DWORD) );
+
+    SelectClipRgn( hdc, hrgn );
+    PatBlt( hdc, 2, 2, cells * cell_size - 4, cells * cell_size - 4, WHITENESS );
+    GdiFlush();
+
+    for (y = 0; y < cells * cell_size; y++)
+        for (x = 0; x < cells * cell_size; x++)
+        {
+            inside = !(((x / cell_size) ^ (y / cell_size)) & 1) &&
+                     x >= 2 && y >= 2 && x < cells * cell_size - 2 && y < cells * cell_size - 2;
+            if ((bits[y * cells * cell_size + x] != 0) == inside) continue;
+            ok( 0, "%d,%d: got %08x\n", x, y, bits[y * cells * cell_size + x] );
+            y = cells * cell_size;
+            break;
+        }
+
+    SelectObject( hdc, old_bitmap );
+    DeleteObject( bitmap );
+    DeleteDC( hdc );
+
+    /* identical bands appended below are merged */
+    SetRectRgn( hrgn, 0, 0, 10, 10 );
+    tmp = CreateRectRgn( 0, 10, 10, 20 );
+    ret = CombineRgn( hrgn, hrgn, tmp, RGN_OR );
+    ok( ret == SIMPLEREGION, "CombineRgn returned %d\n", ret );
+    SetRect( &rc, 0, 0, 10, 20 );
+    verify_region( hrgn, &rc );
+    ret = CombineRgn( hrgn, tmp, hrgn, RGN_OR );
+    ok( ret == SIMPLEREGION, "CombineRgn returned %d\n", ret );
+    verify_region( hrgn, &rc );
+    DeleteObject( tmp );
+
+    DeleteObject( hrgn );
+}
+
 START_TEST(clipping)
 {
     test_GetRandomRgn();
@@ -541,4 +643,5 @@ START_TEST(clipping)
     test_GetClipRgn();
     test_memory_dc_clipping();
     test_window_dc_clipping();
+    test_complex_region();
 }
@@ -5599,6 +5599,62 @@ static void test_fullname2(void)
 
 }
 
+static void test_GetGlyphOutline_repeat(void)
+{
+    static const UINT formats[] = { GGO_BITMAP, GGO_GRAY2_BITMAP, GGO_GRAY4_BITMAP, GGO_GRAY8_BITMAP };
+    GLYPHMETRICS gm, gm2;
+    LOGFONTA lf;
+    HFONT hfont, old_hfont;
+    BYTE *buf, *buf2;
+    DWORD size, size2, ret;
+    HDC hdc;
+    UINT i, j;
+
+    if (!is_truetype_font_installed("Tahoma"))
+    {
+        skip("Tahoma is not installed\n");
+        return;
+    }
+
+    hdc = CreateCompatibleDC(0);
+    memset(&lf, 0, sizeof(lf));
+    lf.lfHeight = -40;
+    lstrcpyA(lf.lfFaceName, "Tahoma");
+
+    for (i = 0; i < sizeof(formats) / sizeof(formats[0]); i++)
+    {
+        hfont = CreateFontIndirectA(&lf);
+        old_hfont = SelectObject(hdc, hfont);
+        size = GetGlyphOutlineA(hdc, 'W', formats[i], &gm, 0, NULL, &mat);
+        ok(size != GDI_ERROR && size, "%u: GetGlyphOutlineA failed\n", formats[i]);
+        buf = HeapAlloc(GetProcessHeap(), 0, size);
+        ret = GetGlyphOutlineA(hdc, 'W', formats[i], &gm, size, buf, &mat);
+        ok(ret == size, "%u: got %u, expected %u\n", formats[i], ret, size);
+        SelectObject(hdc, old_hfont);
+        DeleteObject(hfont);
+
+        /* the same glyph rendered through a new font instance */
+        for (j = 0; j < 2; j++)
+        {
+            hfont = CreateFontIndirectA(&lf);
+            old_hfont = SelectObject(hdc, hfont);
+            size2 = GetGlyphOutlineA(hdc, 'W', formats[i], &gm2, 0, NULL, &mat);
+            ok(size2 == size, "%u: got size %u, expected %u\n", formats[i], size2, size);
+            buf2 = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, size);
+            ret = GetGlyphOutlineA(hdc, 'W', formats[i], &gm2, size, buf2, &mat);
+            ok(ret == size, "%u: got %u, expected %u\n", formats[i], ret, size);
+            ok(!memcmp(&gm, &gm2, sizeof(gm)), "%u: glyph metrics differ\n", formats[i]);
+            ok(!memcmp(buf, buf2, size), "%u: glyph bitmaps differ\n", formats[i]);
+            HeapFree(GetProcessHeap(), 0, buf2);
+            SelectObject(hdc, old_hfont);
+            DeleteObject(hfont);
+        }
+        HeapFree(GetProcessHeap(), 0, buf);
+    }
+
+    DeleteDC(hdc);
+}
+
 static void test_GetGlyphOutline_empty_contour(void)
 {
     HDC hdc;
@@ -6755,6 +6811,7 @@ START_TEST(font)
     test_RealizationInfo();
     test_GetTextFace();
     test_GetGlyphOutline();
+    test_GetGlyphOutline_repeat();
     test_GetTextMetrics2("Tahoma", -11);
     test_GetTextMetrics2("Tahoma", -55);
     test_GetTextMetrics2("Tahoma", -110);
@@ -214,6 +214,17 @@ static wchar_t istreambuf_iterator_wchar_val(istreambuf_iterator_wchar *this)
 
 static void istreambuf_iterator_char_inc(istreambuf_iterator_char *this)
 {
+    basic_streambuf_char *strbuf = this->strbuf;
+
+    /* Equivalent to snextc, read the next character straight from the get
+     * area while it holds one. */
+    if(strbuf && *strbuf->prpos && *strbuf->prsize > 1) {
+        (*strbuf->prsize)--;
+        this->val = *++*strbuf->prpos;
+        this->got = TRUE;
+        return;
+    }
+
     if(!this->strbuf || basic_streambuf_char_sbumpc(this->strbuf)==EOF) {
         this->strbuf = NULL;
         this->got = TRUE;
@@ -225,6 +236,15 @@ static void istreambuf_iterator_char_inc(istreambuf_iterator_char *this)
 
 static void istreambuf_iterator_wchar_inc(istreambuf_iterator_wchar *this)
 {
+    basic_streambuf_wchar *strbuf = this->strbuf;
+
+    if(strbuf && *strbuf->prpos && *strbuf->prsize > 1) {
+        (*strbuf->prsize)--;
+        this->val = *++*strbuf->prpos;
+        this->got = TRUE;
+        return;
+    }
+
     if(!this->strbuf || basic_streambuf_wchar_sbumpc(this->strbuf)==WEOF) {
         this->strbuf = NULL;
         this->got = TRUE;
@@ -246,6 +266,112 @@ static void ostreambuf_iterator_wchar_put(ostreambuf_iterator_wchar *this, wchar
         this->failed = TRUE;
 }
 
+/* Equivalent to calling ostreambuf_iterator_char_put for every character,
+ * but copies directly into the put area while there is room in it. */
+static void ostreambuf_iterator_char_put_n(ostreambuf_iterator_char *this,
+        const char *ptr, MSVCP_size_t count)
+{
+    basic_streambuf_char *strbuf = this->strbuf;
+    streamsize avail;
+
+    while(count>0 && !this->failed) {
+        avail = *strbuf->pwpos ? *strbuf->pwsize : 0;
+        if(avail <= 0) {
+            ostreambuf_iterator_char_put(this, *ptr++);
+            count--;
+            continue;
+        }
+
+        if(avail > count)
+            avail = count;
+        memcpy(*strbuf->pwpos, ptr, avail);
+        *strbuf->pwpos += avail;
+        *strbuf->pwsize -= avail;
+        ptr += avail;
+        count -= avail;
+    }
+}
+
+static void ostreambuf_iterator_char_rep(ostreambuf_iterator_char *this,
+        char ch, MSVCP_size_t count)
+{
+    basic_streambuf_char *strbuf = this->strbuf;
+    streamsize avail;
+
+    while(count>0 && !this->failed) {
+        avail = *strbuf->pwpos ? *strbuf->pwsize : 0;
+        if(avail <= 0) {
+            ostreambuf_iterator_char_put(this, ch);
+            count--;
+            continue;
+        }
+
+        if(avail > count)
+            avail = count;
+        memset(*strbuf->pwpos, ch, avail);
+        *strbuf->pwpos += avail;
+        *strbuf->pwsize -= avail;
+        count -= avail;
+    }
+}
+
+static void ostreambuf_iterator_wchar_put_n(ostreambuf_iterator_wchar *this,
+        const wchar_t *ptr, MSVCP_size_t count)
+{
+    basic_streambuf_wchar *strbuf = this->strbuf;
+    streamsize avail;
+
+    while(count>0 && !this->failed) {
+        avail = *strbuf->pwpos ? *strbuf->pwsize : 0;
+        if(avail <= 0) {
+            ostreambuf_iterator_wchar_put(this, *ptr++);
+            count--;
+            continue;
+        }
+
+        if(avail > count)
+            avail = count;
+        memcpy(*strbuf->pwpos, ptr, avail*sizeof(wchar_t));
+        *strbuf->pwpos += avail;
+        *strbuf->pwsize -= avail;
+        ptr += avail;
+        count -= avail;
+    }
+}
+
+static void ostreambuf_iterator_wchar_rep(ostreambuf_iterator_wchar *this,
+        wchar_t ch, MSVCP_size_t count)
+{
+    basic_streambuf_wchar *strbuf = this->strbuf;
+    streamsize avail, i;
+
+    while(count>0 && !this->failed) {
+        avail = *strbuf->pwpos ? *strbuf->pwsize : 0;
+        if(avail <= 0) {
+            ostreambuf_iterator_wchar_put(this, ch);
+            count--;
+            continue;
+        }
+
+        if(avail > count)
+            avail = count;
+        for(i=0; i<avail; i++)
+            (*strbuf->pwpos)[i] = ch;
+        *strbuf->pwpos += avail;
+        *strbuf->pwsize -= avail;
+        count -= avail;
+    }
+}
+
+/* The facets of a locale that isn't transparent don't change while the
+ * locale is referenced, so they can be looked up without the locale lock. */
+static inline const locale_facet* locale_facet_lookup(const locale *loc, MSVCP_size_t id)
+{
+    if(loc->ptr->transparent)
+        return NULL;
+    return id < loc->ptr->facet_cnt ? loc->ptr->facetvec[id] : NULL;
+}
+
 /* ??1facet@locale@std@@UAE@XZ */
 /* ??1facet@locale@std@@UEAA@XZ */
 /* ??1facet@locale@std@@MAA@XZ */
@@ -1083,6 +1209,10 @@ static collate* collate_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&collate_char_id));
+    if(fac)
+        return (collate*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&collate_char_id));
     if(fac) {
@@ -1375,6 +1505,10 @@ static collate* collate_wchar_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&collate_wchar_id));
+    if(fac)
+        return (collate*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&collate_wchar_id));
     if(fac) {
@@ -1422,6 +1556,10 @@ static collate* collate_short_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&collate_short_id));
+    if(fac)
+        return (collate*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&collate_short_id));
     if(fac) {
@@ -1941,6 +2079,10 @@ ctype_char* ctype_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&ctype_char_id));
+    if(fac)
+        return (ctype_char*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&ctype_char_id));
     if(fac) {
@@ -2772,6 +2914,10 @@ ctype_wchar* ctype_wchar_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&ctype_wchar_id));
+    if(fac)
+        return (ctype_wchar*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&ctype_wchar_id));
     if(fac) {
@@ -2800,6 +2946,10 @@ ctype_wchar* ctype_short_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&ctype_short_id));
+    if(fac)
+        return (ctype_wchar*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&ctype_short_id));
     if(fac) {
@@ -3336,6 +3486,10 @@ codecvt_char* codecvt_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&codecvt_char_id));
+    if(fac)
+        return (codecvt_char*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&codecvt_char_id));
     if(fac) {
@@ -3678,6 +3832,10 @@ codecvt_wchar* codecvt_wchar_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&codecvt_wchar_id));
+    if(fac)
+        return (codecvt_wchar*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&codecvt_wchar_id));
     if(fac) {
@@ -3737,6 +3895,10 @@ codecvt_wchar* codecvt_short_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&codecvt_short_id));
+    if(fac)
+        return (codecvt_wchar*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&codecvt_short_id));
     if(fac) {
@@ -4198,6 +4360,10 @@ static numpunct_char* numpunct_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&numpunct_char_id));
+    if(fac)
+        return (numpunct_char*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&numpunct_char_id));
     if(fac) {
@@ -4295,6 +4461,15 @@ basic_string_char* __thiscall numpunct_char_grouping(const numpunct_char *this,
     return call_numpunct_char_do_grouping(this, ret);
 }
 
+/* Our facets without digit grouping, like the classic "C" locale ones,
+ * don't need the virtual do_grouping call on every number. */
+static basic_string_char* numpunct_char_get_grouping(const numpunct_char *this, basic_string_char *ret)
+{
+    if(this->facet.vtable == &MSVCP_numpunct_char_vtable && !this->grouping[0])
+        return MSVCP_basic_string_char_ctor(ret);
+    return numpunct_char_grouping(this, ret);
+}
+
 /* ?do_falsename@?$numpunct@D@std@@MBE?AV?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@2@XZ */
 /* ?do_falsename@?$numpunct@D@std@@MEBA?AV?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@2@XZ */
 DEFINE_THISCALL_WRAPPER(numpunct_char_do_falsename, 8)
@@ -4585,6 +4760,10 @@ static numpunct_wchar* numpunct_wchar_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&numpunct_wchar_id));
+    if(fac)
+        return (numpunct_wchar*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&numpunct_wchar_id));
     if(fac) {
@@ -4640,6 +4819,10 @@ static numpunct_wchar* numpunct_short_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&numpunct_short_id));
+    if(fac)
+        return (numpunct_wchar*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&numpunct_short_id));
     if(fac) {
@@ -4748,6 +4931,14 @@ basic_string_char* __thiscall numpunct_wchar_grouping(const numpunct_wchar *this
     return call_numpunct_wchar_do_grouping(this, ret);
 }
 
+static basic_string_char* numpunct_wchar_get_grouping(const numpunct_wchar *this, basic_string_char *ret)
+{
+    if((this->facet.vtable == &MSVCP_numpunct_wchar_vtable
+                || this->facet.vtable == &MSVCP_numpunct_short_vtable) && !this->grouping[0])
+        return MSVCP_basic_string_char_ctor(ret);
+    return numpunct_wchar_grouping(this, ret);
+}
+
 /* ?do_falsename@?$numpunct@_W@std@@MBE?AV?$basic_string@_WU?$char_traits@_W@std@@V?$allocator@_W@2@@2@XZ */
 /* ?do_falsename@?$numpunct@_W@std@@MEBA?AV?$basic_string@_WU?$char_traits@_W@std@@V?$allocator@_W@2@@2@XZ */
 /* ?do_falsename@?$numpunct@G@std@@MBE?AV?$basic_string@GU?$char_traits@G@std@@V?$allocator@G@2@@2@XZ */
@@ -5069,6 +5260,10 @@ num_get* num_get_wchar_use_facet(const locale *loc)
         _Lockit lock;
         const locale_facet *fac;
 
+        fac = locale_facet_lookup(loc, locale_id_operator_size_t(&num_get_wchar_id));
+        if(fac)
+            return (num_get*)fac;
+
         _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
         fac = locale__Getfacet(loc, locale_id_operator_size_t(&num_get_wchar_id));
         if(fac) {
@@ -5116,6 +5311,10 @@ num_get* num_get_short_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&num_get_short_id));
+    if(fac)
+        return (num_get*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&num_get_short_id));
     if(fac) {
@@ -5161,7 +5360,7 @@ static int num_get__Getffld(const num_get *this, char *dest, istreambuf_iterator
         digits[i] = mb_to_wc('0'+i, cvt);
     digits[10] = 0;
 
-    numpunct_wchar_grouping(numpunct, &grouping_bstr);
+    numpunct_wchar_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
 #if _MSVCP_VER >= 70
     if (grouping[0]) sep = numpunct_wchar_thousands_sep(numpunct);
@@ -5352,7 +5551,7 @@ static int num_get__Getifld(const num_get *this, char *dest, istreambuf_iterator
         digits[16+i] = mb_to_wc('A'+i, cvt);
     }
 
-    numpunct_wchar_grouping(numpunct, &grouping_bstr);
+    numpunct_wchar_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
 #if _MSVCP_VER >= 70
     if (grouping[0]) sep = numpunct_wchar_thousands_sep(numpunct);
@@ -6319,6 +6518,10 @@ num_get* num_get_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&num_get_char_id));
+    if(fac)
+        return (num_get*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&num_get_char_id));
     if(fac) {
@@ -6361,7 +6564,7 @@ int __cdecl num_get_char__Getffld(const num_get *this, char *dest, istreambuf_it
 
     TRACE("(%p %p %p %p)\n", dest, first, last, loc);
 
-    numpunct_char_grouping(numpunct, &grouping_bstr);
+    numpunct_char_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
 #if _MSVCP_VER >= 70
     if (grouping[0]) sep = numpunct_char_thousands_sep(numpunct);
@@ -6524,7 +6727,7 @@ int __cdecl num_get_char__Getifld(const num_get *this, char *dest, istreambuf_it
 
     TRACE("(%p %p %p %04x %p)\n", dest, first, last, fmtflags, loc);
 
-    numpunct_char_grouping(numpunct, &grouping_bstr);
+    numpunct_char_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
 #if _MSVCP_VER >= 70
     if (grouping[0]) sep = numpunct_char_thousands_sep(numpunct);
@@ -7270,6 +7473,10 @@ num_put* num_put_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&num_put_char_id));
+    if(fac)
+        return (num_put*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&num_put_char_id));
     if(fac) {
@@ -7298,8 +7505,7 @@ ostreambuf_iterator_char* __cdecl num_put_char__Put(const num_put *this, ostream
 {
     TRACE("(%p %p %p %ld)\n", this, ret, ptr, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_char_put(&dest, *ptr++);
+    ostreambuf_iterator_char_put_n(&dest, ptr, count);
 
     *ret = dest;
     return ret;
@@ -7312,8 +7518,7 @@ ostreambuf_iterator_char* __cdecl num_put_char__Putc(const num_put *this, ostrea
 {
     TRACE("(%p %p %p %ld)\n", this, ret, ptr, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_char_put(&dest, *ptr++);
+    ostreambuf_iterator_char_put_n(&dest, ptr, count);
 
     *ret = dest;
     return ret;
@@ -7335,8 +7540,7 @@ ostreambuf_iterator_char* __cdecl num_put_char__Rep(const num_put *this, ostream
 {
     TRACE("(%p %p %d %ld)\n", this, ret, c, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_char_put(&dest, c);
+    ostreambuf_iterator_char_rep(&dest, c, count);
 
     *ret = dest;
     return ret;
@@ -7409,7 +7613,7 @@ static ostreambuf_iterator_char* num_put_char_fput(const num_put *this, ostreamb
     p--;
 
     /* Add separators to number */
-    numpunct_char_grouping(numpunct, &grouping_bstr);
+    numpunct_char_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
 #if _MSVCP_VER >= 70
     if (grouping[0]) sep = numpunct_char_thousands_sep(numpunct);
@@ -7494,7 +7698,7 @@ ostreambuf_iterator_char* __cdecl num_put_char__Iput(const num_put *this, ostrea
     TRACE("(%p %p %p %d %s %ld)\n", this, ret, base, fill, buf, count);
 
     /* Add separators to number */
-    numpunct_char_grouping(numpunct, &grouping_bstr);
+    numpunct_char_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
 #if _MSVCP_VER >= 70
     if (grouping[0]) sep = numpunct_char_thousands_sep(numpunct);
@@ -8078,6 +8282,10 @@ num_put* num_put_wchar_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&num_put_wchar_id));
+    if(fac)
+        return (num_put*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&num_put_wchar_id));
     if(fac) {
@@ -8106,6 +8314,10 @@ num_put* num_put_short_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&num_put_short_id));
+    if(fac)
+        return (num_put*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&num_put_short_id));
     if(fac) {
@@ -8136,8 +8348,7 @@ ostreambuf_iterator_wchar* __cdecl num_put_wchar__Put(const num_put *this, ostre
 {
     TRACE("(%p %p %s %ld)\n", this, ret, debugstr_wn(ptr, count), count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_wchar_put(&dest, *ptr++);
+    ostreambuf_iterator_wchar_put_n(&dest, ptr, count);
 
     *ret = dest;
     return ret;
@@ -8187,8 +8398,7 @@ ostreambuf_iterator_wchar* __cdecl num_put_wchar__Rep(const num_put *this, ostre
 {
     TRACE("(%p %p %d %ld)\n", this, ret, c, count);
 
-    for(; count>0; count--)
-        ostreambuf_iterator_wchar_put(&dest, c);
+    ostreambuf_iterator_wchar_rep(&dest, c, count);
 
     *ret = dest;
     return ret;
@@ -8293,7 +8503,7 @@ static ostreambuf_iterator_wchar* num_put__fput(const num_put *this, ostreambuf_
     p--;
 
     /* Add separators to number */
-    numpunct_wchar_grouping(numpunct, &grouping_bstr);
+    numpunct_wchar_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
 #if _MSVCP_VER >= 70
     if (grouping[0]) sep = numpunct_wchar_thousands_sep(numpunct);
@@ -8388,7 +8598,7 @@ static ostreambuf_iterator_wchar* num_put__Iput(const num_put *this, ostreambuf_
     TRACE("(%p %p %p %d %s %ld)\n", this, ret, base, fill, buf, count);
 
     /* Add separators to number */
-    numpunct_wchar_grouping(numpunct, &grouping_bstr);
+    numpunct_wchar_get_grouping(numpunct, &grouping_bstr);
     grouping = MSVCP_basic_string_char_c_str(&grouping_bstr);
     sep = grouping[0] ? numpunct_wchar_thousands_sep(numpunct) : '\0';
 
@@ -9100,6 +9310,10 @@ static time_put* time_put_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&time_put_char_id));
+    if(fac)
+        return (time_put*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&time_put_char_id));
     if(fac) {
@@ -9468,6 +9682,10 @@ static time_put* time_put_wchar_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&time_put_wchar_id));
+    if(fac)
+        return (time_put*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&time_put_wchar_id));
     if(fac) {
@@ -9523,6 +9741,10 @@ static time_put* time_put_short_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&time_put_short_id));
+    if(fac)
+        return (time_put*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&time_put_short_id));
     if(fac) {
@@ -9921,6 +10143,10 @@ static time_get_char* time_get_char_use_facet(const locale *loc)
     _Lockit lock;
     const locale_facet *fac;
 
+    fac = locale_facet_lookup(loc, locale_id_operator_size_t(&time_get_char_id));
+    if(fac)
+        return (time_get_char*)fac;
+
     _Lockit_ctor_locktype(&lock, _LOCK_LOCALE);
     fac = locale__Getfacet(loc, locale_id_operator_size_t(&time_get_char_id));
     if(fac) {
@@ -197,8 +197,13 @@ MSVCP_bool CDECL MSVCP_char_traits_wchar_lt(const wchar_t *ch1,
 int CDECL MSVCP_char_traits_wchar_compare(const wchar_t *s1,
         const wchar_t *s2, MSVCP_size_t count)
 {
-    int ret = memcmp(s1, s2, count * sizeof(wchar_t));
-    return (ret>0 ? 1 : (ret<0 ? -1 : 0));
+    MSVCP_size_t i;
+
+    /* memcmp would order little-endian code units by their low byte */
+    for(i=0; i<count; i++)
+        if(s1[i] != s2[i])
+            return s1[i] > s2[i] ? 1 : -1;
+    return 0;
 }
 
 /* ?length@?$char_traits@_W@std@@SAIPB_W@Z */
@@ -1582,6 +1587,25 @@ MSVCP_size_t __thiscall MSVCP_basic_string_char_rfind_ch(
     return MSVCP_basic_string_char_rfind_cstr_substr(this, &ch, pos, 1);
 }
 
+/* Builds a 256-bit membership table so that the find_*_of functions
+ * test each character once instead of scanning the whole set. */
+static void basic_string_char_set_init(unsigned char *set,
+        const char *find, MSVCP_size_t len)
+{
+    memset(set, 0, 256/8);
+    while(len--) {
+        unsigned char c = *find++;
+        set[c/8] |= 1 << (c%8);
+    }
+}
+
+static inline MSVCP_bool basic_string_char_set_test(
+        const unsigned char *set, char ch)
+{
+    unsigned char c = ch;
+    return (set[c/8] & (1 << (c%8))) != 0;
+}
+
 /* ?find_first_of@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QBEIPBDII@Z */
 /* ?find_first_of@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QEBA_KPEBD_K1@Z */
 DEFINE_THISCALL_WRAPPER(MSVCP_basic_string_char_find_first_of_cstr_substr, 16)
@@ -1589,13 +1613,21 @@ MSVCP_size_t __thiscall MSVCP_basic_string_char_find_first_of_cstr_substr(
         const basic_string_char *this, const char *find, MSVCP_size_t off, MSVCP_size_t len)
 {
     const char *p, *end;
+    unsigned char set[256/8];
 
     TRACE("%p %p %lu %lu\n", this, find, off, len);
 
+    if(len==1 && off<this->size) {
+        p = MSVCP_char_traits_char_find(basic_string_char_const_ptr(this)+off,
+                this->size-off, find);
+        return p ? p-basic_string_char_const_ptr(this) : MSVCP_basic_string_char_npos;
+    }
+
     if(len>0 && off<this->size) {
         end = basic_string_char_const_ptr(this)+this->size;
+        basic_string_char_set_init(set, find, len);
         for(p=basic_string_char_const_ptr(this)+off; p<end; p++)
-            if(MSVCP_char_traits_char_find(find, len, p))
+            if(basic_string_char_set_test(set, *p))
                 return p-basic_string_char_const_ptr(this);
     }
 
@@ -1824,13 +1856,15 @@ MSVCP_size_t __thiscall MSVCP_basic_string_char_find_first_not_of_cstr_substr(
         const basic_string_char *this, const char *find, MSVCP_size_t off, MSVCP_size_t len)
 {
     const char *p, *end;
+    unsigned char set[256/8];
 
     TRACE("%p %p %lu %lu\n", this, find, off, len);
 
     if(off<this->size) {
         end = basic_string_char_const_ptr(this)+this->size;
+        basic_string_char_set_init(set, find, len);
         for(p=basic_string_char_const_ptr(this)+off; p<end; p++)
-            if(!MSVCP_char_traits_char_find(find, len, p))
+            if(!basic_string_char_set_test(set, *p))
                 return p-basic_string_char_const_ptr(this);
     }
 
@@ -1873,6 +1907,7 @@ MSVCP_size_t __thiscall MSVCP_basic_string_char_find_last_of_cstr_substr(
         const basic_string_char *this, const char *find, MSVCP_size_t off, MSVCP_size_t len)
 {
     const char *p, *beg;
+    unsigned char set[256/8];
 
     TRACE("%p %p %lu %lu\n", this, find, off, len);
 
@@ -1881,8 +1916,9 @@ MSVCP_size_t __thiscall MSVCP_basic_string_char_find_last_of_cstr_substr(
             off = this->size-1;
 
         beg = basic_string_char_const_ptr(this);
+        basic_string_char_set_init(set, find, len);
         for(p=beg+off; p>=beg; p--)
-            if(MSVCP_char_traits_char_find(find, len, p))
+            if(basic_string_char_set_test(set, *p))
                 return p-beg;
     }
 
@@ -1925,6 +1961,7 @@ MSVCP_size_t __thiscall MSVCP_basic_string_char_find_last_not_of_cstr_substr(
         const basic_string_char *this, const char *find, MSVCP_size_t off, MSVCP_size_t len)
 {
     const char *p, *beg;
+    unsigned char set[256/8];
 
     TRACE("%p %p %lu %lu\n", this, find, off, len);
 
@@ -1933,8 +1970,9 @@ MSVCP_size_t __thiscall MSVCP_basic_string_char_find_last_not_of_cstr_substr(
             off = this->size-1;
 
         beg = basic_string_char_const_ptr(this);
+        basic_string_char_set_init(set, find, len);
         for(p=beg+off; p>=beg; p--)
-            if(!MSVCP_char_traits_char_find(find, len, p))
+            if(!basic_string_char_set_test(set, *p))
                 return p-beg;
     }
 
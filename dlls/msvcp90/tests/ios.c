@@ -504,6 +504,7 @@ static IOSB_iostate  (*__thiscall p_ios_base_rdstate)(const ios_base*);
 static IOSB_fmtflags (*__thiscall p_ios_base_setf_mask)(ios_base*, IOSB_fmtflags, IOSB_fmtflags);
 static void          (*__thiscall p_ios_base_unsetf)(ios_base*, IOSB_fmtflags);
 static streamsize    (*__thiscall p_ios_base_precision_set)(ios_base*, streamsize);
+static streamsize    (*__thiscall p_ios_base_width_set)(ios_base*, streamsize);
 
 /* locale */
 static locale*  (*__thiscall p_locale_ctor_cstr)(locale*, const char*, int /* FIXME: category */);
@@ -732,6 +733,8 @@ static BOOL init(void)
             "?unsetf@ios_base@std@@QEAAXH@Z");
         SET(p_ios_base_precision_set,
             "?precision@ios_base@std@@QEAA_J_J@Z");
+        SET(p_ios_base_width_set,
+            "?width@ios_base@std@@QEAA_J_J@Z");
 
         SET(p_basic_ios_char_imbue,
             "?imbue@?$basic_ios@DU?$char_traits@D@std@@@std@@QEAA?AVlocale@2@AEBV32@@Z");
@@ -864,6 +867,8 @@ static BOOL init(void)
             "?unsetf@ios_base@std@@QAAXH@Z");
         SET(p_ios_base_precision_set,
             "?precision@ios_base@std@@QAEHH@Z");
+        SET(p_ios_base_width_set,
+            "?width@ios_base@std@@QAEHH@Z");
 
         SET(p_basic_ios_char_imbue,
             "?imbue@?$basic_ios@DU?$char_traits@D@std@@@std@@QAA?AVlocale@2@ABV32@@Z");
@@ -995,6 +1000,8 @@ static BOOL init(void)
             "?unsetf@ios_base@std@@QAEXH@Z");
         SET(p_ios_base_precision_set,
             "?precision@ios_base@std@@QAEHH@Z");
+        SET(p_ios_base_width_set,
+            "?width@ios_base@std@@QAEHH@Z");
 
         SET(p_basic_ios_char_imbue,
             "?imbue@?$basic_ios@DU?$char_traits@D@std@@@std@@QAE?AVlocale@2@ABV32@@Z");
@@ -2060,6 +2067,86 @@ static void test_ostream_print_double(void)
     call_func1(p_basic_stringstream_char_vbase_dtor, &ss);
 }
 
+static void test_ostream_print_double_padded(void)
+{
+    basic_stringstream_char ss;
+    basic_string_char pstr;
+    const char *str;
+    int i;
+
+    /* enough output to overflow the initial put area several times */
+    call_func1(p_basic_stringstream_char_ctor, &ss);
+    for(i=0; i<1000; i++) {
+        call_func3(p_ios_base_setf_mask, &ss.basic_ios.base,
+                (i%2) ? FMTFLAG_left : 0, FMTFLAG_adjustfield);
+        call_func2(p_ios_base_width_set, &ss.basic_ios.base, 8);
+        call_func2_ptr_dbl(p_basic_ostream_char_print_double, &ss.base.base2, 1.5);
+    }
+    call_func2(p_basic_stringstream_char_str_get, &ss, &pstr);
+    str = call_func1(p_basic_string_char_cstr, &pstr);
+
+    ok(strlen(str) == 8000, "strlen(str) = %d\n", (int)strlen(str));
+    for(i=0; i<1000 && i*8<strlen(str); i++) {
+        const char *exp = (i%2) ? "1.5     " : "     1.5";
+        if(memcmp(str+i*8, exp, 8)) {
+            ok(0, "%d: wrong output %.8s\n", i, str+i*8);
+            break;
+        }
+    }
+
+    call_func1(p_basic_string_char_dtor, &pstr);
+    call_func1(p_basic_stringstream_char_vbase_dtor, &ss);
+}
+
+static void test_stream_throughput(void)
+{
+    const int count = 20000;
+    basic_stringstream_char ss;
+    basic_string_char str, pstr;
+    unsigned __int64 val = 0;
+    IOSB_iostate state;
+    const char *out;
+    char *buf, *p;
+    DWORD start;
+    int i, len;
+
+    buf = HeapAlloc(GetProcessHeap(), 0, count * 6 + 1);
+    for(i=0, p=buf; i<count; i++)
+        p += sprintf(p, "%d ", i);
+
+    /* read a large number of values from a single stream */
+    call_func2(p_basic_string_char_ctor_cstr, &str, buf);
+    call_func4(p_basic_stringstream_char_ctor_str, &ss, &str, OPENMODE_out|OPENMODE_in, TRUE);
+    start = GetTickCount();
+    for(i=0; i<count; i++) {
+        call_func2(p_basic_istream_char_read_uint64, &ss.base.base1, &val);
+        if(val != i)
+            break;
+    }
+    trace("read %d numbers in %u ms\n", i, GetTickCount()-start);
+    ok(i == count, "%d: wrong val %s\n", i, wine_dbgstr_longlong(val));
+    state = (IOSB_iostate)call_func1(p_ios_base_rdstate, &ss.basic_ios.base);
+    ok(state == IOSTATE_goodbit, "state = %x\n", state);
+    call_func1(p_basic_stringstream_char_vbase_dtor, &ss);
+    call_func1(p_basic_string_char_dtor, &str);
+
+    /* and write them back */
+    call_func1(p_basic_stringstream_char_ctor, &ss);
+    start = GetTickCount();
+    for(i=0; i<count; i++)
+        call_func2_ptr_dbl(p_basic_ostream_char_print_double, &ss.base.base2, i);
+    trace("wrote %d numbers in %u ms\n", count, GetTickCount()-start);
+    call_func2(p_basic_stringstream_char_str_get, &ss, &pstr);
+    out = call_func1(p_basic_string_char_cstr, &pstr);
+    for(i=0, len=0; i<count; i++)
+        len += sprintf(buf, "%d", i);
+    ok(strlen(out) == len, "strlen(out) = %d, expected %d\n", (int)strlen(out), len);
+    call_func1(p_basic_string_char_dtor, &pstr);
+    call_func1(p_basic_stringstream_char_vbase_dtor, &ss);
+
+    HeapFree(GetProcessHeap(), 0, buf);
+}
+
 static void test_ostream_wchar_print_double(void)
 {
     static const wchar_t double_str[] = { '3', '.', '1', '4', '1', '5', '9', 0 };
@@ -2349,6 +2436,8 @@ START_TEST(ios)
     test_ostream_print_ushort();
     test_ostream_print_float();
     test_ostream_print_double();
+    test_ostream_print_double_padded();
+    test_stream_throughput();
     test_ostream_wchar_print_double();
     test_istream_read_float();
     test_istream_read_double();
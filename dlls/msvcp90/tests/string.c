@@ -79,6 +79,7 @@ static size_t (__thiscall *p_basic_string_char_find_cstr_substr)(basic_string_ch
 static size_t (__thiscall *p_basic_string_char_rfind_cstr_substr)(basic_string_char*, const char*, size_t, size_t);
 static basic_string_char* (__thiscall *p_basic_string_char_replace_cstr)(basic_string_char*, size_t, size_t, const char*);
 static size_t (__thiscall *p_basic_string_char_find_last_not_of_cstr_substr)(const basic_string_char*, const char*, size_t, size_t);
+static size_t (__thiscall *p_basic_string_char_find_first_of_cstr_substr)(const basic_string_char*, const char*, size_t, size_t);
 
 static size_t *p_basic_string_char_npos;
 
@@ -93,6 +94,7 @@ static const wchar_t* (__thiscall *p_basic_string_wchar_data)(basic_string_wchar
 static size_t (__thiscall *p_basic_string_wchar_size)(basic_string_wchar*);
 static size_t (__thiscall *p_basic_string_wchar_capacity)(basic_string_wchar*);
 static void (__thiscall *p_basic_string_wchar_swap)(basic_string_wchar*, basic_string_wchar*);
+static int (__cdecl *p_char_traits_wchar_compare)(const wchar_t*, const wchar_t*, size_t);
 
 static int invalid_parameter = 0;
 static void __cdecl test_invalid_parameter_handler(const wchar_t *expression,
@@ -233,6 +235,8 @@ static BOOL init(void)
                 "?replace@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QEAAAEAV12@_K0PEBD@Z");
         SET(p_basic_string_char_find_last_not_of_cstr_substr,
                 "?find_last_not_of@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QEBA_KPEBD_K1@Z");
+        SET(p_basic_string_char_find_first_of_cstr_substr,
+                "?find_first_of@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QEBA_KPEBD_K1@Z");
         SET(p_basic_string_char_npos,
                 "?npos@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@2_KB");
 
@@ -258,6 +262,8 @@ static BOOL init(void)
                 "?capacity@?$basic_string@_WU?$char_traits@_W@std@@V?$allocator@_W@2@@std@@QEBA_KXZ");
         SET(p_basic_string_wchar_swap,
                 "?swap@?$basic_string@_WU?$char_traits@_W@std@@V?$allocator@_W@2@@std@@QEAAXAEAV12@@Z");
+        SET(p_char_traits_wchar_compare,
+                "?compare@?$char_traits@_W@std@@SAHPEB_W0_K@Z");
     } else {
         SET(p_basic_string_char_ctor,
                 "??0?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QAE@XZ");
@@ -301,6 +307,8 @@ static BOOL init(void)
                 "?replace@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QAEAAV12@IIPBD@Z");
         SET(p_basic_string_char_find_last_not_of_cstr_substr,
                 "?find_last_not_of@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QBEIPBDII@Z");
+        SET(p_basic_string_char_find_first_of_cstr_substr,
+                "?find_first_of@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@QBEIPBDII@Z");
         SET(p_basic_string_char_npos,
                 "?npos@?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std@@2IB");
 
@@ -326,6 +334,8 @@ static BOOL init(void)
                 "?capacity@?$basic_string@_WU?$char_traits@_W@std@@V?$allocator@_W@2@@std@@QBEIXZ");
         SET(p_basic_string_wchar_swap,
                 "?swap@?$basic_string@_WU?$char_traits@_W@std@@V?$allocator@_W@2@@std@@QAEXAAV12@@Z");
+        SET(p_char_traits_wchar_compare,
+                "?compare@?$char_traits@_W@std@@SAHPB_W0I@Z");
     }
 
     init_thiscall_thunk();
@@ -767,6 +777,55 @@ static void test_basic_string_char_find_last_not_of(void) {
     }
 }
 
+static void test_basic_string_char_find_first_of(void) {
+    struct find_first_of_test {
+        const char *str;
+        const char *find;
+        size_t off;
+        size_t len;
+        size_t ret;
+    };
+
+    int i;
+    size_t ret;
+    basic_string_char str;
+    struct find_first_of_test tests[] = {
+        { "ABCDE",    "E",     0, 1,  4 },
+        { "ABCDE",    "E",     5, 1, -1 },
+        { "ABCDE",    "DB",    0, 2,  1 },
+        { "ABCDE",    "DB",    2, 2,  3 },
+        { "ABCDE",    "xyz",   0, 3, -1 },
+        { "ABCDE",    "",      0, 0, -1 },
+        { "",         "A",     0, 1, -1 },
+        { "AB\xe9\x80", "\x80\xe9", 0, 2,  2 },
+        { "AB\xe9\x80", "\x80",    0, 1,  3 },
+        { "AB\x69\x80", "\xe9",    0, 1, -1 },
+    };
+
+    for(i=0; i<sizeof(tests)/sizeof(tests[0]); i++) {
+        call_func2(p_basic_string_char_ctor_cstr, &str, tests[i].str);
+
+        ret = (size_t)call_func4(p_basic_string_char_find_first_of_cstr_substr,
+                                 &str, tests[i].find, tests[i].off, tests[i].len);
+        ok(ret == tests[i].ret, "ret = %li tests[%i].ret = %li\n", (long)ret, i, (long)tests[i].ret);
+
+        call_func1(p_basic_string_char_dtor, &str);
+    }
+}
+
+static void test_char_traits_wchar_compare(void) {
+    static const wchar_t low[] = { 'a', 0x00ff, 0 };
+    static const wchar_t high[] = { 'a', 0x0100, 0 };
+    int ret;
+
+    ret = p_char_traits_wchar_compare(low, high, 1);
+    ok(ret == 0, "ret = %d\n", ret);
+    ret = p_char_traits_wchar_compare(low, high, 2);
+    ok(ret == -1, "ret = %d\n", ret);
+    ret = p_char_traits_wchar_compare(high, low, 2);
+    ok(ret == 1, "ret = %d\n", ret);
+}
+
 static void test_basic_string_dtor(void) {
 #ifdef __i386__
     static const wchar_t qwerty[] = { 'q','w','e','r','t','y',0 };
@@ -803,6 +862,8 @@ START_TEST(string)
     test_basic_string_wchar();
     test_basic_string_wchar_swap();
     test_basic_string_char_find_last_not_of();
+    test_basic_string_char_find_first_of();
+    test_char_traits_wchar_compare();
     test_basic_string_dtor();
 
     ok(!invalid_parameter, "invalid_parameter_handler was invoked too many times\n");
@@ -172,6 +172,15 @@ struct SchedulerVtbl {
     /* ScheduleTask */
 };
 
+typedef struct _UnrealizedChore {
+    void *vtable;
+    void (__cdecl *chore_proc)(struct _UnrealizedChore*);
+    void *task_collection;
+    void *chore_wrapper;
+    MSVCRT_bool runtime_owns_lifetime;
+    MSVCRT_bool detached;
+} _UnrealizedChore;
+
 static int* (__cdecl *p_errno)(void);
 static int (__cdecl *p_wmemcpy_s)(wchar_t *dest, size_t numberOfElements, const wchar_t *src, size_t count);
 static int (__cdecl *p_wmemmove_s)(wchar_t *dest, size_t numberOfElements, const wchar_t *src, size_t count);
@@ -221,6 +230,7 @@ static int (__cdecl *p_event_wait_for_multiple)(event**, size_t, MSVCRT_bool, un
 
 static Context* (__cdecl *p_Context_CurrentContext)(void);
 static unsigned int (__cdecl *p_Context_Id)(void);
+static void (__cdecl *p_Context_Block)(void);
 static SchedulerPolicy* (__thiscall *p_SchedulerPolicy_ctor)(SchedulerPolicy*);
 static void (__thiscall *p_SchedulerPolicy_SetConcurrencyLimits)(SchedulerPolicy*, unsigned int, unsigned int);
 static void (__thiscall *p_SchedulerPolicy_dtor)(SchedulerPolicy*);
@@ -228,6 +238,14 @@ static Scheduler* (__cdecl *p_Scheduler_Create)(SchedulerPolicy*);
 static Scheduler* (__cdecl *p_CurrentScheduler_Get)(void);
 static void (__cdecl *p_CurrentScheduler_Detach)(void);
 static unsigned int (__cdecl *p_CurrentScheduler_Id)(void);
+static void (__cdecl *p_CurrentScheduler_ScheduleTask)(void (__cdecl*)(void*), void*);
+static void* (__thiscall *p__TaskCollection_ctor)(void*);
+static void (__thiscall *p__TaskCollection_dtor)(void*);
+static void (__thiscall *p__TaskCollection__Schedule)(void*, _UnrealizedChore*);
+static int (__stdcall *p__TaskCollection__RunAndWait)(void*, _UnrealizedChore*);
+static void (__thiscall *p__StructuredTaskCollection__Schedule)(void*, _UnrealizedChore*);
+static int (__stdcall *p__StructuredTaskCollection__RunAndWait)(void*, _UnrealizedChore*);
+static MSVCRT_bool (__cdecl *p_Context_IsCurrentTaskCollectionCanceling)(void);
 
 /* make sure we use the correct errno */
 #undef errno
@@ -262,8 +280,10 @@ static BOOL init(void)
     SET(p_atoi, "atoi");
 
     SET(p_Context_Id, "?Id@Context@Concurrency@@SAIXZ");
+    SET(p_Context_Block, "?Block@Context@Concurrency@@SAXXZ");
     SET(p_CurrentScheduler_Detach, "?Detach@CurrentScheduler@Concurrency@@SAXXZ");
     SET(p_CurrentScheduler_Id, "?Id@CurrentScheduler@Concurrency@@SAIXZ");
+    SET(p_Context_IsCurrentTaskCollectionCanceling, "?IsCurrentTaskCollectionCanceling@Context@Concurrency@@SA_NXZ");
 
     if(sizeof(void*) == 8) { /* 64-bit initialization */
         SET(pSpinWait_ctor_yield, "??0?$_SpinWait@$00@details@Concurrency@@QEAA@P6AXXZ@Z");
@@ -306,6 +326,13 @@ static BOOL init(void)
         SET(p_SchedulerPolicy_dtor, "??1SchedulerPolicy@Concurrency@@QEAA@XZ");
         SET(p_Scheduler_Create, "?Create@Scheduler@Concurrency@@SAPEAV12@AEBVSchedulerPolicy@2@@Z");
         SET(p_CurrentScheduler_Get, "?Get@CurrentScheduler@Concurrency@@SAPEAVScheduler@2@XZ");
+        SET(p_CurrentScheduler_ScheduleTask, "?ScheduleTask@CurrentScheduler@Concurrency@@SAXP6AXPEAX@Z0@Z");
+        SET(p__TaskCollection_ctor, "??0_TaskCollection@details@Concurrency@@QEAA@XZ");
+        SET(p__TaskCollection_dtor, "??1_TaskCollection@details@Concurrency@@QEAA@XZ");
+        SET(p__TaskCollection__Schedule, "?_Schedule@_TaskCollection@details@Concurrency@@QEAAXPEAV_UnrealizedChore@23@@Z");
+        SET(p__TaskCollection__RunAndWait, "?_RunAndWait@_TaskCollection@details@Concurrency@@QEAA?AW4_TaskCollectionStatus@23@PEAV_UnrealizedChore@23@@Z");
+        SET(p__StructuredTaskCollection__Schedule, "?_Schedule@_StructuredTaskCollection@details@Concurrency@@QEAAXPEAV_UnrealizedChore@23@@Z");
+        SET(p__StructuredTaskCollection__RunAndWait, "?_RunAndWait@_StructuredTaskCollection@details@Concurrency@@QEAA?AW4_TaskCollectionStatus@23@PEAV_UnrealizedChore@23@@Z");
     } else {
         SET(pSpinWait_ctor_yield, "??0?$_SpinWait@$00@details@Concurrency@@QAE@P6AXXZ@Z");
         SET(pSpinWait_dtor, "??_F?$_SpinWait@$00@details@Concurrency@@QAEXXZ");
@@ -347,6 +374,13 @@ static BOOL init(void)
         SET(p_SchedulerPolicy_dtor, "??1SchedulerPolicy@Concurrency@@QAE@XZ");
         SET(p_Scheduler_Create, "?Create@Scheduler@Concurrency@@SAPAV12@ABVSchedulerPolicy@2@@Z");
         SET(p_CurrentScheduler_Get, "?Get@CurrentScheduler@Concurrency@@SAPAVScheduler@2@XZ");
+        SET(p_CurrentScheduler_ScheduleTask, "?ScheduleTask@CurrentScheduler@Concurrency@@SAXP6AXPAX@Z0@Z");
+        SET(p__TaskCollection_ctor, "??0_TaskCollection@details@Concurrency@@QAE@XZ");
+        SET(p__TaskCollection_dtor, "??1_TaskCollection@details@Concurrency@@QAE@XZ");
+        SET(p__TaskCollection__Schedule, "?_Schedule@_TaskCollection@details@Concurrency@@QAEXPAV_UnrealizedChore@23@@Z");
+        SET(p__TaskCollection__RunAndWait, "?_RunAndWait@_TaskCollection@details@Concurrency@@QAG?AW4_TaskCollectionStatus@23@PAV_UnrealizedChore@23@@Z");
+        SET(p__StructuredTaskCollection__Schedule, "?_Schedule@_StructuredTaskCollection@details@Concurrency@@QAEXPAV_UnrealizedChore@23@@Z");
+        SET(p__StructuredTaskCollection__RunAndWait, "?_RunAndWait@_StructuredTaskCollection@details@Concurrency@@QAG?AW4_TaskCollectionStatus@23@PAV_UnrealizedChore@23@@Z");
     }
 
     init_thiscall_thunk();
@@ -966,6 +1000,232 @@ static void test_Scheduler(void)
     call_func1(p_SchedulerPolicy_dtor, &policy);
 }
 
+static LONG scheduled_tasks;
+static LONG scheduled_tasks_expected;
+static HANDLE scheduled_tasks_done;
+
+static void __cdecl count_task(void *arg)
+{
+    if(InterlockedIncrement(&scheduled_tasks) == scheduled_tasks_expected)
+        SetEvent(scheduled_tasks_done);
+}
+
+static void __cdecl spawn_task(void *arg)
+{
+    INT_PTR depth = (INT_PTR)arg;
+
+    if(depth) {
+        p_CurrentScheduler_ScheduleTask(spawn_task, (void*)(depth - 1));
+        p_CurrentScheduler_ScheduleTask(spawn_task, (void*)(depth - 1));
+    }
+    count_task(NULL);
+}
+
+static void __cdecl unblock_task(void *arg)
+{
+    Context *context = arg;
+    void (__thiscall *unblock)(Context*) = ((void**)context->vtable)[3];
+
+    Sleep(50);
+    call_func1(unblock, context);
+}
+
+static DWORD WINAPI block_thread(void *arg)
+{
+    Context *context = p_Context_CurrentContext();
+
+    p_CurrentScheduler_ScheduleTask(unblock_task, context);
+    p_Context_Block();
+    return 0;
+}
+
+static void test_CurrentScheduler_ScheduleTask(void)
+{
+    HANDLE thread;
+    DWORD ret;
+    int i;
+
+    scheduled_tasks_done = CreateEventW(NULL, TRUE, FALSE, NULL);
+
+    scheduled_tasks = 0;
+    scheduled_tasks_expected = 1000;
+    for(i=0; i<1000; i++)
+        p_CurrentScheduler_ScheduleTask(count_task, NULL);
+    ret = WaitForSingleObject(scheduled_tasks_done, 5000);
+    ok(ret == WAIT_OBJECT_0, "WaitForSingleObject returned %u\n", ret);
+    ok(scheduled_tasks == 1000, "scheduled_tasks = %d\n", scheduled_tasks);
+
+    /* tasks scheduled from tasks */
+    ResetEvent(scheduled_tasks_done);
+    scheduled_tasks = 0;
+    scheduled_tasks_expected = (1 << 10) - 1;
+    p_CurrentScheduler_ScheduleTask(spawn_task, (void*)9);
+    ret = WaitForSingleObject(scheduled_tasks_done, 5000);
+    ok(ret == WAIT_OBJECT_0, "WaitForSingleObject returned %u\n", ret);
+    ok(scheduled_tasks == (1 << 10) - 1, "scheduled_tasks = %d\n", scheduled_tasks);
+
+    CloseHandle(scheduled_tasks_done);
+
+    /* context unblocked from a task */
+    thread = CreateThread(NULL, 0, block_thread, NULL, 0, NULL);
+    ret = WaitForSingleObject(thread, 5000);
+    ok(ret == WAIT_OBJECT_0, "WaitForSingleObject returned %u\n", ret);
+    CloseHandle(thread);
+}
+
+static Scheduler *expected_scheduler;
+static LONG wrong_scheduler;
+
+static void __cdecl scheduler_task(void *arg)
+{
+    if(p_CurrentScheduler_Get() != expected_scheduler)
+        InterlockedIncrement(&wrong_scheduler);
+    count_task(arg);
+}
+
+static void test_Scheduler_Release(void)
+{
+    Scheduler *scheduler;
+    SchedulerPolicy policy;
+    HANDLE shutdown;
+    DWORD ret;
+    int i;
+
+    scheduled_tasks_done = CreateEventW(NULL, TRUE, FALSE, NULL);
+    shutdown = CreateEventW(NULL, TRUE, FALSE, NULL);
+
+    call_func1(p_SchedulerPolicy_ctor, &policy);
+    call_func3(p_SchedulerPolicy_SetConcurrencyLimits, &policy, 1, 2);
+    scheduler = p_Scheduler_Create(&policy);
+    call_func1(p_SchedulerPolicy_dtor, &policy);
+    call_func2(scheduler->vtable->RegisterShutdownEvent, scheduler, shutdown);
+
+    call_func1(scheduler->vtable->Attach, scheduler);
+    expected_scheduler = scheduler;
+    wrong_scheduler = 0;
+    scheduled_tasks = 0;
+    scheduled_tasks_expected = 100;
+    for(i=0; i<100; i++)
+        p_CurrentScheduler_ScheduleTask(scheduler_task, NULL);
+    ret = WaitForSingleObject(scheduled_tasks_done, 5000);
+    ok(ret == WAIT_OBJECT_0, "WaitForSingleObject returned %u\n", ret);
+    ok(!wrong_scheduler, "%d tasks didn't run on their scheduler\n", wrong_scheduler);
+    p_CurrentScheduler_Detach();
+
+    /* the tasks don't keep the scheduler alive once they are done,
+     * and the worker threads exit cleanly after it's destroyed */
+    call_func1(scheduler->vtable->Release, scheduler);
+    ret = WaitForSingleObject(shutdown, 5000);
+    ok(ret == WAIT_OBJECT_0, "WaitForSingleObject returned %u\n", ret);
+    Sleep(100);
+
+    ok(p_CurrentScheduler_Get() != scheduler, "released scheduler is still current\n");
+    CloseHandle(shutdown);
+    CloseHandle(scheduled_tasks_done);
+}
+
+static LONG running_tasks, max_running_tasks;
+
+static void __cdecl concurrency_task(void *arg)
+{
+    LONG running = InterlockedIncrement(&running_tasks), max;
+
+    while((max = max_running_tasks) < running)
+        InterlockedCompareExchange(&max_running_tasks, running, max);
+    Sleep(5);
+    InterlockedDecrement(&running_tasks);
+    count_task(arg);
+}
+
+static void __cdecl blocking_task(void *arg)
+{
+    p_CurrentScheduler_ScheduleTask(unblock_task, p_Context_CurrentContext());
+    p_Context_Block();
+    count_task(arg);
+}
+
+static void test_MaxConcurrency(void)
+{
+    Scheduler *scheduler;
+    SchedulerPolicy policy;
+    DWORD ret;
+    int i;
+
+    scheduled_tasks_done = CreateEventW(NULL, TRUE, FALSE, NULL);
+
+    call_func1(p_SchedulerPolicy_ctor, &policy);
+    call_func3(p_SchedulerPolicy_SetConcurrencyLimits, &policy, 1, 1);
+    scheduler = p_Scheduler_Create(&policy);
+    call_func1(p_SchedulerPolicy_dtor, &policy);
+    call_func1(scheduler->vtable->Attach, scheduler);
+
+    /* other tasks run while one is blocked, but never two at a time */
+    scheduled_tasks = 0;
+    scheduled_tasks_expected = 21;
+    running_tasks = max_running_tasks = 0;
+    for(i=0; i<20; i++)
+        p_CurrentScheduler_ScheduleTask(concurrency_task, NULL);
+    p_CurrentScheduler_ScheduleTask(blocking_task, NULL);
+    ret = WaitForSingleObject(scheduled_tasks_done, 5000);
+    ok(ret == WAIT_OBJECT_0, "WaitForSingleObject returned %u\n", ret);
+    ok(max_running_tasks == 1, "max_running_tasks = %d\n", max_running_tasks);
+
+    p_CurrentScheduler_Detach();
+    call_func1(scheduler->vtable->Release, scheduler);
+    CloseHandle(scheduled_tasks_done);
+}
+
+static LONG chores_run;
+
+static void __cdecl chore_proc(_UnrealizedChore *chore)
+{
+    ok(!p_Context_IsCurrentTaskCollectionCanceling(), "task collection is canceling\n");
+    InterlockedIncrement(&chores_run);
+}
+
+static void test_task_collections(void)
+{
+    _UnrealizedChore chores[64], chore;
+    /* large enough for both collection types, the structured one has an inline constructor */
+    void *collection[64];
+    int i, ret;
+
+    memset(collection, 0, sizeof(collection));
+    memset(chores, 0, sizeof(chores));
+    memset(&chore, 0, sizeof(chore));
+    for(i=0; i<64; i++)
+        chores[i].chore_proc = chore_proc;
+    chore.chore_proc = chore_proc;
+
+    chores_run = 0;
+    for(i=0; i<64; i++)
+        call_func2(p__StructuredTaskCollection__Schedule, collection, &chores[i]);
+    ret = p__StructuredTaskCollection__RunAndWait(collection, &chore);
+    ok(ret == 1, "_RunAndWait returned %d\n", ret);
+    ok(chores_run == 65, "chores_run = %d\n", chores_run);
+
+    /* the collection can be reused once it's been waited for */
+    chores_run = 0;
+    for(i=0; i<64; i++)
+        call_func2(p__StructuredTaskCollection__Schedule, collection, &chores[i]);
+    ret = p__StructuredTaskCollection__RunAndWait(collection, NULL);
+    ok(ret == 1, "_RunAndWait returned %d\n", ret);
+    ok(chores_run == 64, "chores_run = %d\n", chores_run);
+
+    memset(chores, 0, sizeof(chores));
+    for(i=0; i<64; i++)
+        chores[i].chore_proc = chore_proc;
+
+    call_func1(p__TaskCollection_ctor, collection);
+    chores_run = 0;
+    for(i=0; i<64; i++)
+        call_func2(p__TaskCollection__Schedule, collection, &chores[i]);
+    ret = p__TaskCollection__RunAndWait(collection, NULL);
+    ok(ret == 1, "_RunAndWait returned %d\n", ret);
+    ok(chores_run == 64, "chores_run = %d\n", chores_run);
+    call_func1(p__TaskCollection_dtor, collection);
+}
+
 START_TEST(msvcr100)
 {
     if (!init())
@@ -973,6 +1233,10 @@ START_TEST(msvcr100)
 
     test_ExternalContextBase();
     test_Scheduler();
+    test_CurrentScheduler_ScheduleTask();
+    test_Scheduler_Release();
+    test_MaxConcurrency();
+    test_task_collections();
     test_wmemcpy_s();
     test_wmemmove_s();
     test_fread_s();
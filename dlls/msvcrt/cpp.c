@@ -985,6 +985,48 @@ void __thiscall MSVCRT_improper_scheduler_detach_dtor(
     TRACE("(%p)\n", _this);
     MSVCRT_exception_dtor(_this);
 }
+
+typedef exception context_unblock_unbalanced;
+extern const vtable_ptr MSVCRT_context_unblock_unbalanced_vtable;
+
+/* ??0context_unblock_unbalanced@Concurrency@@QAE@PBD@Z */
+/* ??0context_unblock_unbalanced@Concurrency@@QEAA@PEBD@Z */
+DEFINE_THISCALL_WRAPPER(context_unblock_unbalanced_ctor_str, 8)
+context_unblock_unbalanced* __thiscall context_unblock_unbalanced_ctor_str(
+        context_unblock_unbalanced *this, const char *str)
+{
+    TRACE("(%p %p)\n", this, str);
+    MSVCRT_exception_ctor(this, &str);
+    this->vtable = &MSVCRT_context_unblock_unbalanced_vtable;
+    return this;
+}
+
+/* ??0context_unblock_unbalanced@Concurrency@@QAE@XZ */
+/* ??0context_unblock_unbalanced@Concurrency@@QEAA@XZ */
+DEFINE_THISCALL_WRAPPER(context_unblock_unbalanced_ctor, 4)
+context_unblock_unbalanced* __thiscall context_unblock_unbalanced_ctor(
+        context_unblock_unbalanced *this)
+{
+    return context_unblock_unbalanced_ctor_str(this, NULL);
+}
+
+DEFINE_THISCALL_WRAPPER(MSVCRT_context_unblock_unbalanced_copy_ctor,8)
+context_unblock_unbalanced * __thiscall MSVCRT_context_unblock_unbalanced_copy_ctor(
+        context_unblock_unbalanced * _this, const context_unblock_unbalanced * rhs)
+{
+    TRACE("(%p %p)\n", _this, rhs);
+    MSVCRT_exception_copy_ctor(_this, rhs);
+    _this->vtable = &MSVCRT_context_unblock_unbalanced_vtable;
+    return _this;
+}
+
+DEFINE_THISCALL_WRAPPER(MSVCRT_context_unblock_unbalanced_dtor,4)
+void __thiscall MSVCRT_context_unblock_unbalanced_dtor(
+        context_unblock_unbalanced * _this)
+{
+    TRACE("(%p)\n", _this);
+    MSVCRT_exception_dtor(_this);
+}
 #endif
 
 #ifndef __GNUC__
@@ -1035,6 +1077,9 @@ __ASM_VTABLE(improper_scheduler_attach,
 __ASM_VTABLE(improper_scheduler_detach,
         VTABLE_ADD_FUNC(MSVCRT_exception_vector_dtor)
         VTABLE_ADD_FUNC(MSVCRT_what_exception));
+__ASM_VTABLE(context_unblock_unbalanced,
+        VTABLE_ADD_FUNC(MSVCRT_exception_vector_dtor)
+        VTABLE_ADD_FUNC(MSVCRT_what_exception));
 #endif
 
 #ifndef __GNUC__
@@ -1069,6 +1114,8 @@ DEFINE_RTTI_DATA1(improper_scheduler_attach, 0, &exception_rtti_base_descriptor,
         ".?AVimproper_scheduler_attach@Concurrency@@" )
 DEFINE_RTTI_DATA1(improper_scheduler_detach, 0, &exception_rtti_base_descriptor,
         ".?AVimproper_scheduler_detach@Concurrency@@" )
+DEFINE_RTTI_DATA1(context_unblock_unbalanced, 0, &exception_rtti_base_descriptor,
+        ".?AVcontext_unblock_unbalanced@Concurrency@@" )
 #endif
 
 DEFINE_EXCEPTION_TYPE_INFO( exception, 0, NULL, NULL )
@@ -1086,6 +1133,7 @@ DEFINE_EXCEPTION_TYPE_INFO(invalid_scheduler_policy_value, 1, &exception_cxx_typ
 DEFINE_EXCEPTION_TYPE_INFO(invalid_scheduler_policy_thread_specification, 1, &exception_cxx_type_info, NULL)
 DEFINE_EXCEPTION_TYPE_INFO(improper_scheduler_attach, 1, &exception_cxx_type_info, NULL)
 DEFINE_EXCEPTION_TYPE_INFO(improper_scheduler_detach, 1, &exception_cxx_type_info, NULL)
+DEFINE_EXCEPTION_TYPE_INFO(context_unblock_unbalanced, 1, &exception_cxx_type_info, NULL)
 #endif
 
 void msvcrt_init_exception(void *base)
@@ -1108,6 +1156,7 @@ void msvcrt_init_exception(void *base)
     init_invalid_scheduler_policy_thread_specification_rtti(base);
     init_improper_scheduler_attach_rtti(base);
     init_improper_scheduler_detach_rtti(base);
+    init_context_unblock_unbalanced_rtti(base);
 #endif
 
     init_exception_cxx(base);
@@ -1125,6 +1174,7 @@ void msvcrt_init_exception(void *base)
     init_invalid_scheduler_policy_thread_specification_cxx(base);
     init_improper_scheduler_attach_cxx(base);
     init_improper_scheduler_detach_cxx(base);
+    init_context_unblock_unbalanced_cxx(base);
 #endif
 #endif
 }
@@ -1174,6 +1224,11 @@ void throw_exception(exception_type et, HRESULT hr, const char *str)
         improper_scheduler_detach_ctor_str(&e, str);
         _CxxThrowException(&e, &improper_scheduler_detach_exception_type);
     }
+    case EXCEPTION_CONTEXT_UNBLOCK_UNBALANCED: {
+        context_unblock_unbalanced e;
+        context_unblock_unbalanced_ctor_str(&e, str);
+        _CxxThrowException(&e, &context_unblock_unbalanced_exception_type);
+    }
 #endif
     }
 }
@@ -2762,15 +2762,32 @@ static int read_i(int fd, ioinfo *fdinfo, void *buf, unsigned int count)
         }
         else if (fdinfo->wxflag & WX_TEXT)
         {
-            DWORD i, j;
+            DWORD i, j, eof = num_read;
+            const char *p;
 
             if (bufstart[0]=='\n' && (!utf16 || bufstart[1]==0))
                 fdinfo->wxflag |= WX_READNL;
             else
                 fdinfo->wxflag &= ~WX_READNL;
 
+            if (!utf16 && (p = memchr(bufstart, 0x1a, num_read)))
+                eof = p - bufstart;
+
             for (i=0, j=0; i<num_read; i+=1+utf16)
             {
+                /* move runs of characters that need no translation at once */
+                if (!utf16 && i<eof && bufstart[i]!='\r')
+                {
+                    DWORD run = (p = memchr(bufstart+i, '\r', eof-i)) ? p-bufstart-i : eof-i;
+
+                    if (i != j)
+                        memmove(bufstart+j, bufstart+i, run);
+                    i += run;
+                    j += run;
+                    if (i == num_read)
+                        break;
+                }
+
                 /* in text mode, a ctrl-z signals EOF */
                 if (bufstart[i]==0x1a && (!utf16 || bufstart[i+1]==0))
                 {
@@ -3400,27 +3417,44 @@ int CDECL MSVCRT__write(int fd, const void* buf, unsigned int count)
     else
     {
         unsigned int i, j, nr_lf, size;
+        char small_buf[MSVCRT_INTERNAL_BUFSIZ*2];
         char *p = NULL;
         const char *q;
         const char *s = buf, *buf_start = buf;
 
         if (!(info->exflag & (EF_UTF8|EF_UTF16)))
         {
+            const char *lf;
+            char *out;
+
             /* find number of \n */
-            for (nr_lf=0, i=0; i<count; i++)
-                if (s[i] == '\n')
-                    nr_lf++;
+            for (nr_lf=0, lf=memchr(s, '\n', count); lf; lf=memchr(lf+1, '\n', s+count-lf-1))
+                nr_lf++;
             if (nr_lf)
             {
                 size = count+nr_lf;
-                if ((q = p = MSVCRT_malloc(size)))
+                /* a full stdio buffer is translated without a heap allocation */
+                if (size <= sizeof(small_buf))
+                    out = small_buf;
+                else
+                    out = p = MSVCRT_malloc(size);
+
+                if ((q = out))
                 {
-                    for (s = buf, i = 0, j = 0; i < count; i++)
+                    /* copy the runs between the line feeds in bulk */
+                    for (i = 0, j = 0; i < count; i++)
                     {
-                        if (s[i] == '\n')
-                            p[j++] = '\r';
-                        p[j++] = s[i];
+                        lf = memchr(s+i, '\n', count-i);
+                        size = lf ? lf-s-i : count-i;
+                        memcpy(out+j, s+i, size);
+                        i += size;
+                        j += size;
+                        if (!lf)
+                            break;
+                        out[j++] = '\r';
+                        out[j++] = '\n';
                     }
+                    size = j;
                 }
                 else
                 {
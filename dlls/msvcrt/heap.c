@@ -24,6 +24,7 @@
 #include "msvcrt.h"
 #include "mtdll.h"
 #include "wine/debug.h"
+#include "wine/list.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(msvcrt);
 
@@ -52,8 +53,250 @@ static unsigned int MSVCRT_amblksiz = 16;
 /* FIXME - According to documentation it should be 480 bytes, at runtime default is 0 */
 static MSVCRT_size_t MSVCRT_sbh_threshold = 0;
 
+/* Per-thread cache of freed small blocks. Small blocks start with a header
+ * that holds their requested size, so free finds the size class without
+ * taking the heap lock and only goes to the heap when the cache is full.
+ * A cached block is only reused for an allocation of exactly its size, so
+ * _msize and _expand see no difference. The header is marked while the
+ * block is cached, so that freeing it again is detected instead of handing
+ * it out twice. Each cache has its own lock, which only _heapmin, _heapwalk
+ * and _set_sbh_threshold take from other threads to flush it. */
+#define HEAP_CACHE_MIN_SIZE  1
+#define HEAP_CACHE_MAX_SIZE  256
+#define HEAP_CACHE_DEPTH     32
+#define HEAP_CACHE_MAX_BYTES (64*1024)
+#define HEAP_CACHE_TRIM      1024
+#define HEAP_BLOCK_MAGIC     ((ULONG_PTR)0x426c6f63)
+#define HEAP_CACHE_MAGIC     ((ULONG_PTR)0x43616368)
+#define HEAP_CACHE_DEAD      ((struct heap_cache*)1)
+
+/* two pointers, so that the block keeps the heap's alignment */
+struct heap_block
+{
+    union
+    {
+        MSVCRT_size_t size;        /* requested size */
+        struct heap_block *next;   /* next cached block of the same size */
+    } u;
+    ULONG_PTR magic;               /* block address ^ HEAP_BLOCK_MAGIC or HEAP_CACHE_MAGIC */
+};
+
+struct heap_cache
+{
+    struct list entry;
+    CRITICAL_SECTION cs;
+    unsigned int free_count;
+    MSVCRT_size_t cached_bytes;
+    struct heap_block *free[HEAP_CACHE_MAX_SIZE+1];
+    unsigned char depth[HEAP_CACHE_MAX_SIZE+1];
+    unsigned char used[HEAP_CACHE_MAX_SIZE+1];
+};
+
+static DWORD heap_cache_tls = TLS_OUT_OF_INDEXES;
+static struct list heap_caches = LIST_INIT(heap_caches);
+
+static CRITICAL_SECTION heap_cache_cs;
+static CRITICAL_SECTION_DEBUG heap_cache_cs_debug =
+{
+    0, 0, &heap_cache_cs,
+    { &heap_cache_cs_debug.ProcessLocksList, &heap_cache_cs_debug.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": heap_cache_cs") }
+};
+static CRITICAL_SECTION heap_cache_cs = { &heap_cache_cs_debug, -1, 0, 0, 0, 0 };
+
+static inline struct heap_block *heap_block_from_ptr(void *ptr)
+{
+    return (struct heap_block*)ptr - 1;
+}
+
+static inline BOOL heap_block_has_magic(void *ptr, ULONG_PTR magic)
+{
+    return ((ULONG_PTR)ptr & (sizeof(struct heap_block) - 1)) == 0
+        && heap_block_from_ptr(ptr)->magic == ((ULONG_PTR)ptr ^ magic);
+}
+
+static void *heap_block_init(struct heap_block *block, MSVCRT_size_t size)
+{
+    block->u.size = size;
+    block->magic = (ULONG_PTR)(block + 1) ^ HEAP_BLOCK_MAGIC;
+    return block + 1;
+}
+
+/* called with the cache locked */
+static void heap_cache_release_size(struct heap_cache *cache, MSVCRT_size_t size)
+{
+    struct heap_block *block;
+
+    while((block = cache->free[size]))
+    {
+        cache->free[size] = block->u.next;
+        block->magic = 0;
+        HeapFree(heap, 0, block);
+    }
+    cache->cached_bytes -= cache->depth[size] * size;
+    cache->depth[size] = 0;
+}
+
+/* gives the sizes that were not reused recently back to the heap,
+ * called with the cache locked */
+static void heap_cache_trim(struct heap_cache *cache)
+{
+    MSVCRT_size_t size;
+
+    for(size=HEAP_CACHE_MIN_SIZE; size<=HEAP_CACHE_MAX_SIZE; size++)
+    {
+        if(!cache->used[size] && cache->depth[size])
+            heap_cache_release_size(cache, size);
+        cache->used[size] = 0;
+    }
+}
+
+static struct heap_cache *heap_cache_get(BOOL create)
+{
+    struct heap_cache *cache;
+    DWORD err;
+
+    if(heap_cache_tls == TLS_OUT_OF_INDEXES)
+        return NULL;
+
+    err = GetLastError();
+    cache = TlsGetValue(heap_cache_tls);
+    if(cache == HEAP_CACHE_DEAD)
+        cache = NULL;
+    else if(!cache && create
+            && (cache = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*cache))))
+    {
+        InitializeCriticalSection(&cache->cs);
+        cache->cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": heap_cache.cs");
+        EnterCriticalSection(&heap_cache_cs);
+        list_add_tail(&heap_caches, &cache->entry);
+        LeaveCriticalSection(&heap_cache_cs);
+        TlsSetValue(heap_cache_tls, cache);
+    }
+    SetLastError(err);
+    return cache;
+}
+
+static void* heap_cache_alloc(DWORD flags, MSVCRT_size_t size)
+{
+    struct heap_cache *cache;
+    struct heap_block *block;
+    void *ret;
+
+    if(size < HEAP_CACHE_MIN_SIZE || size > HEAP_CACHE_MAX_SIZE)
+        return NULL;
+    if(!(cache = heap_cache_get(FALSE)) || !cache->free[size])
+        return NULL;
+
+    EnterCriticalSection(&cache->cs);
+    if((block = cache->free[size]))
+    {
+        cache->free[size] = block->u.next;
+        cache->depth[size]--;
+        cache->cached_bytes -= size;
+        cache->used[size] = 1;
+    }
+    LeaveCriticalSection(&cache->cs);
+    if(!block)
+        return NULL;
+
+    ret = heap_block_init(block, size);
+    if(flags & HEAP_ZERO_MEMORY)
+        memset(ret, 0, size);
+    return ret;
+}
+
+static BOOL heap_cache_free(void *ptr)
+{
+    struct heap_block *block = heap_block_from_ptr(ptr);
+    MSVCRT_size_t size = block->u.size;
+    struct heap_cache *cache;
+    BOOL cached = FALSE;
+
+    if(size >= HEAP_CACHE_MIN_SIZE && size <= HEAP_CACHE_MAX_SIZE
+            && (cache = heap_cache_get(TRUE)))
+    {
+        EnterCriticalSection(&cache->cs);
+        if(cache->depth[size] < HEAP_CACHE_DEPTH
+                && cache->cached_bytes + size <= HEAP_CACHE_MAX_BYTES)
+        {
+            block->u.next = cache->free[size];
+            block->magic = (ULONG_PTR)ptr ^ HEAP_CACHE_MAGIC;
+            cache->free[size] = block;
+            cache->depth[size]++;
+            cache->cached_bytes += size;
+            cached = TRUE;
+        }
+        if(!(++cache->free_count % HEAP_CACHE_TRIM))
+            heap_cache_trim(cache);
+        LeaveCriticalSection(&cache->cs);
+    }
+    if(cached)
+        return TRUE;
+
+    block->magic = 0;
+    return HeapFree(heap, 0, block);
+}
+
+static void heap_cache_flush(struct heap_cache *cache)
+{
+    MSVCRT_size_t size;
+
+    for(size=HEAP_CACHE_MIN_SIZE; size<=HEAP_CACHE_MAX_SIZE; size++)
+        heap_cache_release_size(cache, size);
+}
+
+/* returns the blocks cached by all threads to the heap */
+static void heap_cache_flush_all(void)
+{
+    struct heap_cache *cache;
+
+    EnterCriticalSection(&heap_cache_cs);
+    LIST_FOR_EACH_ENTRY(cache, &heap_caches, struct heap_cache, entry)
+    {
+        EnterCriticalSection(&cache->cs);
+        heap_cache_flush(cache);
+        LeaveCriticalSection(&cache->cs);
+    }
+    LeaveCriticalSection(&heap_cache_cs);
+}
+
+/* frees the cache of the current thread, it's not used again afterwards */
+static void heap_cache_destroy(void)
+{
+    struct heap_cache *cache;
+
+    if(heap_cache_tls == TLS_OUT_OF_INDEXES)
+        return;
+    cache = TlsGetValue(heap_cache_tls);
+    TlsSetValue(heap_cache_tls, HEAP_CACHE_DEAD);
+    if(!cache || cache == HEAP_CACHE_DEAD)
+        return;
+
+    EnterCriticalSection(&heap_cache_cs);
+    list_remove(&cache->entry);
+    LeaveCriticalSection(&heap_cache_cs);
+
+    heap_cache_flush(cache);
+    cache->cs.DebugInfo->Spare[0] = 0;
+    DeleteCriticalSection(&cache->cs);
+    HeapFree(GetProcessHeap(), 0, cache);
+}
+
 static void* msvcrt_heap_alloc(DWORD flags, MSVCRT_size_t size)
 {
+    struct heap_block *block;
+    void *ret;
+
+    if(!sb_heap && size >= HEAP_CACHE_MIN_SIZE && size <= HEAP_CACHE_MAX_SIZE)
+    {
+        if((ret = heap_cache_alloc(flags, size)))
+            return ret;
+        if(!(block = HeapAlloc(heap, flags, sizeof(*block) + size)))
+            return NULL;
+        return heap_block_init(block, size);
+    }
+
     if(size < MSVCRT_sbh_threshold)
     {
         void *memblock, *temp, **saved;
@@ -72,6 +315,17 @@ static void* msvcrt_heap_alloc(DWORD flags, MSVCRT_size_t size)
 
 static void* msvcrt_heap_realloc(DWORD flags, void *ptr, MSVCRT_size_t size)
 {
+    if(ptr && heap_block_has_magic(ptr, HEAP_BLOCK_MAGIC))
+    {
+        struct heap_block *block;
+
+        if(size > ~(MSVCRT_size_t)0 - sizeof(*block))
+            return NULL;
+        if(!(block = HeapReAlloc(heap, flags, heap_block_from_ptr(ptr), sizeof(*block) + size)))
+            return NULL;
+        return heap_block_init(block, size);
+    }
+
     if(sb_heap && ptr && !HeapValidate(heap, 0, ptr))
     {
         /* TODO: move data to normal heap if it exceeds sbh_threshold limit */
@@ -104,6 +358,15 @@ static void* msvcrt_heap_realloc(DWORD flags, void *ptr, MSVCRT_size_t size)
 
 static BOOL msvcrt_heap_free(void *ptr)
 {
+    if(ptr && heap_block_has_magic(ptr, HEAP_BLOCK_MAGIC))
+        return heap_cache_free(ptr);
+    if(ptr && heap_block_has_magic(ptr, HEAP_CACHE_MAGIC))
+    {
+        WARN("block %p freed twice\n", ptr);
+        SetLastError(ERROR_INVALID_PARAMETER);
+        return FALSE;
+    }
+
     if(sb_heap && ptr && !HeapValidate(heap, 0, ptr))
     {
         void **saved = SAVED_PTR(ptr);
@@ -115,6 +378,9 @@ static BOOL msvcrt_heap_free(void *ptr)
 
 static MSVCRT_size_t msvcrt_heap_size(void *ptr)
 {
+    if(ptr && heap_block_has_magic(ptr, HEAP_BLOCK_MAGIC))
+        return heap_block_from_ptr(ptr)->u.size;
+
     if(sb_heap && ptr && !HeapValidate(heap, 0, ptr))
     {
         void **saved = SAVED_PTR(ptr);
@@ -268,6 +534,7 @@ int CDECL _heapchk(void)
  */
 int CDECL _heapmin(void)
 {
+  heap_cache_flush_all();
   if (!HeapCompact( heap, 0 ) ||
           (sb_heap && !HeapCompact( sb_heap, 0 )))
   {
@@ -288,11 +555,23 @@ int CDECL _heapwalk(struct MSVCRT__heapinfo* next)
   if (sb_heap)
       FIXME("small blocks heap not supported\n");
 
+  /* cached blocks would show up as used entries */
+  if (!next->_pentry)
+      heap_cache_flush_all();
+
   LOCK_HEAP;
   phe.lpData = next->_pentry;
   phe.cbData = next->_size;
   phe.wFlags = next->_useflag == MSVCRT__USEDENTRY ? PROCESS_HEAP_ENTRY_BUSY : 0;
 
+  /* small blocks are reported without their header */
+  if (phe.lpData && phe.wFlags & PROCESS_HEAP_ENTRY_BUSY &&
+      heap_block_has_magic( phe.lpData, HEAP_BLOCK_MAGIC ))
+  {
+      phe.lpData = heap_block_from_ptr( phe.lpData );
+      phe.cbData += sizeof(struct heap_block);
+  }
+
   if (phe.lpData && phe.wFlags & PROCESS_HEAP_ENTRY_BUSY &&
       !HeapValidate( heap, 0, phe.lpData ))
   {
@@ -316,6 +595,12 @@ int CDECL _heapwalk(struct MSVCRT__heapinfo* next)
   } while (phe.wFlags & (PROCESS_HEAP_REGION|PROCESS_HEAP_UNCOMMITTED_RANGE));
 
   UNLOCK_HEAP;
+  if (phe.wFlags & PROCESS_HEAP_ENTRY_BUSY && phe.cbData >= sizeof(struct heap_block) &&
+      heap_block_has_magic( (struct heap_block *)phe.lpData + 1, HEAP_BLOCK_MAGIC ))
+  {
+      phe.lpData = (struct heap_block *)phe.lpData + 1;
+      phe.cbData -= sizeof(struct heap_block);
+  }
   next->_pentry = phe.lpData;
   next->_size = phe.cbData;
   next->_useflag = phe.wFlags & PROCESS_HEAP_ENTRY_BUSY ? MSVCRT__USEDENTRY : MSVCRT__FREEENTRY;
@@ -521,6 +806,7 @@ int CDECL _set_sbh_threshold(MSVCRT_size_t threshold)
 
   if(!sb_heap)
   {
+      heap_cache_flush_all();
       sb_heap = HeapCreate(0, 0, 0);
       if(!sb_heap)
           return 0;
@@ -855,11 +1141,23 @@ int CDECL MSVCRT_strncpy_s(char *dest, MSVCRT_size_t numberOfElements,
 BOOL msvcrt_init_heap(void)
 {
     heap = HeapCreate(0, 0, 0);
+    heap_cache_tls = TlsAlloc();
     return heap != NULL;
 }
 
+void msvcrt_free_heap_cache(void)
+{
+    heap_cache_destroy();
+}
+
 void msvcrt_destroy_heap(void)
 {
+    heap_cache_destroy();
+    if(heap_cache_tls != TLS_OUT_OF_INDEXES)
+    {
+        TlsFree(heap_cache_tls);
+        heap_cache_tls = TLS_OUT_OF_INDEXES;
+    }
     HeapDestroy(heap);
     if(sb_heap)
         HeapDestroy(sb_heap);
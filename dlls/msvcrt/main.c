@@ -136,6 +136,7 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved)
     msvcrt_free_console();
     msvcrt_free_args();
     msvcrt_free_signals();
+    msvcrt_free_undname_cache();
     msvcrt_free_tls_mem();
     if (!msvcrt_free_tls())
       return FALSE;
@@ -152,6 +153,7 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved)
 #if _MSVCR_VER >= 100 && _MSVCR_VER <= 120
     msvcrt_free_scheduler_thread();
 #endif
+    msvcrt_free_heap_cache();
     TRACE("finished thread free\n");
     break;
   }
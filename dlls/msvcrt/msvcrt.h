@@ -293,6 +293,7 @@ typedef enum {
     EXCEPTION_INVALID_SCHEDULER_POLICY_THREAD_SPECIFICATION,
     EXCEPTION_IMPROPER_SCHEDULER_ATTACH,
     EXCEPTION_IMPROPER_SCHEDULER_DETACH,
+    EXCEPTION_CONTEXT_UNBLOCK_UNBALANCED,
 #endif
 } exception_type;
 void throw_exception(exception_type, HRESULT, const char*) DECLSPEC_HIDDEN;
@@ -338,8 +339,10 @@ extern void msvcrt_free_args(void) DECLSPEC_HIDDEN;
 extern void msvcrt_init_signals(void) DECLSPEC_HIDDEN;
 extern void msvcrt_free_signals(void) DECLSPEC_HIDDEN;
 extern void msvcrt_free_popen_data(void) DECLSPEC_HIDDEN;
+extern void msvcrt_free_undname_cache(void) DECLSPEC_HIDDEN;
 extern BOOL msvcrt_init_heap(void) DECLSPEC_HIDDEN;
 extern void msvcrt_destroy_heap(void) DECLSPEC_HIDDEN;
+extern void msvcrt_free_heap_cache(void) DECLSPEC_HIDDEN;
 
 #if _MSVCR_VER >= 100
 extern void msvcrt_init_scheduler(void*) DECLSPEC_HIDDEN;
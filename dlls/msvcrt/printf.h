@@ -345,6 +345,81 @@ static inline void FUNC_NAME(pf_fixup_exponent)(char *buf, BOOL three_digit_exp)
     }
 }
 
+/* pf_format_fixed: prints a non-negative double in %f notation without the
+ * host sprintf. Only values whose fraction fits in 60 bits and whose integer
+ * part fits in 64 bits are handled. The digits are exact, and ties round
+ * to even like glibc. The buffer must hold the digits and the terminator. */
+static inline BOOL FUNC_NAME(pf_format_fixed)(char *buf, double val, int prec, BOOL alternate)
+{
+    union { double f; ULONGLONG i; } u;
+    ULONGLONG mant, int_part, frac = 0, mask = 0;
+    char digits[20], *p = buf, *q;
+    int exp, shift, i;
+
+    u.f = val;
+    if(u.i >> 63)
+        return FALSE;
+    exp = (u.i >> 52) & 0x7ff;
+    mant = u.i & (((ULONGLONG)1 << 52) - 1);
+    if(!exp) {
+        if(mant) return FALSE;
+        shift = 0;
+    } else {
+        if(exp == 0x7ff) return FALSE;
+        mant |= (ULONGLONG)1 << 52;
+        shift = 1075 - exp; /* val = mant * 2^-shift */
+    }
+    if(shift < -11 || shift > 60)
+        return FALSE;
+
+    if(shift <= 0) {
+        int_part = mant << -shift;
+        shift = 0;
+    } else {
+        mask = ((ULONGLONG)1 << shift) - 1;
+        int_part = mant >> shift;
+        frac = mant & mask;
+    }
+
+    i = 0;
+    do {
+        digits[i++] = '0' + int_part % 10;
+        int_part /= 10;
+    } while(int_part);
+    while(i)
+        *p++ = digits[--i];
+
+    if(prec || alternate)
+        *p++ = '.';
+    for(i=0; i<prec; i++) {
+        frac *= 10;
+        *p++ = '0' + (frac >> shift);
+        frac &= mask;
+    }
+
+    q = p - 1;
+    if(*q == '.')
+        q--;
+    if(frac > mask / 2 + 1 || (frac == mask / 2 + 1 && ((*q - '0') & 1))) {
+        for(; q >= buf; q--) {
+            if(*q == '.')
+                continue;
+            if(*q != '9') {
+                (*q)++;
+                break;
+            }
+            *q = '0';
+        }
+        if(q < buf) {
+            memmove(buf + 1, buf, p - buf);
+            *buf = '1';
+            p++;
+        }
+    }
+    *p = 0;
+    return TRUE;
+}
+
 int FUNC_NAME(pf_printf)(FUNC_NAME(puts_clbk) pf_puts, void *puts_ctx, const APICHAR *fmt,
         MSVCRT__locale_t locale, DWORD options,
         args_clbk pf_args, void *args_ctx, __ms_va_list *valist)
@@ -627,6 +702,9 @@ int FUNC_NAME(pf_printf)(FUNC_NAME(puts_clbk) pf_puts, void *puts_ctx, const API
                 if (strchr("EFG", flags.Format))
                     for(i=0; tmp[i]; i++)
                         tmp[i] = toupper(tmp[i]);
+            } else if((flags.Format=='f' || flags.Format=='F') && FUNC_NAME(pf_format_fixed)(tmp,
+                        val, flags.Precision==-1 ? 6 : flags.Precision, flags.Alternate)) {
+                /* printed without the host sprintf */
             } else {
                 sprintf(tmp, float_fmt, val);
                 if(toupper(flags.Format)=='E' || toupper(flags.Format)=='G')
@@ -110,11 +110,51 @@ struct scheduler_list {
     struct scheduler_list *next;
 };
 
+typedef enum {
+    TASK_COLLECTION_NOT_COMPLETE,
+    TASK_COLLECTION_SUCCESS,
+    TASK_COLLECTION_CANCELLED
+} _TaskCollectionStatus;
+
+/* The fields up to the exception follow _TaskCollectionBase in ppl.h. The
+ * inline _StructuredTaskCollection constructor only clears the owning
+ * context, the rest is set up when the first chore is scheduled. */
+typedef struct _StructuredTaskCollection {
+    void *unk1;
+    unsigned int unk2;
+#if _MSVCR_VER >= 110
+    void *token;
+#endif
+    Context *context;   /* the context that schedules the chores and waits for them */
+    LONG count;         /* unfinished chores, plus one until _RunAndWait */
+    LONG canceled;
+    void *exception;
+    void *unk3;
+} _StructuredTaskCollection;
+
+typedef _StructuredTaskCollection _TaskCollection;
+
+typedef struct _UnrealizedChore {
+    const vtable_ptr *vtable;
+    void (__cdecl *chore_proc)(struct _UnrealizedChore*);
+    _StructuredTaskCollection *task_collection;
+    void (__cdecl *chore_wrapper)(struct _UnrealizedChore*);
+    MSVCRT_bool runtime_owns_lifetime;
+    MSVCRT_bool detached;
+} _UnrealizedChore;
+#define call__UnrealizedChore_vector_dtor(this, flags) CALL_VTBL_FUNC(this, 0, \
+        void*, (_UnrealizedChore*, unsigned int), (this, flags))
+
 typedef struct {
     Context context;
     struct scheduler_list scheduler;
     unsigned int id;
     union allocator_cache_entry *allocator_cache[8];
+    struct scheduler_pool *pool;
+    unsigned int vproc;
+    LONG blocked;
+    HANDLE blocked_event;
+    _StructuredTaskCollection *task_collection;
 } ExternalContextBase;
 extern const vtable_ptr MSVCRT_ExternalContextBase_vtable;
 static void ExternalContextBase_ctor(ExternalContextBase*);
@@ -156,6 +196,7 @@ typedef struct {
     int shutdown_size;
     HANDLE *shutdown_events;
     CRITICAL_SECTION cs;
+    struct scheduler_pool *pool;
 } ThreadScheduler;
 extern const vtable_ptr MSVCRT_ThreadScheduler_vtable;
 
@@ -256,16 +297,37 @@ unsigned int __cdecl Context_Id(void)
     return ctx ? call_Context_GetId(ctx) : -1;
 }
 
+static void scheduler_pool_block(struct scheduler_pool*, unsigned int);
+static void scheduler_pool_unblock(struct scheduler_pool*, unsigned int);
+
 /* ?Block@Context@Concurrency@@SAXXZ */
 void __cdecl Context_Block(void)
 {
-    FIXME("()\n");
+    ExternalContextBase *context = (ExternalContextBase*)get_current_context();
+
+    TRACE("()\n");
+
+    if(context->context.vtable != &MSVCRT_ExternalContextBase_vtable) {
+        ERR("unknown context set\n");
+        return;
+    }
+
+    if(!context->blocked_event)
+        context->blocked_event = CreateEventW(NULL, FALSE, FALSE, NULL);
+    if(InterlockedDecrement(&context->blocked) < 0) {
+        if(context->pool)
+            scheduler_pool_block(context->pool, context->vproc);
+        WaitForSingleObject(context->blocked_event, INFINITE);
+        if(context->pool)
+            scheduler_pool_unblock(context->pool, context->vproc);
+    }
 }
 
 /* ?Yield@Context@Concurrency@@SAXXZ */
 void __cdecl Context_Yield(void)
 {
-    FIXME("()\n");
+    TRACE("()\n");
+    SwitchToThread();
 }
 
 /* ?_SpinYield@Context@Concurrency@@SAXXZ */
@@ -277,8 +339,13 @@ void __cdecl Context__SpinYield(void)
 /* ?IsCurrentTaskCollectionCanceling@Context@Concurrency@@SA_NXZ */
 MSVCRT_bool __cdecl Context_IsCurrentTaskCollectionCanceling(void)
 {
-    FIXME("()\n");
-    return FALSE;
+    ExternalContextBase *context = (ExternalContextBase*)try_get_current_context();
+
+    TRACE("()\n");
+
+    if(!context || context->context.vtable != &MSVCRT_ExternalContextBase_vtable)
+        return FALSE;
+    return context->task_collection && context->task_collection->canceled;
 }
 
 /* ?Oversubscribe@Context@Concurrency@@SAX_N@Z */
@@ -313,8 +380,8 @@ unsigned int __thiscall ExternalContextBase_GetId(const ExternalContextBase *thi
 DEFINE_THISCALL_WRAPPER(ExternalContextBase_GetVirtualProcessorId, 4)
 unsigned int __thiscall ExternalContextBase_GetVirtualProcessorId(const ExternalContextBase *this)
 {
-    FIXME("(%p)->() stub\n", this);
-    return -1;
+    TRACE("(%p)->()\n", this);
+    return this->pool ? this->vproc : -1;
 }
 
 DEFINE_THISCALL_WRAPPER(ExternalContextBase_GetScheduleGroupId, 4)
@@ -327,19 +394,47 @@ unsigned int __thiscall ExternalContextBase_GetScheduleGroupId(const ExternalCon
 DEFINE_THISCALL_WRAPPER(ExternalContextBase_Unblock, 4)
 void __thiscall ExternalContextBase_Unblock(ExternalContextBase *this)
 {
-    FIXME("(%p)->() stub\n", this);
+    LONG blocked;
+
+    TRACE("(%p)->()\n", this);
+
+    /* an Unblock that races ahead of Block makes the next Block return immediately */
+    blocked = InterlockedIncrement(&this->blocked);
+    if(blocked > 1) {
+        InterlockedDecrement(&this->blocked);
+        throw_exception(EXCEPTION_CONTEXT_UNBLOCK_UNBALANCED, 0,
+                "Context::Unblock was called without a matching Context::Block");
+    }
+    if(!blocked)
+        SetEvent(this->blocked_event);
 }
 
 DEFINE_THISCALL_WRAPPER(ExternalContextBase_IsSynchronouslyBlocked, 4)
 MSVCRT_bool __thiscall ExternalContextBase_IsSynchronouslyBlocked(const ExternalContextBase *this)
 {
-    FIXME("(%p)->() stub\n", this);
-    return FALSE;
+    TRACE("(%p)->()\n", this);
+    return this->blocked < 0;
+}
+
+static void scheduler_list_release(struct scheduler_list *list)
+{
+    struct scheduler_list *cur, *next;
+
+    if(!list->scheduler)
+        return;
+
+    call_Scheduler_Release(list->scheduler);
+    for(cur=list->next; cur; cur=next) {
+        next = cur->next;
+        call_Scheduler_Release(cur->scheduler);
+        MSVCRT_operator_delete(cur);
+    }
+    list->scheduler = NULL;
+    list->next = NULL;
 }
 
 static void ExternalContextBase_dtor(ExternalContextBase *this)
 {
-    struct scheduler_list *scheduler_cur, *scheduler_next;
     union allocator_cache_entry *next, *cur;
     int i;
 
@@ -351,15 +446,10 @@ static void ExternalContextBase_dtor(ExternalContextBase *this)
         }
     }
 
-    if (this->scheduler.scheduler) {
-        call_Scheduler_Release(this->scheduler.scheduler);
+    scheduler_list_release(&this->scheduler);
 
-        for(scheduler_cur=this->scheduler.next; scheduler_cur; scheduler_cur=scheduler_next) {
-            scheduler_next = scheduler_cur->next;
-            call_Scheduler_Release(scheduler_cur->scheduler);
-            MSVCRT_operator_delete(scheduler_cur);
-        }
-    }
+    if(this->blocked_event)
+        CloseHandle(this->blocked_event);
 }
 
 DEFINE_THISCALL_WRAPPER(ExternalContextBase_vector_dtor, 8)
@@ -623,6 +713,324 @@ void __thiscall SchedulerPolicy_dtor(SchedulerPolicy *this)
     MSVCRT_operator_delete(this->policy_container);
 }
 
+/* Tasks are queued on per virtual processor deques.  A worker thread takes
+ * the most recently queued task from its own deque, and steals the oldest
+ * one from the other deques when it runs out of work.
+ *
+ * Task collections queue their chores as tasks, and _RunAndWait runs queued
+ * tasks on the waiting thread before it blocks. parallel_for and task_group
+ * are templates in ppl.h built on top of the task collections. */
+struct scheduler_task {
+    void (__cdecl *proc)(void*);
+    void *data;
+    ThreadScheduler *scheduler;
+};
+
+struct scheduler_vproc {
+    CRITICAL_SECTION cs;
+    struct scheduler_task *tasks;
+    unsigned int head;
+    unsigned int count;
+    unsigned int size;
+    LONG workers;
+};
+
+struct scheduler_worker {
+    struct scheduler_pool *pool;
+    unsigned int vproc;
+};
+
+struct scheduler_pool {
+    LONG ref;
+    ThreadScheduler *scheduler;
+    unsigned int vproc_count;
+    unsigned int min_workers;
+    LONG workers;
+    LONG idle;
+    LONG pending;
+    LONG next_vproc;
+    BOOL shutdown;
+    CRITICAL_SECTION cs;
+    CONDITION_VARIABLE cv;
+    struct scheduler_vproc vprocs[1];
+};
+
+static HMODULE scheduler_module;
+
+static struct scheduler_pool* scheduler_pool_create(ThreadScheduler *scheduler)
+{
+    struct scheduler_pool *pool;
+    unsigned int i, count;
+
+    count = scheduler->virt_proc_no ? scheduler->virt_proc_no : 1;
+    pool = MSVCRT_operator_new(FIELD_OFFSET(struct scheduler_pool, vprocs[count]));
+    memset(pool, 0, FIELD_OFFSET(struct scheduler_pool, vprocs[count]));
+    pool->ref = 1;
+    pool->scheduler = scheduler;
+    pool->vproc_count = count;
+    pool->min_workers = SchedulerPolicy_GetPolicyValue(&scheduler->policy, MinConcurrency);
+    if(pool->min_workers > count)
+        pool->min_workers = count;
+    InitializeCriticalSection(&pool->cs);
+    pool->cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": scheduler_pool");
+    InitializeConditionVariable(&pool->cv);
+
+    for(i=0; i<count; i++) {
+        InitializeCriticalSection(&pool->vprocs[i].cs);
+        pool->vprocs[i].cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": scheduler_vproc");
+    }
+    return pool;
+}
+
+static void scheduler_pool_release(struct scheduler_pool *pool)
+{
+    unsigned int i;
+
+    if(InterlockedDecrement(&pool->ref))
+        return;
+
+    for(i=0; i<pool->vproc_count; i++) {
+        if(pool->vprocs[i].count)
+            WARN("%u tasks not executed\n", pool->vprocs[i].count);
+        MSVCRT_operator_delete(pool->vprocs[i].tasks);
+        pool->vprocs[i].cs.DebugInfo->Spare[0] = 0;
+        DeleteCriticalSection(&pool->vprocs[i].cs);
+    }
+    pool->cs.DebugInfo->Spare[0] = 0;
+    DeleteCriticalSection(&pool->cs);
+    MSVCRT_operator_delete(pool);
+}
+
+static void scheduler_pool_shutdown(struct scheduler_pool *pool)
+{
+    EnterCriticalSection(&pool->cs);
+    pool->shutdown = TRUE;
+    pool->scheduler = NULL;
+    WakeAllConditionVariable(&pool->cv);
+    LeaveCriticalSection(&pool->cs);
+    scheduler_pool_release(pool);
+}
+
+static void scheduler_vproc_push(struct scheduler_vproc *vproc, const struct scheduler_task *task)
+{
+    struct scheduler_task *tasks;
+    unsigned int i, size;
+
+    EnterCriticalSection(&vproc->cs);
+    while(vproc->count == vproc->size) {
+        /* don't hold the lock while allocating, operator new may throw */
+        size = vproc->size ? vproc->size * 2 : 16;
+        LeaveCriticalSection(&vproc->cs);
+        tasks = MSVCRT_operator_new(size * sizeof(*tasks));
+        EnterCriticalSection(&vproc->cs);
+
+        if(vproc->size >= size) {
+            MSVCRT_operator_delete(tasks);
+            continue;
+        }
+        for(i=0; i<vproc->count; i++)
+            tasks[i] = vproc->tasks[(vproc->head + i) % vproc->size];
+        MSVCRT_operator_delete(vproc->tasks);
+        vproc->tasks = tasks;
+        vproc->head = 0;
+        vproc->size = size;
+    }
+    vproc->tasks[(vproc->head + vproc->count) % vproc->size] = *task;
+    vproc->count++;
+    LeaveCriticalSection(&vproc->cs);
+}
+
+static BOOL scheduler_pool_take(struct scheduler_pool *pool,
+        unsigned int index, struct scheduler_task *task)
+{
+    struct scheduler_vproc *vproc;
+    unsigned int i;
+
+    for(i=0; i<pool->vproc_count; i++) {
+        vproc = &pool->vprocs[(index + i) % pool->vproc_count];
+        if(!vproc->count)
+            continue;
+
+        EnterCriticalSection(&vproc->cs);
+        if(!vproc->count) {
+            LeaveCriticalSection(&vproc->cs);
+            continue;
+        }
+
+        if(!i) {
+            *task = vproc->tasks[(vproc->head + vproc->count - 1) % vproc->size];
+        } else {
+            *task = vproc->tasks[vproc->head];
+            vproc->head = (vproc->head + 1) % vproc->size;
+        }
+        vproc->count--;
+        LeaveCriticalSection(&vproc->cs);
+
+        InterlockedDecrement(&pool->pending);
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static void scheduler_run_task(ExternalContextBase *context, const struct scheduler_task *task)
+{
+    struct scheduler_list saved = context->scheduler;
+
+    /* the task sees the scheduler it was queued on as the current one */
+    context->scheduler.scheduler = &task->scheduler->scheduler;
+    context->scheduler.next = NULL;
+    call_Scheduler_Reference(context->scheduler.scheduler);
+
+    task->proc(task->data);
+
+    /* drop the task's scheduler and anything the task left attached */
+    scheduler_list_release(&context->scheduler);
+    context->scheduler = saved;
+    call_Scheduler_Release(&task->scheduler->scheduler);
+}
+
+/* A worker that comes back from blocking may share its virtual processor
+ * with the replacement that was started meanwhile. The first of them to
+ * finish its task leaves, so that no more than MaxConcurrency workers run. */
+static BOOL scheduler_pool_retire(struct scheduler_pool *pool, unsigned int index)
+{
+    struct scheduler_vproc *vproc = &pool->vprocs[index];
+    LONG workers, prev;
+
+    for(workers = vproc->workers; workers > 1; workers = prev) {
+        prev = InterlockedCompareExchange(&vproc->workers, workers - 1, workers);
+        if(prev == workers) {
+            InterlockedDecrement(&pool->workers);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+static DWORD WINAPI scheduler_worker_proc(void *arg)
+{
+    struct scheduler_worker *worker = arg;
+    struct scheduler_pool *pool = worker->pool;
+    unsigned int index = worker->vproc;
+    struct scheduler_task task;
+    ExternalContextBase *context;
+
+    TRACE("(%p %u)\n", pool, index);
+    MSVCRT_operator_delete(worker);
+
+    context = (ExternalContextBase*)get_current_context();
+    context->pool = pool;
+    context->vproc = index;
+
+    for(;;) {
+        if(scheduler_pool_retire(pool, index))
+            break;
+
+        if(scheduler_pool_take(pool, index, &task)) {
+            scheduler_run_task(context, &task);
+            continue;
+        }
+
+        EnterCriticalSection(&pool->cs);
+        InterlockedIncrement(&pool->idle);
+        if(!pool->pending) {
+            if(pool->shutdown) {
+                InterlockedDecrement(&pool->idle);
+                InterlockedDecrement(&pool->vprocs[index].workers);
+                InterlockedDecrement(&pool->workers);
+                LeaveCriticalSection(&pool->cs);
+                break;
+            }
+            SleepConditionVariableCS(&pool->cv, &pool->cs, INFINITE);
+        }
+        InterlockedDecrement(&pool->idle);
+        LeaveCriticalSection(&pool->cs);
+    }
+
+    context->pool = NULL;
+    scheduler_pool_release(pool);
+
+    TRACE("(%p %u) exiting\n", pool, index);
+    FreeLibraryAndExitThread(scheduler_module, 0);
+}
+
+static DWORD scheduler_pool_create_worker(struct scheduler_pool *pool, unsigned int index)
+{
+    struct scheduler_worker *worker;
+    HMODULE module;
+    HANDLE thread;
+    DWORD err;
+
+    worker = MSVCRT_operator_new(sizeof(*worker));
+    worker->pool = pool;
+    worker->vproc = index;
+    InterlockedIncrement(&pool->ref);
+
+    GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS,
+            (const WCHAR*)scheduler_worker_proc, &module);
+    thread = CreateThread(NULL, 0, scheduler_worker_proc, worker, 0, NULL);
+    if(!thread) {
+        err = GetLastError();
+        ERR("failed to create worker thread, error %u\n", err);
+        FreeLibrary(module);
+        MSVCRT_operator_delete(worker);
+        InterlockedDecrement(&pool->ref);
+        return err;
+    }
+    CloseHandle(thread);
+    return ERROR_SUCCESS;
+}
+
+/* Starts a worker on the virtual processor if it has none running. */
+static DWORD scheduler_pool_claim_vproc(struct scheduler_pool *pool, unsigned int index)
+{
+    DWORD err;
+
+    if(InterlockedCompareExchange(&pool->vprocs[index].workers, 1, 0))
+        return ERROR_BUSY;
+    InterlockedIncrement(&pool->workers);
+
+    if((err = scheduler_pool_create_worker(pool, index))) {
+        InterlockedDecrement(&pool->vprocs[index].workers);
+        InterlockedDecrement(&pool->workers);
+    }
+    return err;
+}
+
+static BOOL scheduler_pool_start_worker(struct scheduler_pool *pool)
+{
+    unsigned int i;
+    DWORD err;
+
+    for(i=0; i<pool->vproc_count && pool->workers<pool->vproc_count; i++) {
+        err = scheduler_pool_claim_vproc(pool, i);
+        if(err == ERROR_BUSY)
+            continue;
+        if(err && !pool->workers)
+            throw_exception(EXCEPTION_SCHEDULER_RESOURCE_ALLOCATION_ERROR,
+                    HRESULT_FROM_WIN32(err), NULL);
+        return !err;
+    }
+    return FALSE;
+}
+
+/* A blocked worker gives up its virtual processor, so that the pool can't
+ * run out of workers while all of them wait on each other. Queued work
+ * gets a replacement worker on the same virtual processor right away. */
+static void scheduler_pool_block(struct scheduler_pool *pool, unsigned int index)
+{
+    InterlockedDecrement(&pool->vprocs[index].workers);
+    InterlockedDecrement(&pool->workers);
+    if(pool->pending && !pool->idle)
+        scheduler_pool_claim_vproc(pool, index);
+}
+
+static void scheduler_pool_unblock(struct scheduler_pool *pool, unsigned int index)
+{
+    InterlockedIncrement(&pool->vprocs[index].workers);
+    InterlockedIncrement(&pool->workers);
+}
+
 static void ThreadScheduler_dtor(ThreadScheduler *this)
 {
     int i;
@@ -634,6 +1042,9 @@ static void ThreadScheduler_dtor(ThreadScheduler *this)
         SetEvent(this->shutdown_events[i]);
     MSVCRT_operator_delete(this->shutdown_events);
 
+    if(this->pool)
+        scheduler_pool_shutdown(this->pool);
+
     this->cs.DebugInfo->Spare[0] = 0;
     DeleteCriticalSection(&this->cs);
 }
@@ -742,18 +1153,68 @@ DEFINE_THISCALL_WRAPPER(ThreadScheduler_CreateScheduleGroup, 4)
     return NULL;
 }
 
+static void ThreadScheduler_schedule(ThreadScheduler *this,
+        void (__cdecl *proc)(void*), void *data)
+{
+    ExternalContextBase *context = (ExternalContextBase*)try_get_current_context();
+    struct scheduler_pool *pool = this->pool;
+    struct scheduler_task task;
+    unsigned int index;
+
+    if(!pool) {
+        BOOL created = FALSE;
+
+        EnterCriticalSection(&this->cs);
+        if(!this->pool) {
+            this->pool = scheduler_pool_create(this);
+            created = TRUE;
+        }
+        pool = this->pool;
+        LeaveCriticalSection(&this->cs);
+
+        /* keep MinConcurrency workers around from the start */
+        if(created)
+            while(pool->workers < pool->min_workers && scheduler_pool_start_worker(pool));
+    }
+
+    task.proc = proc;
+    task.data = data;
+    task.scheduler = this;
+    ThreadScheduler_Reference(this);
+
+    /* keep tasks spawned by a worker on its own virtual processor */
+    if(context && context->context.vtable == &MSVCRT_ExternalContextBase_vtable
+            && context->pool == pool)
+        index = context->vproc;
+    else
+        index = (unsigned int)InterlockedIncrement(&pool->next_vproc) % pool->vproc_count;
+
+    scheduler_vproc_push(&pool->vprocs[index], &task);
+    InterlockedIncrement(&pool->pending);
+
+    if(pool->idle) {
+        EnterCriticalSection(&pool->cs);
+        WakeConditionVariable(&pool->cv);
+        LeaveCriticalSection(&pool->cs);
+    } else {
+        scheduler_pool_start_worker(pool);
+    }
+}
+
 DEFINE_THISCALL_WRAPPER(ThreadScheduler_ScheduleTask_loc, 16)
 void __thiscall ThreadScheduler_ScheduleTask_loc(ThreadScheduler *this,
         void (__cdecl *proc)(void*), void* data, /*location*/void *placement)
 {
-    FIXME("(%p %p %p %p) stub\n", this, proc, data, placement);
+    TRACE("(%p %p %p %p) placement ignored\n", this, proc, data, placement);
+    ThreadScheduler_schedule(this, proc, data);
 }
 
 DEFINE_THISCALL_WRAPPER(ThreadScheduler_ScheduleTask, 12)
 void __thiscall ThreadScheduler_ScheduleTask(ThreadScheduler *this,
         void (__cdecl *proc)(void*), void* data)
 {
-    FIXME("(%p %p %p) stub\n", this, proc, data);
+    TRACE("(%p %p %p)\n", this, proc, data);
+    ThreadScheduler_schedule(this, proc, data);
 }
 
 DEFINE_THISCALL_WRAPPER(ThreadScheduler_IsAvailableLocation, 8)
@@ -803,6 +1264,7 @@ static ThreadScheduler* ThreadScheduler_ctor(ThreadScheduler *this,
 
     this->shutdown_count = this->shutdown_size = 0;
     this->shutdown_events = NULL;
+    this->pool = NULL;
 
     InitializeCriticalSection(&this->cs);
     this->cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": ThreadScheduler");
@@ -874,6 +1336,7 @@ void __cdecl CurrentScheduler_Detach(void)
         return;
     }
 
+    /* this also keeps tasks from detaching the scheduler they run on */
     if(!context->scheduler.next)
         throw_exception(EXCEPTION_IMPROPER_SCHEDULER_DETACH, 0, NULL);
 
@@ -1082,6 +1545,295 @@ void __cdecl _CurrentScheduler__ScheduleTask(void (__cdecl *proc)(void*), void *
 }
 
 extern const vtable_ptr MSVCRT_type_info_vtable;
+static void execute_chore(_UnrealizedChore *chore, _StructuredTaskCollection *collection)
+{
+    ExternalContextBase *context = (ExternalContextBase*)get_current_context();
+    _StructuredTaskCollection *prev;
+
+    if(context->context.vtable != &MSVCRT_ExternalContextBase_vtable) {
+        ERR("unknown context set\n");
+        context = NULL;
+    }
+
+    /* FIXME: exceptions thrown by the chore are not passed to _RunAndWait */
+    if(!collection->canceled) {
+        if(context) {
+            prev = context->task_collection;
+            context->task_collection = collection;
+        }
+        chore->chore_proc(chore);
+        if(context)
+            context->task_collection = prev;
+    }
+
+    if(chore->runtime_owns_lifetime)
+        call__UnrealizedChore_vector_dtor(chore, 1);
+}
+
+static void __cdecl chore_wrapper(_UnrealizedChore *chore)
+{
+    _StructuredTaskCollection *collection = chore->task_collection;
+    ExternalContextBase *context = (ExternalContextBase*)collection->context;
+
+    execute_chore(chore, collection);
+
+    /* the collection may be gone as soon as the count drops to zero */
+    if(!InterlockedDecrement(&collection->count))
+        ExternalContextBase_Unblock(context);
+}
+
+static void __cdecl chore_task(void *data)
+{
+    _UnrealizedChore *chore = data;
+    chore->chore_wrapper(chore);
+}
+
+static void task_collection_init(_StructuredTaskCollection *this)
+{
+    this->context = get_current_context();
+    this->count = 1;
+    this->canceled = FALSE;
+    this->exception = NULL;
+}
+
+static void task_collection_schedule(_StructuredTaskCollection *this, _UnrealizedChore *chore)
+{
+    Scheduler *scheduler = get_current_scheduler();
+
+    chore->task_collection = this;
+    chore->chore_wrapper = chore_wrapper;
+    InterlockedIncrement(&this->count);
+    call_Scheduler_ScheduleTask(scheduler, chore_task, chore);
+}
+
+static _TaskCollectionStatus task_collection_run_and_wait(
+        _StructuredTaskCollection *this, _UnrealizedChore *chore)
+{
+    ExternalContextBase *context = (ExternalContextBase*)this->context;
+    ThreadScheduler *scheduler = (ThreadScheduler*)get_current_scheduler();
+    struct scheduler_pool *pool = NULL;
+    struct scheduler_task task;
+    _TaskCollectionStatus status;
+    unsigned int index = 0;
+
+    if(chore) {
+        chore->task_collection = this;
+        execute_chore(chore, this);
+    }
+
+    /* run queued work on this thread instead of just waiting for it */
+    if(scheduler && scheduler->scheduler.vtable == &MSVCRT_ThreadScheduler_vtable)
+        pool = scheduler->pool;
+    if(pool && context->context.vtable == &MSVCRT_ExternalContextBase_vtable) {
+        if(context->pool == pool)
+            index = context->vproc;
+        while(this->count > 1 && scheduler_pool_take(pool, index, &task))
+            scheduler_run_task(context, &task);
+    }
+
+    /* the last chore to finish unblocks us */
+    if(InterlockedDecrement(&this->count))
+        Context_Block();
+
+    status = this->canceled ? TASK_COLLECTION_CANCELLED : TASK_COLLECTION_SUCCESS;
+    this->count = 1;
+    this->canceled = FALSE;
+    return status;
+}
+
+#if _MSVCR_VER >= 110
+/* ??0_StructuredTaskCollection@details@Concurrency@@QAE@PAV_CancellationTokenState@12@@Z */
+/* ??0_StructuredTaskCollection@details@Concurrency@@QEAA@PEAV_CancellationTokenState@12@@Z */
+DEFINE_THISCALL_WRAPPER(_StructuredTaskCollection_ctor, 8)
+_StructuredTaskCollection* __thiscall _StructuredTaskCollection_ctor(
+        _StructuredTaskCollection *this, /*_CancellationTokenState*/void *token)
+{
+    TRACE("(%p %p)\n", this, token);
+
+    if(token)
+        FIXME("cancellation tokens not supported\n");
+
+    this->unk1 = NULL;
+    this->unk2 = 0;
+    this->token = token;
+    this->context = NULL;
+    return this;
+}
+#endif
+
+#if _MSVCR_VER >= 120
+/* ??1_StructuredTaskCollection@details@Concurrency@@QAE@XZ */
+/* ??1_StructuredTaskCollection@details@Concurrency@@QEAA@XZ */
+DEFINE_THISCALL_WRAPPER(_StructuredTaskCollection_dtor, 4)
+void __thiscall _StructuredTaskCollection_dtor(_StructuredTaskCollection *this)
+{
+    TRACE("(%p)\n", this);
+
+    if(this->context && this->count > 1) {
+        WARN("destroying collection with unfinished chores\n");
+        task_collection_run_and_wait(this, NULL);
+    }
+}
+#endif
+
+/* ?_Schedule@_StructuredTaskCollection@details@Concurrency@@QAEXPAV_UnrealizedChore@23@@Z */
+/* ?_Schedule@_StructuredTaskCollection@details@Concurrency@@QEAAXPEAV_UnrealizedChore@23@@Z */
+DEFINE_THISCALL_WRAPPER(_StructuredTaskCollection__Schedule, 8)
+void __thiscall _StructuredTaskCollection__Schedule(
+        _StructuredTaskCollection *this, _UnrealizedChore *chore)
+{
+    TRACE("(%p %p)\n", this, chore);
+
+    if(!this->context)
+        task_collection_init(this);
+    task_collection_schedule(this, chore);
+}
+
+#if _MSVCR_VER >= 110
+/* ?_Schedule@_StructuredTaskCollection@details@Concurrency@@QAEXPAV_UnrealizedChore@23@PAVlocation@3@@Z */
+/* ?_Schedule@_StructuredTaskCollection@details@Concurrency@@QEAAXPEAV_UnrealizedChore@23@PEAVlocation@3@@Z */
+DEFINE_THISCALL_WRAPPER(_StructuredTaskCollection__Schedule_loc, 12)
+void __thiscall _StructuredTaskCollection__Schedule_loc(
+        _StructuredTaskCollection *this, _UnrealizedChore *chore,
+        /*location*/void *placement)
+{
+    TRACE("(%p %p %p) placement ignored\n", this, chore, placement);
+    _StructuredTaskCollection__Schedule(this, chore);
+}
+#endif
+
+/* ?_RunAndWait@_StructuredTaskCollection@details@Concurrency@@QAG?AW4_TaskCollectionStatus@23@PAV_UnrealizedChore@23@@Z */
+/* ?_RunAndWait@_StructuredTaskCollection@details@Concurrency@@QEAA?AW4_TaskCollectionStatus@23@PEAV_UnrealizedChore@23@@Z */
+_TaskCollectionStatus __stdcall _StructuredTaskCollection__RunAndWait(
+        _StructuredTaskCollection *this, _UnrealizedChore *chore)
+{
+    _TaskCollectionStatus status;
+
+    TRACE("(%p %p)\n", this, chore);
+
+    if(!this->context)
+        task_collection_init(this);
+    status = task_collection_run_and_wait(this, chore);
+    this->context = NULL;
+    return status;
+}
+
+/* ?_Cancel@_StructuredTaskCollection@details@Concurrency@@QAEXXZ */
+/* ?_Cancel@_StructuredTaskCollection@details@Concurrency@@QEAAXXZ */
+DEFINE_THISCALL_WRAPPER(_StructuredTaskCollection__Cancel, 4)
+void __thiscall _StructuredTaskCollection__Cancel(_StructuredTaskCollection *this)
+{
+    TRACE("(%p)\n", this);
+
+    if(!this->context)
+        task_collection_init(this);
+    this->canceled = TRUE;
+}
+
+/* ?_IsCanceling@_StructuredTaskCollection@details@Concurrency@@QAE_NXZ */
+/* ?_IsCanceling@_StructuredTaskCollection@details@Concurrency@@QEAA_NXZ */
+DEFINE_THISCALL_WRAPPER(_StructuredTaskCollection__IsCanceling, 4)
+MSVCRT_bool __thiscall _StructuredTaskCollection__IsCanceling(_StructuredTaskCollection *this)
+{
+    TRACE("(%p)\n", this);
+    return this->context && this->canceled;
+}
+
+/* ??0_TaskCollection@details@Concurrency@@QAE@XZ */
+/* ??0_TaskCollection@details@Concurrency@@QEAA@XZ */
+DEFINE_THISCALL_WRAPPER(_TaskCollection_ctor, 4)
+_TaskCollection* __thiscall _TaskCollection_ctor(_TaskCollection *this)
+{
+    TRACE("(%p)\n", this);
+
+    this->unk1 = NULL;
+    this->unk2 = 0;
+#if _MSVCR_VER >= 110
+    this->token = NULL;
+#endif
+    task_collection_init(this);
+    return this;
+}
+
+#if _MSVCR_VER >= 110
+/* ??0_TaskCollection@details@Concurrency@@QAE@PAV_CancellationTokenState@12@@Z */
+/* ??0_TaskCollection@details@Concurrency@@QEAA@PEAV_CancellationTokenState@12@@Z */
+DEFINE_THISCALL_WRAPPER(_TaskCollection_ctor_token, 8)
+_TaskCollection* __thiscall _TaskCollection_ctor_token(
+        _TaskCollection *this, /*_CancellationTokenState*/void *token)
+{
+    TRACE("(%p %p)\n", this, token);
+
+    if(token)
+        FIXME("cancellation tokens not supported\n");
+
+    _TaskCollection_ctor(this);
+    this->token = token;
+    return this;
+}
+#endif
+
+/* ??1_TaskCollection@details@Concurrency@@QAE@XZ */
+/* ??1_TaskCollection@details@Concurrency@@QEAA@XZ */
+DEFINE_THISCALL_WRAPPER(_TaskCollection_dtor, 4)
+void __thiscall _TaskCollection_dtor(_TaskCollection *this)
+{
+    TRACE("(%p)\n", this);
+
+    if(this->count > 1) {
+        WARN("destroying collection with unfinished chores\n");
+        task_collection_run_and_wait(this, NULL);
+    }
+}
+
+/* ?_Schedule@_TaskCollection@details@Concurrency@@QAEXPAV_UnrealizedChore@23@@Z */
+/* ?_Schedule@_TaskCollection@details@Concurrency@@QEAAXPEAV_UnrealizedChore@23@@Z */
+DEFINE_THISCALL_WRAPPER(_TaskCollection__Schedule, 8)
+void __thiscall _TaskCollection__Schedule(_TaskCollection *this, _UnrealizedChore *chore)
+{
+    TRACE("(%p %p)\n", this, chore);
+    task_collection_schedule(this, chore);
+}
+
+#if _MSVCR_VER >= 110
+/* ?_Schedule@_TaskCollection@details@Concurrency@@QAEXPAV_UnrealizedChore@23@PAVlocation@3@@Z */
+/* ?_Schedule@_TaskCollection@details@Concurrency@@QEAAXPEAV_UnrealizedChore@23@PEAVlocation@3@@Z */
+DEFINE_THISCALL_WRAPPER(_TaskCollection__Schedule_loc, 12)
+void __thiscall _TaskCollection__Schedule_loc(_TaskCollection *this,
+        _UnrealizedChore *chore, /*location*/void *placement)
+{
+    TRACE("(%p %p %p) placement ignored\n", this, chore, placement);
+    task_collection_schedule(this, chore);
+}
+#endif
+
+/* ?_RunAndWait@_TaskCollection@details@Concurrency@@QAG?AW4_TaskCollectionStatus@23@PAV_UnrealizedChore@23@@Z */
+/* ?_RunAndWait@_TaskCollection@details@Concurrency@@QEAA?AW4_TaskCollectionStatus@23@PEAV_UnrealizedChore@23@@Z */
+_TaskCollectionStatus __stdcall _TaskCollection__RunAndWait(
+        _TaskCollection *this, _UnrealizedChore *chore)
+{
+    TRACE("(%p %p)\n", this, chore);
+    return task_collection_run_and_wait(this, chore);
+}
+
+/* ?_Cancel@_TaskCollection@details@Concurrency@@QAEXXZ */
+/* ?_Cancel@_TaskCollection@details@Concurrency@@QEAAXXZ */
+DEFINE_THISCALL_WRAPPER(_TaskCollection__Cancel, 4)
+void __thiscall _TaskCollection__Cancel(_TaskCollection *this)
+{
+    TRACE("(%p)\n", this);
+    this->canceled = TRUE;
+}
+
+/* ?_IsCanceling@_TaskCollection@details@Concurrency@@QAE_NXZ */
+/* ?_IsCanceling@_TaskCollection@details@Concurrency@@QEAA_NXZ */
+DEFINE_THISCALL_WRAPPER(_TaskCollection__IsCanceling, 4)
+MSVCRT_bool __thiscall _TaskCollection__IsCanceling(_TaskCollection *this)
+{
+    TRACE("(%p)\n", this);
+    return this->canceled;
+}
+
 DEFINE_RTTI_DATA0(Context, 0, ".?AVContext@Concurrency@@")
 DEFINE_RTTI_DATA1(ContextBase, 0, &Context_rtti_base_descriptor, ".?AVContextBase@details@Concurrency@@")
 DEFINE_RTTI_DATA2(ExternalContextBase, 0, &ContextBase_rtti_base_descriptor,
@@ -1128,6 +1880,7 @@ void __asm_dummy_vtables(void) {
 
 void msvcrt_init_scheduler(void *base)
 {
+    scheduler_module = base;
 #ifdef __x86_64__
     init_Context_rtti(base);
     init_ContextBase_rtti(base);
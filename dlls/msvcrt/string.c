@@ -307,6 +307,12 @@ void CDECL MSVCRT__swab(char* src, char* dst, int len)
   }
 }
 
+/* powers of ten that are exactly representable as a double */
+static const double exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
 static double strtod_helper(const char *str, char **end, MSVCRT__locale_t locale, int *err)
 {
     MSVCRT_pthreadlocinfo locinfo;
@@ -457,6 +463,27 @@ static double strtod_helper(const char *str, char **end, MSVCRT__locale_t locale
     _control87(MSVCRT__EM_DENORMAL|MSVCRT__EM_INVALID|MSVCRT__EM_ZERODIVIDE
             |MSVCRT__EM_OVERFLOW|MSVCRT__EM_UNDERFLOW|MSVCRT__EM_INEXACT, 0xffffffff);
 
+    /* When both the mantissa and the power of ten are exact doubles, a single
+     * multiplication or division gives the correctly rounded result, as long
+     * as it is rounded to double precision. */
+    if(base == 10 && d <= (ULONGLONG)1 << 53 && exp >= -22 && exp <= 22) {
+#if defined(__i386__) && !defined(__SSE2_MATH__)
+        _control87(MSVCRT__PC_53, MSVCRT__MCW_PC);
+#endif
+        ret = d;
+        if(exp < 0)
+            ret /= exact_pow10[-exp];
+        else
+            ret *= exact_pow10[exp];
+        ret = sign * ret;
+
+        _control87(fpcontrol, 0xffffffff);
+
+        if(end)
+            *end = (char*)p;
+        return ret;
+    }
+
     negexp = (exp < 0);
     if(negexp)
         exp = -exp;
@@ -1902,8 +1929,19 @@ int __cdecl MSVCRT__strnicmp_l(const char *s1, const char *s2,
         return strncasecmp(s1, s2, count);
 
     do {
-        c1 = MSVCRT__tolower_l(*s1++, locale);
-        c2 = MSVCRT__tolower_l(*s2++, locale);
+        c1 = *s1++;
+        c2 = *s2++;
+        /* identical characters compare equal in every locale */
+        if(c1 == c2)
+            continue;
+
+        if(c1 >= 0 && c2 >= 0) {
+            c1 = locinfo->pclmap[c1];
+            c2 = locinfo->pclmap[c2];
+        } else {
+            c1 = MSVCRT__tolower_l(c1, locale);
+            c2 = MSVCRT__tolower_l(c2, locale);
+        }
     }while(--count && c1 && c1==c2);
 
     return c1-c2;
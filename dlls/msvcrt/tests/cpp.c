@@ -1328,6 +1328,7 @@ static void test_demangle(void)
     };
     int i, num_test = (sizeof(test)/sizeof(test[0]));
     char* name;
+    char buf[256];
 
     for (i = 0; i < num_test; i++)
     {
@@ -1342,13 +1343,67 @@ static void test_demangle(void)
            "%u: Expected \"%s\"\n", i, test[i].out );
         pfree(name);
     }
+
+    /* demangling into a caller supplied buffer */
+    memset(buf, 'x', sizeof(buf));
+    name = p__unDName(buf, test[130].in, sizeof(buf), pmalloc, pfree, test[130].flags);
+    ok(name == buf, "name = %p, expected %p\n", name, buf);
+    ok(!strcmp_space(test[130].out, buf), "Got name \"%s\"\n", buf);
+
+    /* the same name demangled again with different flags */
+    for (i = 126; i <= 128; i++)
+    {
+        name = p__unDName(0, test[i].in, 0, pmalloc, pfree, test[i].flags);
+        ok(name != NULL, "%u: unDName failed\n", i);
+        if (!name) continue;
+        ok( !strcmp_space(test[i].out, name) ||
+            broken(test[i].broken && !strcmp_space(test[i].broken, name)),
+           "%u: Got name \"%s\"\n", i, name );
+        pfree(name);
+    }
+}
+
+/* Run with "msvcrt_test.exe cpp bench [iterations]". */
+static void benchmark_demangle(unsigned int iterations)
+{
+    static const char * const names[] =
+    {
+        "?swprintf@@YAHPA_WIPB_WZZ",
+        "??Xstd@@YAAEAV?$complex@M@0@AEAV10@AEBV10@@Z",
+        "?_Doraise@bad_cast@std@@MEBAXXZ",
+        "??$run@XVTask_Render_Preview@@@QtConcurrent@@YA?AV?$QFuture@X@@PEAVTask_Render_Preview@@P82@EAAXXZ@Z",
+        "??_E?$TStrArray@$$BY0BAA@D$0BA@@@UAEPAXI@Z",
+        "?f@T@@QAEHQAY2BE@BO@CI@D@Z",
+    };
+    LARGE_INTEGER start, end, freq;
+    unsigned int i, j;
+    char buf[1024];
+
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < iterations; i++)
+        for (j = 0; j < sizeof(names) / sizeof(names[0]); j++)
+            p__unDName(buf, names[j], sizeof(buf), pmalloc, pfree, 0);
+    QueryPerformanceCounter(&end);
+    trace("%u names demangled in %.3f ms.\n", iterations * (unsigned int)(sizeof(names) / sizeof(names[0])),
+          (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart);
 }
 
 START_TEST(cpp)
 {
+  char **argv;
+  int argc;
+
   if (!InitFunctionPtrs())
     return;
 
+  argc = winetest_get_mainargs(&argv);
+  if (argc >= 3 && !strcmp(argv[2], "bench"))
+  {
+    benchmark_demangle(argc >= 4 ? atoi(argv[3]) : 100000);
+    return;
+  }
+
   test_exception();
   test_bad_typeid();
   test_bad_cast();
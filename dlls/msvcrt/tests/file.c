@@ -467,6 +467,52 @@ static void test_asciimode2(void)
     unlink("ascii2.tst");
 }
 
+static void test_asciimode_bulk(void)
+{
+    static const int sizes[] = { 100, 5000, 20000 };
+    char *obuf, *ibuf;
+    int fd, i, j, k, n, lf;
+
+    obuf = malloc(20000);
+    ibuf = malloc(40000);
+    for (k = 0; k < sizeof(sizes)/sizeof(sizes[0]); k++)
+    {
+        /* lines of varying length, including empty ones and a lone \r */
+        for (i = 0, lf = 0; i < sizes[k]; i++)
+        {
+            obuf[i] = i % 37 == 0 || i % 5 == 0 ? '\n' : 'a' + i % 26;
+            if (i == 3) obuf[i] = '\r';
+            if (obuf[i] == '\n') lf++;
+        }
+
+        fd = _open("ascii3.tst", _O_WRONLY | _O_CREAT | _O_TRUNC | _O_TEXT, _S_IREAD | _S_IWRITE);
+        ok(fd != -1, "_open failed\n");
+        n = _write(fd, obuf, sizes[k]);
+        ok(n == sizes[k], "_write returned %d, expected %d\n", n, sizes[k]);
+        _close(fd);
+
+        fd = _open("ascii3.tst", _O_RDONLY | _O_BINARY);
+        n = _read(fd, ibuf, 40000);
+        ok(n == sizes[k] + lf, "binary _read returned %d, expected %d\n", n, sizes[k] + lf);
+        for (i = 0, j = 0; i < sizes[k] && j < n; i++, j++)
+        {
+            if (obuf[i] == '\n' && ibuf[j++] != '\r') break;
+            if (ibuf[j] != obuf[i]) break;
+        }
+        ok(i == sizes[k], "data differs at %d\n", i);
+        _close(fd);
+
+        fd = _open("ascii3.tst", _O_RDONLY | _O_TEXT);
+        for (n = 0; (i = _read(fd, ibuf + n, 1000)) > 0; n += i);
+        ok(n == sizes[k], "text _read returned %d, expected %d\n", n, sizes[k]);
+        ok(!memcmp(ibuf, obuf, sizes[k]), "text data differs\n");
+        _close(fd);
+    }
+    unlink("ascii3.tst");
+    free(obuf);
+    free(ibuf);
+}
+
 static void test_filemodeT(void)
 {
     char DATA  [] = {26, 't', 'e', 's' ,'t'};
@@ -2482,6 +2528,7 @@ START_TEST(file)
     test_fileops();
     test_asciimode();
     test_asciimode2();
+    test_asciimode_bulk();
     test_filemodeT();
     test_readmode(FALSE); /* binary mode */
     test_readmode(TRUE);  /* ascii mode */
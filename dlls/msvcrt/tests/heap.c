@@ -479,6 +479,109 @@ static void test_calloc(void)
     free(ptr);
 }
 
+static DWORD WINAPI free_thread(void *arg)
+{
+    void **blocks = arg;
+    int i;
+
+    for (i = 0; i < 100; i++)
+        free(blocks[i]);
+    return 0;
+}
+
+static void test_reuse(void)
+{
+    static const size_t sizes[] = { 8, 24, 100, 256, 300 };
+    void *blocks[200];
+    unsigned char *p;
+    HANDLE thread;
+    size_t i, j, k;
+
+    for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            for (j = 0; j < 200; j++)
+            {
+                blocks[j] = malloc(sizes[i] + (j & 1));
+                ok(blocks[j] != NULL, "malloc failed\n");
+                memset(blocks[j], 0xcc, sizes[i] + (j & 1));
+            }
+            for (j = 0; j < 200; j++)
+                free(blocks[j]);
+        }
+
+        for (j = 0; j < 200; j++)
+        {
+            p = blocks[j] = calloc(1, sizes[i] + (j & 1));
+            ok(p != NULL, "calloc failed\n");
+            ok(_msize(p) == sizes[i] + (j & 1), "_msize returned %lu, expected %lu\n",
+                    (unsigned long)_msize(p), (unsigned long)(sizes[i] + (j & 1)));
+            for (k = 0; k < sizes[i] + (j & 1); k++)
+                if (p[k]) break;
+            ok(k == sizes[i] + (j & 1), "byte %lu not zeroed\n", (unsigned long)k);
+        }
+
+        /* blocks freed by another thread */
+        thread = CreateThread(NULL, 0, free_thread, blocks, 0, NULL);
+        WaitForSingleObject(thread, INFINITE);
+        CloseHandle(thread);
+        for (j = 100; j < 200; j++)
+            free(blocks[j]);
+    }
+}
+
+static HANDLE walk_freed, walk_done;
+
+static DWORD WINAPI free_and_wait_thread(void *arg)
+{
+    free_thread(arg);
+    SetEvent(walk_freed);
+    WaitForSingleObject(walk_done, INFINITE);
+    return 0;
+}
+
+static void test_heapwalk(void)
+{
+    struct _heapinfo info;
+    void *blocks[100], *used;
+    BOOL found_used = FALSE;
+    HANDLE thread;
+    int i, ret;
+
+    used = malloc(24);
+    for (i = 0; i < 100; i++)
+        blocks[i] = malloc(24);
+
+    /* blocks still held by another thread's cache don't show up as used */
+    walk_freed = CreateEventA(NULL, FALSE, FALSE, NULL);
+    walk_done = CreateEventA(NULL, FALSE, FALSE, NULL);
+    thread = CreateThread(NULL, 0, free_and_wait_thread, blocks, 0, NULL);
+    WaitForSingleObject(walk_freed, INFINITE);
+
+    memset(&info, 0, sizeof(info));
+    while ((ret = _heapwalk(&info)) == _HEAPOK)
+    {
+        if (info._useflag != _USEDENTRY) continue;
+        if (info._pentry == used)
+        {
+            found_used = TRUE;
+            ok(info._size >= 24, "got size %lu\n", (unsigned long)info._size);
+        }
+        for (i = 0; i < 100; i++)
+            ok(info._pentry != blocks[i], "freed block %p reported as used\n", blocks[i]);
+    }
+    ok(ret == _HEAPEND, "_heapwalk returned %d\n", ret);
+    ok(found_used, "block %p not found\n", used);
+
+    SetEvent(walk_done);
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+    CloseHandle(walk_freed);
+    CloseHandle(walk_done);
+    free(used);
+}
+
 START_TEST(heap)
 {
     void *mem;
@@ -502,6 +605,9 @@ START_TEST(heap)
     free(mem);
 
     test_aligned();
+    /* before test_sbheap, which enables the small-block heap on 32-bit */
+    test_reuse();
+    test_heapwalk();
     test_sbheap();
     test_calloc();
 }
@@ -770,6 +770,22 @@ static void test_sprintf( void )
     ok(r==10, "r = %d\n", r);
     ok(!strcmp(buffer, "0000001.#J"), "failed: \"%s\"\n", buffer);
 
+    r = sprintf(buffer, "%.2f", 2.675);
+    ok(r==4, "r = %d\n", r);
+    ok(!strcmp(buffer, "2.67"), "failed: \"%s\"\n", buffer);
+    r = sprintf(buffer, "%.3f", 9.9996);
+    ok(r==6, "r = %d\n", r);
+    ok(!strcmp(buffer, "10.000"), "failed: \"%s\"\n", buffer);
+    r = sprintf(buffer, "%#.0f", 42.0);
+    ok(r==3, "r = %d\n", r);
+    ok(!strcmp(buffer, "42."), "failed: \"%s\"\n", buffer);
+    r = sprintf(buffer, "%08.1f", -1234.56);
+    ok(r==8, "r = %d\n", r);
+    ok(!strcmp(buffer, "-01234.6"), "failed: \"%s\"\n", buffer);
+    r = sprintf(buffer, "%f", 1e18);
+    ok(r==26, "r = %d\n", r);
+    ok(!strcmp(buffer, "1000000000000000000.000000"), "failed: \"%s\"\n", buffer);
+
     format = "%c";
     r = sprintf(buffer, format, 'a');
     ok(r==1, "r = %d\n", r);
@@ -96,6 +96,11 @@ static double (__cdecl *p__atof_l)(const char*,_locale_t);
 static double (__cdecl *p__strtod_l)(const char *,char**,_locale_t);
 static int (__cdecl *p__strnset_s)(char*,size_t,int,size_t);
 static int (__cdecl *p__wcsset_s)(wchar_t*,size_t,wchar_t);
+static size_t (__cdecl *p_wcslen)(const wchar_t*);
+static wchar_t* (__cdecl *p_wcschr)(const wchar_t*,wchar_t);
+static int (__cdecl *p_wcsncmp)(const wchar_t*,const wchar_t*,size_t);
+static wchar_t* (__cdecl *p_wcsncpy)(wchar_t*,const wchar_t*,size_t);
+static int (__cdecl *p__strnicmp)(const char*,const char*,size_t);
 
 #define SETNOFAIL(x,y) x = (void*)GetProcAddress(hMsvcrt,y)
 #define SET(x,y) SETNOFAIL(x,y); ok(x != NULL, "Export '%s' not found\n", y)
@@ -1773,6 +1778,16 @@ static void test__strtod(void)
     d = strtod("12.1d2", NULL);
     ok(almost_equal(d, 12.1e2), "d = %lf\n", d);
 
+    d = strtod("0.1", NULL);
+    ok(d == 0.1, "d = %.17g\n", d);
+    d = strtod("-123.456", NULL);
+    ok(d == -123.456, "d = %.17g\n", d);
+    d = strtod("9007199254740992e-22", NULL);
+    ok(d == 9007199254740992e-22, "d = %.17g\n", d);
+    /* rounding to extended precision first gives the wrong result */
+    d = strtod("6096572724321746e-18", NULL);
+    ok(d == 6096572724321746e-18, "d = %.17g\n", d);
+
     d = strtod(white_chars, &end);
     ok(almost_equal(d, 0), "d = %lf\n", d);
     ok(end == white_chars, "incorrect end (%d)\n", (int)(end-white_chars));
@@ -2868,6 +2883,77 @@ static void test__stricmp(void)
     setlocale(LC_ALL, "C");
 }
 
+static void test_wcs_random(void)
+{
+    wchar_t buf1[96], buf2[96], dst[96];
+    const wchar_t *s1, *s2, *p;
+    char str1[64], str2[64];
+    size_t len, n, i, exp_len;
+    int iter, ret, exp;
+    wchar_t ch;
+
+    /* compare against straightforward implementations at all alignments
+     * and lengths around the word size */
+    srand(0x1234);
+    for(iter=0; iter<2000; iter++) {
+        s1 = buf1 + rand() % 8;
+        s2 = buf2 + rand() % 8;
+        len = rand() % 64;
+
+        for(i=0; i<len; i++)
+            ((wchar_t*)s1)[i] = rand() % 4 ? 'a' + rand() % 4 : 1 + rand() % 0xfffe;
+        ((wchar_t*)s1)[len] = 0;
+        memcpy((wchar_t*)s2, s1, (len + 1) * sizeof(*s1));
+        if(len && rand() % 2)
+            ((wchar_t*)s2)[rand() % len] ^= 1 << (rand() % 16);
+
+        for(exp_len=0; s1[exp_len]; exp_len++);
+        n = p_wcslen(s1);
+        ok(n == exp_len, "%d: wcslen returned %u, expected %u\n", iter, (int)n, (int)exp_len);
+
+        ch = rand() % 2 ? 'a' + rand() % 6 : 0;
+        for(p=s1; *p && *p!=ch; p++);
+        if(*p != ch) p = NULL;
+        ok(p_wcschr(s1, ch) == p, "%d: wcschr(%x) returned %p, expected %p\n",
+                iter, ch, p_wcschr(s1, ch), p);
+
+        n = rand() % 72;
+        for(i=0, exp=0; i<n; i++) {
+            exp = s1[i] - s2[i];
+            if(exp || !s1[i]) break;
+        }
+        ret = p_wcsncmp(s1, s2, n);
+        ok((ret < 0) == (exp < 0) && (ret > 0) == (exp > 0),
+                "%d: wcsncmp returned %d, expected %d\n", iter, ret, exp);
+
+        n = rand() % 72;
+        memset(dst, 0xcc, sizeof(dst));
+        ok(p_wcsncpy(dst, s1, n) == dst, "%d: wcsncpy returned wrong pointer\n", iter);
+        for(i=0; i<n; i++) {
+            if(dst[i] != (i < exp_len ? s1[i] : 0)) break;
+        }
+        ok(i == n && dst[n] == 0xcccc, "%d: wcsncpy wrote %x at %u\n", iter, dst[i], (int)i);
+
+        len = rand() % 32;
+        for(i=0; i<len; i++)
+            str1[i] = "aAbBzZ@[`{"[rand() % 10];
+        str1[len] = 0;
+        for(i=0; i<=len; i++)
+            str2[i] = rand() % 2 ? toupper(str1[i]) : tolower(str1[i]);
+        if(len && rand() % 2)
+            str2[rand() % len] = "aAbBzZ@[`{"[rand() % 10];
+        n = rand() % 40;
+        for(i=0, exp=0; i<n; i++) {
+            exp = tolower(str1[i]) - tolower(str2[i]);
+            if(exp || !str1[i]) break;
+        }
+        ret = p__strnicmp(str1, str2, n);
+        ok((ret < 0) == (exp < 0) && (ret > 0) == (exp > 0),
+                "%d: _strnicmp(%s, %s, %u) returned %d, expected %d\n",
+                iter, str1, str2, (int)n, ret, exp);
+    }
+}
+
 static void test__wcstoi64(void)
 {
     static const WCHAR digit[] = { '9', 0 };
@@ -3270,6 +3356,11 @@ START_TEST(string)
     p__strtod_l = (void*)GetProcAddress(hMsvcrt, "_strtod_l");
     p__strnset_s = (void*)GetProcAddress(hMsvcrt, "_strnset_s");
     p__wcsset_s = (void*)GetProcAddress(hMsvcrt, "_wcsset_s");
+    SET(p_wcslen, "wcslen");
+    SET(p_wcschr, "wcschr");
+    SET(p_wcsncmp, "wcsncmp");
+    SET(p_wcsncpy, "wcsncpy");
+    SET(p__strnicmp, "_strnicmp");
 
     /* MSVCRT memcpy behaves like memmove for overlapping moves,
        MFC42 CString::Insert seems to rely on that behaviour */
@@ -3323,6 +3414,7 @@ START_TEST(string)
     test_wctomb();
     test__atodbl();
     test__stricmp();
+    test_wcs_random();
     test__wcstoi64();
     test_atoi();
     test_atof();
@@ -78,6 +78,7 @@ struct parsed_symbol
 
     void*               alloc_list;     /* linked list of allocated blocks */
     unsigned            avail_in_first; /* number of available bytes in head block */
+    void*               first_block;    /* initial block, not allocated with mem_alloc_ptr */
 };
 
 /* Type for parsing mangled types */
@@ -89,6 +90,9 @@ struct datatype_t
 
 static BOOL symbol_demangle(struct parsed_symbol* sym);
 
+#define BLOCK_SIZE      1024
+#define AVAIL_SIZE      (1024 - sizeof(void*))
+
 /******************************************************************
  *		und_alloc
  *
@@ -100,9 +104,6 @@ static void*    und_alloc(struct parsed_symbol* sym, unsigned int len)
 {
     void*       ptr;
 
-#define BLOCK_SIZE      1024
-#define AVAIL_SIZE      (1024 - sizeof(void*))
-
     if (len > AVAIL_SIZE)
     {
         /* allocate a specific block */
@@ -129,8 +130,6 @@ static void*    und_alloc(struct parsed_symbol* sym, unsigned int len)
         sym->avail_in_first -= len;
     }
     return ptr;
-#undef BLOCK_SIZE
-#undef AVAIL_SIZE
 }
 
 /******************************************************************
@@ -145,7 +144,8 @@ static void und_free_all(struct parsed_symbol* sym)
     while (sym->alloc_list)
     {
         next = *(void**)sym->alloc_list;
-        if(sym->mem_free_ptr) sym->mem_free_ptr(sym->alloc_list);
+        if(sym->mem_free_ptr && sym->alloc_list != sym->first_block)
+            sym->mem_free_ptr(sym->alloc_list);
         sym->alloc_list = next;
     }
     sym->avail_in_first = 0;
@@ -1579,6 +1579,115 @@ done:
     return ret;
 }
 
+/* The same names tend to be undecorated over and over (dbghelp does it for
+ * every symbol lookup), so recent results are kept in a small direct mapped
+ * cache, indexed by a hash of the mangled name and the flags. */
+#define UNDNAME_CACHE_SIZE  256
+
+struct undname_cache_entry
+{
+    unsigned int        hash;
+    unsigned short      flags;
+    unsigned int        mangled_len;
+    char                data[1];        /* mangled name, then demangled name */
+};
+
+static struct undname_cache_entry *undname_cache[UNDNAME_CACHE_SIZE];
+
+static CRITICAL_SECTION undname_cache_cs;
+static CRITICAL_SECTION_DEBUG undname_cache_cs_debug =
+{
+    0, 0, &undname_cache_cs,
+    { &undname_cache_cs_debug.ProcessLocksList, &undname_cache_cs_debug.ProcessLocksList },
+      0, 0, { (DWORD_PTR)(__FILE__ ": undname_cache_cs") }
+};
+static CRITICAL_SECTION undname_cache_cs = { &undname_cache_cs_debug, -1, 0, 0, 0, 0 };
+
+static unsigned int undname_cache_hash(const char* mangled, unsigned short flags,
+                                       unsigned int* len)
+{
+    const char*         ptr;
+    unsigned int        hash = flags;
+
+    for (ptr = mangled; *ptr; ptr++)
+        hash = hash * 31 + (unsigned char)*ptr;
+    *len = ptr - mangled;
+    return hash;
+}
+
+/******************************************************************
+ *		undname_cache_get
+ *
+ * Copies the cached demangled name to result, which holds BLOCK_SIZE
+ * bytes. Only shorter names are put in the cache.
+ */
+static BOOL undname_cache_get(char* result, const char* mangled, unsigned int len,
+                              unsigned int hash, unsigned short flags)
+{
+    struct undname_cache_entry* entry;
+    BOOL                        found = FALSE;
+
+    EnterCriticalSection(&undname_cache_cs);
+    entry = undname_cache[hash % UNDNAME_CACHE_SIZE];
+    if (entry && entry->hash == hash && entry->flags == flags &&
+        entry->mangled_len == len && !memcmp(entry->data, mangled, len))
+    {
+        strcpy(result, entry->data + len + 1);
+        found = TRUE;
+    }
+    LeaveCriticalSection(&undname_cache_cs);
+    return found;
+}
+
+static void undname_cache_put(const char* result, const char* mangled, unsigned int len,
+                              unsigned int hash, unsigned short flags)
+{
+    struct undname_cache_entry* entry, *old;
+    unsigned int                result_len = strlen(result);
+
+    if (result_len >= BLOCK_SIZE) return;
+    entry = HeapAlloc(GetProcessHeap(), 0,
+                      FIELD_OFFSET(struct undname_cache_entry, data[len + result_len + 2]));
+    if (!entry) return;
+    entry->hash = hash;
+    entry->flags = flags;
+    entry->mangled_len = len;
+    memcpy(entry->data, mangled, len + 1);
+    memcpy(entry->data + len + 1, result, result_len + 1);
+
+    EnterCriticalSection(&undname_cache_cs);
+    old = undname_cache[hash % UNDNAME_CACHE_SIZE];
+    undname_cache[hash % UNDNAME_CACHE_SIZE] = entry;
+    LeaveCriticalSection(&undname_cache_cs);
+    HeapFree(GetProcessHeap(), 0, old);
+}
+
+static char* undname_copy_result(char* buffer, int buflen, const char* result,
+                                 malloc_func_t memget)
+{
+    if (buffer && buflen)
+    {
+        lstrcpynA( buffer, result, buflen);
+    }
+    else
+    {
+        buffer = memget(strlen(result) + 1);
+        if (buffer) strcpy(buffer, result);
+    }
+    return buffer;
+}
+
+void msvcrt_free_undname_cache(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < UNDNAME_CACHE_SIZE; i++)
+    {
+        HeapFree(GetProcessHeap(), 0, undname_cache[i]);
+        undname_cache[i] = NULL;
+    }
+}
+
 /*********************************************************************
  *		__unDNameEx (MSVCRT.@)
  *
@@ -1603,6 +1712,8 @@ char* CDECL __unDNameEx(char* buffer, const char* mangled, int buflen,
 {
     struct parsed_symbol        sym;
     const char*                 result;
+    void*                       first_block[BLOCK_SIZE / sizeof(void*)];
+    unsigned int                len, hash;
 
     TRACE("(%p,%s,%d,%p,%p,%p,%x)\n",
           buffer, debugstr_a(mangled), buflen, memget, memfree, unknown, flags);
@@ -1617,23 +1728,26 @@ char* CDECL __unDNameEx(char* buffer, const char* mangled, int buflen,
             UNDNAME_NO_MEMBER_TYPE | UNDNAME_NO_ALLOCATION_LANGUAGE |
             UNDNAME_NO_COMPLEX_TYPE;
 
+    /* the unknown callback may change the output, don't cache it */
+    hash = undname_cache_hash(mangled, flags, &len);
+    if (!unknown && undname_cache_get((char*)first_block, mangled, len, hash, flags))
+        return undname_copy_result(buffer, buflen, (char*)first_block, memget);
+
     sym.flags         = flags;
     sym.mem_alloc_ptr = memget;
     sym.mem_free_ptr  = memfree;
     sym.current       = mangled;
+    /* most names fit in one block, so start with one on the stack */
+    first_block[0]     = NULL;
+    sym.first_block    = first_block;
+    sym.alloc_list     = first_block;
+    sym.avail_in_first = AVAIL_SIZE;
     str_array_init( &sym.names );
     str_array_init( &sym.stack );
 
     result = symbol_demangle(&sym) ? sym.result : mangled;
-    if (buffer && buflen)
-    {
-        lstrcpynA( buffer, result, buflen);
-    }
-    else
-    {
-        buffer = memget(strlen(result) + 1);
-        if (buffer) strcpy(buffer, result);
-    }
+    if (!unknown) undname_cache_put(result, mangled, len, hash, flags);
+    buffer = undname_copy_result(buffer, buflen, result, memget);
 
     und_free_all(&sym);
 
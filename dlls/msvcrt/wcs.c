@@ -1905,18 +1905,63 @@ INT CDECL MSVCRT_wcscpy_s( MSVCRT_wchar_t* wcDest, MSVCRT_size_t numElement, con
     return 0;
 }
 
+/* The scanning helpers below look at a whole machine word of characters
+ * at a time.  Words are only read at aligned addresses, so a read never
+ * crosses into the page following the terminating null character. */
+#define WCS_WORD_CHARS (sizeof(ULONG_PTR) / sizeof(MSVCRT_wchar_t))
+#define WCS_WORD_ONES  (~(ULONG_PTR)0 / 0xffff)
+#define WCS_WORD_HIGHS (WCS_WORD_ONES << 15)
+
+static inline BOOL wcs_word_aligned(const MSVCRT_wchar_t *str)
+{
+    return !((ULONG_PTR)str & (sizeof(ULONG_PTR) - 1));
+}
+
+/* non-zero if any character of the word is null */
+static inline ULONG_PTR wcs_word_has_null(ULONG_PTR word)
+{
+    return (word - WCS_WORD_ONES) & ~word & WCS_WORD_HIGHS;
+}
+
+static MSVCRT_size_t wcs_scan(const MSVCRT_wchar_t *str, MSVCRT_size_t max_len,
+        MSVCRT_wchar_t ch, BOOL match)
+{
+    const MSVCRT_wchar_t *s = str, *end = str + max_len;
+    ULONG_PTR pattern = ch * WCS_WORD_ONES;
+
+    if (max_len > ~(MSVCRT_size_t)0 / sizeof(MSVCRT_wchar_t) - (ULONG_PTR)str / sizeof(MSVCRT_wchar_t))
+        end = (const MSVCRT_wchar_t *)~(ULONG_PTR)0;
+
+    if (!((ULONG_PTR)s & 1))
+    {
+        for (; s < end && !wcs_word_aligned(s); s++)
+            if (!*s || (match && *s == ch)) return s - str;
+
+        for (; end - s >= WCS_WORD_CHARS; s += WCS_WORD_CHARS)
+        {
+            ULONG_PTR word = *(const ULONG_PTR *)s;
+
+            if (wcs_word_has_null(word)) break;
+            if (match && wcs_word_has_null(word ^ pattern)) break;
+        }
+    }
+
+    for (; s < end; s++)
+        if (!*s || (match && *s == ch)) break;
+    return s - str;
+}
+
 /******************************************************************
  *		wcsncpy (MSVCRT.@)
  */
 MSVCRT_wchar_t* __cdecl MSVCRT_wcsncpy( MSVCRT_wchar_t* s1,
         const MSVCRT_wchar_t *s2, MSVCRT_size_t n )
 {
-    MSVCRT_size_t i;
+    MSVCRT_size_t i, len = wcs_scan(s2, n, 0, FALSE);
 
-    for(i=0; i<n; i++)
-        if(!(s1[i] = s2[i])) break;
-    for(; i<n; i++)
-        s1[i] = 0;
+    for(i=0; i<len; i++)
+        s1[i] = s2[i];
+    memset(s1 + len, 0, (n - len) * sizeof(*s1));
     return s1;
 }
 
@@ -2327,11 +2372,7 @@ MSVCRT_ulong __cdecl MSVCRT_wcstoul(const MSVCRT_wchar_t *s, MSVCRT_wchar_t **en
  */
 MSVCRT_size_t CDECL MSVCRT_wcsnlen(const MSVCRT_wchar_t *s, MSVCRT_size_t maxlen)
 {
-    MSVCRT_size_t i;
-
-    for (i = 0; i < maxlen; i++)
-        if (!s[i]) break;
-    return i;
+    return wcs_scan(s, maxlen, 0, FALSE);
 }
 
 /*********************************************************************
@@ -2371,7 +2412,8 @@ int CDECL MSVCRT_towlower(MSVCRT_wint_t c)
  */
 MSVCRT_wchar_t* CDECL MSVCRT_wcschr(const MSVCRT_wchar_t *str, MSVCRT_wchar_t ch)
 {
-    return strchrW(str, ch);
+    str += wcs_scan(str, ~(MSVCRT_size_t)0, ch, TRUE);
+    return *str == ch ? (MSVCRT_wchar_t *)str : NULL;
 }
 
 /***********************************************************************
@@ -2379,7 +2421,7 @@ MSVCRT_wchar_t* CDECL MSVCRT_wcschr(const MSVCRT_wchar_t *str, MSVCRT_wchar_t ch
  */
 int CDECL MSVCRT_wcslen(const MSVCRT_wchar_t *str)
 {
-    return strlenW(str);
+    return wcs_scan(str, ~(MSVCRT_size_t)0, 0, FALSE);
 }
 
 /*********************************************************************
@@ -2430,6 +2472,22 @@ __int64 CDECL MSVCRT__wtoi64(const MSVCRT_wchar_t *str)
  */
 int CDECL MSVCRT_wcsncmp(const MSVCRT_wchar_t *str1, const MSVCRT_wchar_t *str2, int n)
 {
+    if (n <= 0) return 0;
+
+    /* skip equal words when both strings share the same alignment */
+    if (!(((ULONG_PTR)str1 ^ (ULONG_PTR)str2) & (sizeof(ULONG_PTR) - 1)) && !((ULONG_PTR)str1 & 1))
+    {
+        for (; n && !wcs_word_aligned(str1); n--, str1++, str2++)
+            if (*str1 != *str2 || !*str1) return *str1 - *str2;
+
+        for (; n >= WCS_WORD_CHARS; n -= WCS_WORD_CHARS, str1 += WCS_WORD_CHARS, str2 += WCS_WORD_CHARS)
+        {
+            ULONG_PTR word = *(const ULONG_PTR *)str1;
+
+            if (word != *(const ULONG_PTR *)str2 || wcs_word_has_null(word)) break;
+        }
+        if (!n) return 0;
+    }
     return strncmpW(str1, str2, n);
 }
 
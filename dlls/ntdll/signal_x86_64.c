@@ -2317,15 +2317,78 @@ static RUNTIME_FUNCTION *find_function_info( ULONG64 pc, HMODULE module,
     return NULL;
 }
 
+/**********************************************************************
+ *           lookup_history_table
+ *
+ * Look for a function entry found by a previous lookup of the same stack walk.
+ */
+static RUNTIME_FUNCTION *lookup_history_table( ULONG64 pc, ULONG64 *base, UNWIND_HISTORY_TABLE *table )
+{
+    ULONG i;
+
+    if (!table || !table->Count || table->Count > UNWIND_HISTORY_TABLE_SIZE) return NULL;
+    if (pc < table->LowAddress || pc >= table->HighAddress) return NULL;
+
+    for (i = 0; i < table->Count; i++)
+    {
+        UNWIND_HISTORY_TABLE_ENTRY *entry = &table->Entry[i];
+
+        if (pc >= entry->ImageBase + entry->FunctionEntry->BeginAddress &&
+            pc < entry->ImageBase + entry->FunctionEntry->EndAddress)
+        {
+            *base = entry->ImageBase;
+            return entry->FunctionEntry;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************
+ *           add_history_table_entry
+ */
+static void add_history_table_entry( UNWIND_HISTORY_TABLE *table, ULONG64 base, RUNTIME_FUNCTION *func )
+{
+    ULONG64 low = base + func->BeginAddress, high = base + func->EndAddress;
+
+    if (!table || table->Count >= UNWIND_HISTORY_TABLE_SIZE) return;
+
+    if (!table->Count || low < table->LowAddress) table->LowAddress = low;
+    if (!table->Count || high > table->HighAddress) table->HighAddress = high;
+    table->Entry[table->Count].ImageBase = base;
+    table->Entry[table->Count].FunctionEntry = func;
+    table->Count++;
+}
+
+/**********************************************************************
+ *           init_history_table
+ */
+static inline void init_history_table( UNWIND_HISTORY_TABLE *table )
+{
+    table->Count = 0;
+    table->Search = UNWIND_HISTORY_TABLE_NONE;
+    table->LowAddress = ~(ULONG64)0;
+    table->HighAddress = 0;
+}
+
 /**********************************************************************
  *           lookup_function_info
+ *
+ * Function entries of PE modules are remembered in the history table, if any.
+ * On a cache hit the module is not looked up and is returned as NULL.
  */
-static RUNTIME_FUNCTION *lookup_function_info( ULONG64 pc, ULONG64 *base, LDR_MODULE **module )
+static RUNTIME_FUNCTION *lookup_function_info( ULONG64 pc, ULONG64 *base, LDR_MODULE **module,
+                                               UNWIND_HISTORY_TABLE *table )
 {
     RUNTIME_FUNCTION *func = NULL;
     struct dynamic_unwind_entry *entry;
     ULONG size;
 
+    if ((func = lookup_history_table( pc, base, table )))
+    {
+        *module = NULL;
+        return func;
+    }
+
     /* PE module or wine module */
     if (!LdrFindEntryForAddress( (void *)pc, module ))
     {
@@ -2335,6 +2398,7 @@ static RUNTIME_FUNCTION *lookup_function_info( ULONG64 pc, ULONG64 *base, LDR_MO
         {
             /* lookup in function table */
             func = find_function_info( pc, (*module)->BaseAddress, func, size );
+            if (func) add_history_table_entry( table, *base, func );
         }
     }
     else
@@ -2429,20 +2493,20 @@ static NTSTATUS call_stack_handlers( EXCEPTION_RECORD *rec, CONTEXT *orig_contex
     NTSTATUS status;
 
     context = *orig_context;
+    init_history_table( &table );
     dispatch.TargetIp      = 0;
     dispatch.ContextRecord = &context;
     dispatch.HistoryTable  = &table;
     for (;;)
     {
-        /* FIXME: should use the history table to make things faster */
-
         dispatch.ImageBase = 0;
         dispatch.ControlPc = context.Rip;
         dispatch.ScopeIndex = 0;
 
         /* first look for PE exception information */
 
-        if ((dispatch.FunctionEntry = lookup_function_info( dispatch.ControlPc, &dispatch.ImageBase, &module )))
+        if ((dispatch.FunctionEntry = lookup_function_info( dispatch.ControlPc, &dispatch.ImageBase,
+                                                            &module, &table )))
         {
             dispatch.LanguageHandler = RtlVirtualUnwind( UNW_FLAG_EHANDLER, dispatch.ImageBase,
                                                          dispatch.ControlPc, dispatch.FunctionEntry,
@@ -3245,9 +3309,7 @@ PRUNTIME_FUNCTION WINAPI RtlLookupFunctionEntry( ULONG64 pc, ULONG64 *base, UNWI
     LDR_MODULE *module;
     RUNTIME_FUNCTION *func;
 
-    /* FIXME: should use the history table to make things faster */
-
-    func = lookup_function_info( pc, base, &module );
+    func = lookup_function_info( pc, base, &module, table );
     if (!func)
     {
         *base = 0;
@@ -3751,6 +3813,7 @@ void WINAPI RtlUnwindEx( PVOID end_frame, PVOID target_ip, EXCEPTION_RECORD *rec
 {
     EXCEPTION_REGISTRATION_RECORD *teb_frame = NtCurrentTeb()->Tib.ExceptionList;
     EXCEPTION_RECORD record;
+    UNWIND_HISTORY_TABLE local_table;
     DISPATCHER_CONTEXT dispatch;
     CONTEXT new_context;
     LDR_MODULE *module;
@@ -3760,6 +3823,12 @@ void WINAPI RtlUnwindEx( PVOID end_frame, PVOID target_ip, EXCEPTION_RECORD *rec
     RtlCaptureContext( context );
     new_context = *context;
 
+    if (!table)
+    {
+        init_history_table( &local_table );
+        table = &local_table;
+    }
+
     /* build an exception record, if we do not have one */
     if (!rec)
     {
@@ -3793,15 +3862,14 @@ void WINAPI RtlUnwindEx( PVOID end_frame, PVOID target_ip, EXCEPTION_RECORD *rec
 
     for (;;)
     {
-        /* FIXME: should use the history table to make things faster */
-
         dispatch.ImageBase = 0;
         dispatch.ScopeIndex = 0;
         dispatch.ControlPc = context->Rip;
 
         /* first look for PE exception information */
 
-        if ((dispatch.FunctionEntry = lookup_function_info( context->Rip, &dispatch.ImageBase, &module )))
+        if ((dispatch.FunctionEntry = lookup_function_info( context->Rip, &dispatch.ImageBase,
+                                                            &module, table )))
         {
             dispatch.LanguageHandler = RtlVirtualUnwind( UNW_FLAG_UHANDLER, dispatch.ImageBase,
                                                          context->Rip, dispatch.FunctionEntry,
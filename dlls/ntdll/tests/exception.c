@@ -2110,6 +2110,27 @@ static void test_dynamic_unwind(void)
 
 }
 
+static void test_lookup_history_table(void)
+{
+    UNWIND_HISTORY_TABLE table;
+    RUNTIME_FUNCTION *func, *func2;
+    ULONG64 base, base2, pc = (ULONG_PTR)test_lookup_history_table;
+    int i;
+
+    func = pRtlLookupFunctionEntry( pc, &base, NULL );
+
+    /* repeated lookups through the same table must keep returning the same entry */
+    memset( &table, 0, sizeof(table) );
+    for (i = 0; i < 3; i++)
+    {
+        base2 = 0xdeadbeef;
+        func2 = pRtlLookupFunctionEntry( pc, &base2, &table );
+        ok( func2 == func, "%d: got %p, expected %p\n", i, func2, func );
+        if (func) ok( base2 == base, "%d: got base %lx, expected %lx\n", i, base2, base );
+        ok( table.Count <= UNWIND_HISTORY_TABLE_SIZE, "%d: got count %u\n", i, table.Count );
+    }
+}
+
 static int termination_handler_called;
 static void WINAPI termination_handler(ULONG flags, ULONG64 frame)
 {
@@ -2816,6 +2837,9 @@ START_TEST(exception)
     else
       skip( "Dynamic unwind functions not found\n" );
 
+    if (pRtlLookupFunctionEntry)
+      test_lookup_history_table();
+
 #endif
 
     VirtualFree(code_mem, 0, MEM_RELEASE);
@@ -59,6 +59,10 @@ static RTL_CRITICAL_SECTION vcomp_section = { &critsect_debug, -1, 0, 0, 0, 0 };
 #define VCOMP_DYNAMIC_FLAGS_GUIDED      0x03
 #define VCOMP_DYNAMIC_FLAGS_INCREMENT   0x40
 
+/* Number of pause iterations a thread spins on a barrier, on the end of a
+ * parallel region or for new work before going to sleep. */
+#define VCOMP_SPIN_COUNT                4000
+
 struct vcomp_thread_data
 {
     struct vcomp_team_data  *team;
@@ -88,7 +92,8 @@ struct vcomp_team_data
 {
     CONDITION_VARIABLE      cond;
     int                     num_threads;
-    int                     finished_threads;
+    LONG                    finished_threads;
+    unsigned int            spin_count;
 
     /* callback arguments */
     int                     nargs;
@@ -96,8 +101,8 @@ struct vcomp_team_data
     __ms_va_list            valist;
 
     /* barrier */
-    unsigned int            barrier;
-    int                     barrier_count;
+    LONG                    barrier;
+    LONG                    barrier_count;
 };
 
 struct vcomp_task_data
@@ -112,6 +117,7 @@ struct vcomp_task_data
 
     /* dynamic */
     unsigned int            dynamic;
+    LONGLONG                dynamic_state; /* generation and consumed iterations */
     unsigned int            dynamic_first;
     unsigned int            dynamic_last;
     unsigned int            dynamic_iterations;
@@ -379,6 +385,15 @@ static short interlocked_xchg_add16(short *dest, short incr)
 
 #endif  /* __GNUC__ */
 
+static inline void vcomp_spin_pause(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __asm__ __volatile__( "rep;nop" : : : "memory" );
+#else
+    __asm__ __volatile__( "" : : : "memory" );
+#endif
+}
+
 static inline struct vcomp_thread_data *vcomp_get_thread_data(void)
 {
     return (struct vcomp_thread_data *)TlsGetValue(vcomp_context_tls);
@@ -408,6 +423,7 @@ static struct vcomp_thread_data *vcomp_init_thread_data(void)
     data->task.single           = 0;
     data->task.section          = 0;
     data->task.dynamic          = 0;
+    data->task.dynamic_state    = 0;
 
     thread_data = &data->thread;
     thread_data->team           = NULL;
@@ -1054,25 +1070,38 @@ void CDECL _vcomp_flush(void)
 void CDECL _vcomp_barrier(void)
 {
     struct vcomp_team_data *team_data = vcomp_init_thread_data()->team;
+    unsigned int spin;
+    LONG barrier;
 
     TRACE("()\n");
 
     if (!team_data)
         return;
 
-    EnterCriticalSection(&vcomp_section);
-    if (++team_data->barrier_count >= team_data->num_threads)
+    /* The last thread to arrive resets the counter and starts the next
+     * barrier generation. The others spin on the generation for a while
+     * before they go to sleep. */
+    barrier = team_data->barrier;
+    if (InterlockedIncrement(&team_data->barrier_count) >= team_data->num_threads)
     {
-        team_data->barrier++;
-        team_data->barrier_count = 0;
+        InterlockedExchange(&team_data->barrier_count, 0);
+        EnterCriticalSection(&vcomp_section);
+        InterlockedIncrement(&team_data->barrier);
         WakeAllConditionVariable(&team_data->cond);
+        LeaveCriticalSection(&vcomp_section);
+        return;
     }
-    else
+
+    for (spin = team_data->spin_count; spin; spin--)
     {
-        unsigned int barrier = team_data->barrier;
-        while (team_data->barrier == barrier)
-            SleepConditionVariableCS(&team_data->cond, &vcomp_section, INFINITE);
+        if (team_data->barrier != barrier)
+            return;
+        vcomp_spin_pause();
     }
+
+    EnterCriticalSection(&vcomp_section);
+    while (team_data->barrier == barrier)
+        SleepConditionVariableCS(&team_data->cond, &vcomp_section, INFINITE);
     LeaveCriticalSection(&vcomp_section);
 }
 
@@ -1099,20 +1128,20 @@ int CDECL _vcomp_single_begin(int flags)
 {
     struct vcomp_thread_data *thread_data = vcomp_init_thread_data();
     struct vcomp_task_data *task_data = thread_data->task;
-    int ret = FALSE;
+    unsigned int single;
 
     TRACE("(%x): semi-stub\n", flags);
 
-    EnterCriticalSection(&vcomp_section);
     thread_data->single++;
-    if ((int)(thread_data->single - task_data->single) > 0)
+    do
     {
-        task_data->single = thread_data->single;
-        ret = TRUE;
+        single = task_data->single;
+        if ((int)(thread_data->single - single) <= 0)
+            return FALSE;
     }
-    LeaveCriticalSection(&vcomp_section);
+    while (InterlockedCompareExchange((LONG *)&task_data->single, thread_data->single, single) != single);
 
-    return ret;
+    return TRUE;
 }
 
 void CDECL _vcomp_single_end(void)
@@ -1344,6 +1373,15 @@ void CDECL _vcomp_for_dynamic_init(unsigned int flags, unsigned int first, unsig
         thread_data->dynamic_type = type;
         if ((int)(thread_data->dynamic - task_data->dynamic) > 0)
         {
+            LONGLONG state;
+
+            /* Switch to the new generation before changing the loop
+             * parameters, so threads still taking chunks of the previous
+             * loop fail to update the state. */
+            do state = task_data->dynamic_state;
+            while (InterlockedCompareExchange64(&task_data->dynamic_state,
+                    (LONGLONG)((ULONGLONG)thread_data->dynamic << 32), state) != state);
+
             task_data->dynamic              = thread_data->dynamic;
             task_data->dynamic_first        = first;
             task_data->dynamic_last         = last;
@@ -1374,26 +1412,49 @@ int CDECL _vcomp_for_dynamic_next(unsigned int *begin, unsigned int *end)
     else if (thread_data->dynamic_type == VCOMP_DYNAMIC_FLAGS_CHUNKED ||
              thread_data->dynamic_type == VCOMP_DYNAMIC_FLAGS_GUIDED)
     {
-        unsigned int iterations = 0;
-        EnterCriticalSection(&vcomp_section);
-        if (thread_data->dynamic == task_data->dynamic &&
-            task_data->dynamic_iterations != 0)
+        unsigned int first, last, total, chunksize, done, remaining, iterations;
+        LONGLONG state, prev;
+        int step;
+
+        /* The state holds the loop generation in the high and the number of
+         * iterations handed out in the low 32 bits, so a chunk is taken with
+         * a single compare-and-swap. The loop parameters are read before the
+         * swap, they may be replaced by the next loop right after it. */
+        state = *(volatile LONGLONG *)&task_data->dynamic_state;
+        for (;;)
         {
-            iterations = min(task_data->dynamic_iterations, task_data->dynamic_chunksize);
+            if ((unsigned int)((ULONGLONG)state >> 32) != thread_data->dynamic)
+                return 0;
+
+            first       = task_data->dynamic_first;
+            last        = task_data->dynamic_last;
+            total       = task_data->dynamic_iterations;
+            step        = task_data->dynamic_step;
+            chunksize   = task_data->dynamic_chunksize;
+
+            done = (unsigned int)state;
+            if (!(remaining = total - done))
+                return 0;
+
+            iterations = min(remaining, chunksize);
             if (thread_data->dynamic_type == VCOMP_DYNAMIC_FLAGS_GUIDED &&
-                task_data->dynamic_iterations > num_threads * task_data->dynamic_chunksize)
+                remaining > num_threads * chunksize)
             {
-                iterations = (task_data->dynamic_iterations + num_threads - 1) / num_threads;
+                iterations = (remaining + num_threads - 1) / num_threads;
             }
-            *begin = task_data->dynamic_first;
-            *end   = task_data->dynamic_first + (iterations - 1) * task_data->dynamic_step;
-            task_data->dynamic_iterations -= iterations;
-            task_data->dynamic_first      += iterations * task_data->dynamic_step;
-            if (!task_data->dynamic_iterations)
-                *end = task_data->dynamic_last;
+            if (!iterations)
+                return 0;
+
+            prev = InterlockedCompareExchange64(&task_data->dynamic_state, state + iterations, state);
+            if (prev == state) break;
+            state = prev;
         }
-        LeaveCriticalSection(&vcomp_section);
-        return iterations != 0;
+
+        *begin = first + done * step;
+        *end   = *begin + (iterations - 1) * step;
+        if (iterations == remaining)
+            *end = last;
+        return 1;
     }
 
     return 0;
@@ -1418,6 +1479,8 @@ static DWORD WINAPI _vcomp_fork_worker(void *param)
         struct vcomp_team_data *team = thread_data->team;
         if (team != NULL)
         {
+            unsigned int spin = team->spin_count;
+
             LeaveCriticalSection(&vcomp_section);
             _vcomp_fork_call_wrapper(team->wrapper, team->nargs, team->valist);
             EnterCriticalSection(&vcomp_section);
@@ -1425,8 +1488,16 @@ static DWORD WINAPI _vcomp_fork_worker(void *param)
             thread_data->team = NULL;
             list_remove(&thread_data->entry);
             list_add_tail(&vcomp_idle_threads, &thread_data->entry);
-            if (++team->finished_threads >= team->num_threads)
+            if (InterlockedIncrement(&team->finished_threads) >= team->num_threads)
                 WakeAllConditionVariable(&team->cond);
+
+            /* Parallel regions often follow each other closely, so stay
+             * awake for a while to pick up the next one without a wakeup. */
+            LeaveCriticalSection(&vcomp_section);
+            for (; spin && !thread_data->team; spin--)
+                vcomp_spin_pause();
+            EnterCriticalSection(&vcomp_section);
+            if (thread_data->team) continue;
         }
 
         if (!SleepConditionVariableCS(&thread_data->cond, &vcomp_section, 5000) &&
@@ -1469,6 +1540,7 @@ void WINAPIV _vcomp_fork(BOOL ifval, int nargs, void *wrapper, ...)
     InitializeConditionVariable(&team_data.cond);
     team_data.num_threads       = 1;
     team_data.finished_threads  = 0;
+    team_data.spin_count        = num_threads <= vcomp_max_threads ? VCOMP_SPIN_COUNT : 0;
     team_data.nargs             = nargs;
     team_data.wrapper           = wrapper;
     __ms_va_start(team_data.valist, wrapper);
@@ -1478,6 +1550,7 @@ void WINAPIV _vcomp_fork(BOOL ifval, int nargs, void *wrapper, ...)
     task_data.single            = 0;
     task_data.section           = 0;
     task_data.dynamic           = 0;
+    task_data.dynamic_state     = 0;
 
     thread_data.team            = &team_data;
     thread_data.task            = &task_data;
@@ -1559,9 +1632,15 @@ void WINAPIV _vcomp_fork(BOOL ifval, int nargs, void *wrapper, ...)
 
     if (team_data.num_threads > 1)
     {
-        EnterCriticalSection(&vcomp_section);
+        unsigned int spin;
 
-        team_data.finished_threads++;
+        InterlockedIncrement(&team_data.finished_threads);
+        for (spin = team_data.spin_count; spin && team_data.finished_threads < team_data.num_threads; spin--)
+            vcomp_spin_pause();
+
+        /* Always synchronize with the last worker, it may still be waking
+         * the condition variable. */
+        EnterCriticalSection(&vcomp_section);
         while (team_data.finished_threads < team_data.num_threads)
             SleepConditionVariableCS(&team_data.cond, &vcomp_section, INFINITE);
 
@@ -1328,6 +1328,77 @@ static void test_vcomp_for_dynamic_init(void)
     pomp_set_num_threads(max_threads);
 }
 
+static void CDECL barrier_stress_cb(LONG *count, LONG *failures)
+{
+    int num_threads = pomp_get_num_threads();
+    int i;
+
+    for (i = 0; i < 500; i++)
+    {
+        InterlockedIncrement(count);
+        p_vcomp_barrier();
+        if (*count != num_threads * (i + 1))
+            InterlockedIncrement(failures);
+        p_vcomp_barrier();
+    }
+}
+
+static void CDECL for_dynamic_nowait_cb(LONG *sums, int loops)
+{
+    unsigned int begin, end, i;
+    LONG sum;
+    int j;
+
+    /* back to back loops without a barrier in between */
+    for (j = 0; j < loops; j++)
+    {
+        p_vcomp_for_dynamic_init(VCOMP_DYNAMIC_FLAGS_CHUNKED | VCOMP_DYNAMIC_FLAGS_INCREMENT, 0, 999, 1, 3);
+        while (p_vcomp_for_dynamic_next(&begin, &end))
+        {
+            for (sum = 0, i = begin; i <= end; i++) sum += i;
+            InterlockedExchangeAdd(&sums[j], sum);
+        }
+    }
+}
+
+static void CDECL fork_count_cb(LONG *count)
+{
+    InterlockedIncrement(count);
+}
+
+static void test_vcomp_stress(void)
+{
+    LONG count, failures, sums[50];
+    int max_threads = pomp_get_max_threads();
+    int i, j;
+
+    for (i = 2; i <= 4; i++)
+    {
+        pomp_set_num_threads(i);
+
+        count = failures = 0;
+        p_vcomp_fork(TRUE, 2, barrier_stress_cb, &count, &failures);
+        ok(count == i * 500, "expected count == %d, got %d\n", i * 500, count);
+        ok(!failures, "got %d barrier failures with %d threads\n", failures, i);
+
+        memset(sums, 0, sizeof(sums));
+        p_vcomp_fork(TRUE, 2, for_dynamic_nowait_cb, sums, (int)(sizeof(sums) / sizeof(sums[0])));
+        for (j = 0; j < sizeof(sums) / sizeof(sums[0]); j++)
+            ok(sums[j] == 499500, "expected sums[%d] == 499500, got %d\n", j, sums[j]);
+
+        /* repeated short parallel regions reuse the same team */
+        for (j = 0; j < 200; j++)
+        {
+            count = 0;
+            p_vcomp_fork(TRUE, 1, fork_count_cb, &count);
+            if (count != i) break;
+        }
+        ok(j == 200, "fork %d: expected count == %d, got %d\n", j, i, count);
+    }
+
+    pomp_set_num_threads(max_threads);
+}
+
 static void CDECL master_cb(HANDLE semaphore)
 {
     int num_threads = pomp_get_num_threads();
@@ -2234,6 +2305,7 @@ START_TEST(vcomp)
     test_vcomp_for_static_simple_init();
     test_vcomp_for_static_init();
     test_vcomp_for_dynamic_init();
+    test_vcomp_stress();
     test_vcomp_master_begin();
     test_vcomp_single_begin();
     test_vcomp_enter_critsect();
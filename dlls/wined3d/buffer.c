@@ -34,6 +34,10 @@ WINE_DEFAULT_DEBUG_CHANNEL(d3d);
 #define WINED3D_BUFFER_PIN_SYSMEM   0x04    /* Keep a system memory copy for this buffer. */
 #define WINED3D_BUFFER_DISCARD      0x08    /* A DISCARD lock has occurred since the last preload. */
 #define WINED3D_BUFFER_APPLESYNC    0x10    /* Using sync as in GL_APPLE_flush_buffer_range. */
+#define WINED3D_BUFFER_PERSISTENT   0x20    /* The buffer object is persistently mapped. */
+
+#define WINED3D_BUFFER_SLICE_ALIGNMENT      256
+#define WINED3D_BUFFER_PERSISTENT_MAX_SIZE  0x1000000
 
 #define VB_MAXDECLCHANGES     100     /* After that number of decl changes we stop converting */
 #define VB_RESETDECLCHANGE    1000    /* Reset the decl changecount after that number of draws */
@@ -143,6 +147,7 @@ static void buffer_destroy_buffer_object(struct wined3d_buffer *buffer, struct w
 {
     const struct wined3d_gl_info *gl_info = context->gl_info;
     struct wined3d_resource *resource = &buffer->resource;
+    unsigned int i;
 
     if (!buffer->buffer_object)
         return;
@@ -181,6 +186,25 @@ static void buffer_destroy_buffer_object(struct wined3d_buffer *buffer, struct w
         }
     }
 
+    if (buffer->flags & WINED3D_BUFFER_PERSISTENT)
+    {
+        buffer_bind(buffer, context);
+        GL_EXTCALL(glUnmapBuffer(buffer->buffer_type_hint));
+        checkGLcall("glUnmapBuffer");
+
+        for (i = 0; i < WINED3D_BUFFER_SLICE_COUNT; ++i)
+        {
+            if (buffer->slice_fences[i])
+            {
+                wined3d_fence_destroy(buffer->slice_fences[i]);
+                buffer->slice_fences[i] = NULL;
+            }
+        }
+        buffer->persistent_map = NULL;
+        buffer->bo_offset = buffer->slice = 0;
+        buffer->flags &= ~WINED3D_BUFFER_PERSISTENT;
+    }
+
     GL_EXTCALL(glDeleteBuffers(1, &buffer->buffer_object));
     checkGLcall("glDeleteBuffers");
     buffer->buffer_object = 0;
@@ -193,6 +217,106 @@ static void buffer_destroy_buffer_object(struct wined3d_buffer *buffer, struct w
     buffer->flags &= ~WINED3D_BUFFER_APPLESYNC;
 }
 
+static BOOL buffer_use_persistent_map(const struct wined3d_buffer *buffer, const struct wined3d_gl_info *gl_info)
+{
+    /* The mapping is write-only, so buffers the application may read back are excluded. */
+    return (buffer->resource.usage & (WINED3DUSAGE_DYNAMIC | WINED3DUSAGE_WRITEONLY))
+            == (WINED3DUSAGE_DYNAMIC | WINED3DUSAGE_WRITEONLY)
+            && gl_info->supported[ARB_BUFFER_STORAGE] && gl_info->supported[ARB_SYNC]
+            && gl_info->supported[ARB_COPY_BUFFER]
+            && !(buffer->bind_flags & ~(WINED3D_BIND_VERTEX_BUFFER | WINED3D_BIND_INDEX_BUFFER))
+            && buffer->resource.size <= WINED3D_BUFFER_PERSISTENT_MAX_SIZE;
+}
+
+/* Allocate immutable storage for several copies of the buffer, and map it
+ * for as long as the buffer object lives. Discard maps then move on to the
+ * next copy, and no map call is needed to write to the buffer.
+ *
+ * Context activation is done by the caller. */
+static BOOL buffer_create_persistent_map(struct wined3d_buffer *buffer, struct wined3d_context *context)
+{
+    static const GLbitfield map_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    const struct wined3d_gl_info *gl_info = context->gl_info;
+    GLsizeiptr size;
+    GLenum error;
+
+    buffer->slice_size = (buffer->resource.size + WINED3D_BUFFER_SLICE_ALIGNMENT - 1)
+            & ~(WINED3D_BUFFER_SLICE_ALIGNMENT - 1);
+    size = (GLsizeiptr)buffer->slice_size * WINED3D_BUFFER_SLICE_COUNT;
+
+    GL_EXTCALL(glBufferStorage(buffer->buffer_type_hint, size, NULL, map_flags | GL_DYNAMIC_STORAGE_BIT));
+    if ((error = gl_info->gl_ops.gl.p_glGetError()) != GL_NO_ERROR)
+    {
+        WARN("glBufferStorage failed with error %s (%#x).\n", debug_glerror(error), error);
+        return FALSE;
+    }
+
+    buffer->persistent_map = GL_EXTCALL(glMapBufferRange(buffer->buffer_type_hint, 0, size, map_flags));
+    if ((error = gl_info->gl_ops.gl.p_glGetError()) != GL_NO_ERROR || !buffer->persistent_map
+            || ((DWORD_PTR)buffer->persistent_map & (RESOURCE_ALIGNMENT - 1)))
+    {
+        WARN("Failed to map buffer storage, pointer %p, error %s (%#x).\n",
+                buffer->persistent_map, debug_glerror(error), error);
+        buffer->persistent_map = NULL;
+
+        /* The storage is immutable, start over with a new buffer object. */
+        GL_EXTCALL(glDeleteBuffers(1, &buffer->buffer_object));
+        GL_EXTCALL(glGenBuffers(1, &buffer->buffer_object));
+        buffer_bind(buffer, context);
+        while (gl_info->gl_ops.gl.p_glGetError() != GL_NO_ERROR);
+        return FALSE;
+    }
+
+    TRACE("Persistently mapped buffer %p at %p, %u bytes per slice.\n",
+            buffer, buffer->persistent_map, buffer->slice_size);
+    buffer->slice = 0;
+    buffer->bo_offset = 0;
+    buffer->flags |= WINED3D_BUFFER_PERSISTENT;
+
+    return TRUE;
+}
+
+/* Issue a fence for the current copy of a persistently mapped buffer and
+ * switch to the next one, waiting for the GPU to release it if needed.
+ *
+ * Context activation is done by the caller. */
+static void buffer_persistent_next_slice(struct wined3d_buffer *buffer, struct wined3d_context *context)
+{
+    const struct wined3d_gl_info *gl_info = context->gl_info;
+    struct wined3d_device *device = buffer->resource.device;
+    struct wined3d_fence **fence = &buffer->slice_fences[buffer->slice];
+    enum wined3d_fence_result ret;
+    HRESULT hr;
+
+    if (!*fence && FAILED(hr = wined3d_fence_create(device, fence)))
+    {
+        ERR("Failed to create fence, hr %#x.\n", hr);
+        *fence = NULL;
+        gl_info->gl_ops.gl.p_glFinish();
+    }
+    if (*fence)
+        wined3d_fence_issue(*fence, device);
+
+    buffer->slice = (buffer->slice + 1) % WINED3D_BUFFER_SLICE_COUNT;
+    buffer->bo_offset = buffer->slice * buffer->slice_size;
+
+    /* Slices without a fence haven't been used yet. */
+    fence = &buffer->slice_fences[buffer->slice];
+    if (*fence)
+    {
+        ret = wined3d_fence_wait(*fence, device);
+        if (ret != WINED3D_FENCE_OK && ret != WINED3D_FENCE_NOT_STARTED)
+        {
+            ERR("wined3d_fence_wait() returned %u.\n", ret);
+            gl_info->gl_ops.gl.p_glFinish();
+        }
+    }
+
+    /* The vertex attribute pointers include the offset. */
+    if (buffer->resource.bind_count && (buffer->bind_flags & WINED3D_BIND_VERTEX_BUFFER))
+        device_invalidate_state(device, STATE_STREAMSRC);
+}
+
 /* Context activation is done by the caller. */
 static BOOL buffer_create_buffer_object(struct wined3d_buffer *buffer, struct wined3d_context *context)
 {
@@ -237,6 +361,13 @@ static BOOL buffer_create_buffer_object(struct wined3d_buffer *buffer, struct wi
         TRACE("Buffer has WINED3DUSAGE_DYNAMIC set.\n");
         gl_usage = GL_STREAM_DRAW_ARB;
 
+        if (buffer_use_persistent_map(buffer, gl_info) && buffer_create_persistent_map(buffer, context))
+        {
+            buffer->buffer_object_usage = gl_usage;
+            buffer_invalidate_bo_range(buffer, 0, 0);
+            return TRUE;
+        }
+
         if (gl_info->supported[APPLE_FLUSH_BUFFER_RANGE])
         {
             GL_EXTCALL(glBufferParameteriAPPLE(buffer->buffer_type_hint, GL_BUFFER_FLUSHING_UNMAP_APPLE, GL_FALSE));
@@ -543,7 +674,7 @@ static void wined3d_buffer_upload_ranges(struct wined3d_buffer *buffer, struct w
     {
         range = &ranges[range_count];
         GL_EXTCALL(glBufferSubData(buffer->buffer_type_hint,
-                range->offset, range->size, (BYTE *)data + range->offset));
+                buffer->bo_offset + range->offset, range->size, (BYTE *)data + range->offset));
     }
     checkGLcall("glBufferSubData");
 }
@@ -675,7 +806,7 @@ BOOL wined3d_buffer_load_location(struct wined3d_buffer *buffer,
     {
         case WINED3D_LOCATION_SYSMEM:
             buffer_bind(buffer, context);
-            GL_EXTCALL(glGetBufferSubData(buffer->buffer_type_hint, 0, buffer->resource.size,
+            GL_EXTCALL(glGetBufferSubData(buffer->buffer_type_hint, buffer->bo_offset, buffer->resource.size,
                     buffer->resource.heap_memory));
             checkGLcall("buffer download");
             break;
@@ -718,7 +849,7 @@ DWORD wined3d_buffer_get_memory(struct wined3d_buffer *buffer,
     if (locations & WINED3D_LOCATION_BUFFER)
     {
         data->buffer_object = buffer->buffer_object;
-        data->addr = NULL;
+        data->addr = (BYTE *)(ULONG_PTR)buffer->bo_offset;
         return WINED3D_LOCATION_BUFFER;
     }
     if (locations & WINED3D_LOCATION_SYSMEM)
@@ -1055,7 +1186,15 @@ static HRESULT wined3d_buffer_map(struct wined3d_buffer *buffer, UINT offset, UI
             if ((flags & WINED3D_MAP_DISCARD) && buffer->resource.heap_memory)
                 wined3d_buffer_evict_sysmem(buffer);
 
-            if (count == 1)
+            if (buffer->flags & WINED3D_BUFFER_PERSISTENT)
+            {
+                /* Redundant discards are filtered like below. Otherwise the
+                 * GPU may still be reading the current slice. */
+                if (count == 1 && (flags & WINED3D_MAP_DISCARD) && !(buffer->flags & WINED3D_BUFFER_DISCARD))
+                    buffer_persistent_next_slice(buffer, context);
+                buffer->map_ptr = buffer->persistent_map + buffer->bo_offset;
+            }
+            else if (count == 1)
             {
                 buffer_bind(buffer, context);
 
@@ -1151,7 +1290,13 @@ static void wined3d_buffer_unmap(struct wined3d_buffer *buffer)
         return;
     }
 
-    if (buffer->map_ptr)
+    if (buffer->map_ptr && (buffer->flags & WINED3D_BUFFER_PERSISTENT))
+    {
+        /* The mapping is coherent, there's nothing to flush. */
+        buffer_clear_dirty_areas(buffer);
+        buffer->map_ptr = NULL;
+    }
+    else if (buffer->map_ptr)
     {
         struct wined3d_device *device = buffer->resource.device;
         const struct wined3d_gl_info *gl_info;
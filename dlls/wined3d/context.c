@@ -2488,28 +2488,28 @@ static void SetupForBlit(const struct wined3d_device *device, struct wined3d_con
     }
 
     /* Other misc states */
-    gl_info->gl_ops.gl.p_glDisable(GL_ALPHA_TEST);
+    context_disable_gl_cap(context, GL_ALPHA_TEST);
     checkGLcall("glDisable(GL_ALPHA_TEST)");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_ALPHATESTENABLE));
-    gl_info->gl_ops.gl.p_glDisable(GL_LIGHTING);
+    context_disable_gl_cap(context, GL_LIGHTING);
     checkGLcall("glDisable GL_LIGHTING");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_LIGHTING));
-    gl_info->gl_ops.gl.p_glDisable(GL_DEPTH_TEST);
+    context_disable_gl_cap(context, GL_DEPTH_TEST);
     checkGLcall("glDisable GL_DEPTH_TEST");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_ZENABLE));
     glDisableWINE(GL_FOG);
     checkGLcall("glDisable GL_FOG");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_FOGENABLE));
-    gl_info->gl_ops.gl.p_glDisable(GL_BLEND);
+    context_disable_gl_cap(context, GL_BLEND);
     checkGLcall("glDisable GL_BLEND");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_ALPHABLENDENABLE));
-    gl_info->gl_ops.gl.p_glDisable(GL_CULL_FACE);
+    context_disable_gl_cap(context, GL_CULL_FACE);
     checkGLcall("glDisable GL_CULL_FACE");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_CULLMODE));
-    gl_info->gl_ops.gl.p_glDisable(GL_STENCIL_TEST);
+    context_disable_gl_cap(context, GL_STENCIL_TEST);
     checkGLcall("glDisable GL_STENCIL_TEST");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_STENCILENABLE));
-    gl_info->gl_ops.gl.p_glDisable(GL_SCISSOR_TEST);
+    context_disable_gl_cap(context, GL_SCISSOR_TEST);
     checkGLcall("glDisable GL_SCISSOR_TEST");
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_SCISSORTESTENABLE));
     if (gl_info->supported[ARB_POINT_SPRITE])
@@ -3063,8 +3063,8 @@ BOOL context_apply_clear_state(struct wined3d_context *context, const struct win
     /* Blending and clearing should be orthogonal, but tests on the nvidia
      * driver show that disabling blending when clearing improves the clearing
      * performance incredibly. */
-    gl_info->gl_ops.gl.p_glDisable(GL_BLEND);
-    gl_info->gl_ops.gl.p_glEnable(GL_SCISSOR_TEST);
+    context_disable_gl_cap(context, GL_BLEND);
+    context_enable_gl_cap(context, GL_SCISSOR_TEST);
     if (rt_count && gl_info->supported[ARB_FRAMEBUFFER_SRGB])
     {
         if (needs_srgb_write(context, state, fb))
@@ -3590,6 +3590,7 @@ static void context_update_stream_info(struct wined3d_context *context, const st
             WARN_(d3d_perf)("load_base_vertex_index is < 0 (%d), not using VBOs.\n",
                     state->load_base_vertex_index);
             element->data.buffer_object = 0;
+            element->data.addr -= buffer->bo_offset;
             element->data.addr += (ULONG_PTR)wined3d_buffer_load_sysmem(buffer, context);
             if ((UINT_PTR)element->data.addr < -state->load_base_vertex_index * element->stride)
                 FIXME("System memory vertex data load offset is negative!\n");
@@ -21,6 +21,7 @@
 #include "wined3d_private.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 
 #define WINED3D_INITIAL_CS_SIZE 4096
 
@@ -465,6 +466,20 @@ static void wined3d_cs_exec_present(struct wined3d_cs *cs, const void *data)
     InterlockedDecrement(&cs->pending_presents);
 }
 
+static void wined3d_cs_report_stats(struct wined3d_cs *cs)
+{
+    struct wined3d_cs_stats *stats = &cs->stats;
+    LONGLONG frequency = cs->frequency.QuadPart / 1000000;
+
+    if (TRACE_ON(d3d_perf) && frequency)
+        TRACE_(d3d_perf)("Frame: %u commands, %lu bytes, %u stalls (%s us), %u queue grows, "
+                "%s us in finish, spin limit %u.\n",
+                stats->commands, (unsigned long)stats->bytes, stats->stalls,
+                wine_dbgstr_longlong(stats->wait_time / frequency), stats->grows,
+                wine_dbgstr_longlong(stats->finish_time / frequency), cs->spin_limit);
+    memset(stats, 0, sizeof(*stats));
+}
+
 void wined3d_cs_emit_present(struct wined3d_cs *cs, struct wined3d_swapchain *swapchain,
         const RECT *src_rect, const RECT *dst_rect, HWND dst_window_override, DWORD flags)
 {
@@ -498,6 +513,9 @@ void wined3d_cs_emit_present(struct wined3d_cs *cs, struct wined3d_swapchain *sw
         wined3d_pause();
         pending = InterlockedCompareExchange(&cs->pending_presents, 0, 0);
     }
+
+    if (cs->thread)
+        wined3d_cs_report_stats(cs);
 }
 
 static void wined3d_cs_exec_clear(struct wined3d_cs *cs, const void *data)
@@ -2680,19 +2698,70 @@ static const struct wined3d_cs_ops wined3d_cs_st_ops =
     wined3d_cs_st_push_constants,
 };
 
+static LONGLONG wined3d_cs_get_time(void)
+{
+    LARGE_INTEGER counter;
+
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+static struct wined3d_cs_queue_segment *wined3d_cs_queue_segment_create(SIZE_T size)
+{
+    struct wined3d_cs_queue_segment *segment;
+
+    if (!(segment = HeapAlloc(GetProcessHeap(), 0, FIELD_OFFSET(struct wined3d_cs_queue_segment, data[size]))))
+        return NULL;
+    segment->head = segment->tail = 0;
+    segment->next = NULL;
+    segment->size = size;
+
+    return segment;
+}
+
+static void wined3d_cs_queue_cleanup(struct wined3d_cs_queue *queue)
+{
+    struct wined3d_cs_queue_segment *segment, *next;
+
+    for (segment = queue->read; segment; segment = next)
+    {
+        next = segment->next;
+        HeapFree(GetProcessHeap(), 0, segment);
+    }
+    queue->read = queue->write = NULL;
+}
+
+/* Called from the worker thread. */
 static BOOL wined3d_cs_queue_is_empty(const struct wined3d_cs_queue *queue)
 {
-    return *(volatile LONG *)&queue->head == queue->tail;
+    const struct wined3d_cs_queue_segment *segment = queue->read;
+
+    return *(volatile LONG *)&segment->head == segment->tail
+            && !*(struct wined3d_cs_queue_segment *volatile *)&segment->next;
+}
+
+/* Called from the application thread. The worker may free the segments
+ * before "write" at any time, so only the pointer to "read" is looked at. */
+static BOOL wined3d_cs_queue_is_idle(const struct wined3d_cs_queue *queue)
+{
+    const struct wined3d_cs_queue_segment *segment = queue->write;
+
+    return *(struct wined3d_cs_queue_segment *const volatile *)&queue->read == segment
+            && *(volatile LONG *)&segment->tail == segment->head;
 }
 
 static void wined3d_cs_queue_submit(struct wined3d_cs_queue *queue, struct wined3d_cs *cs)
 {
+    struct wined3d_cs_queue_segment *segment = queue->write;
     struct wined3d_cs_packet *packet;
     size_t packet_size;
 
-    packet = (struct wined3d_cs_packet *)&queue->data[queue->head];
+    packet = (struct wined3d_cs_packet *)&segment->data[segment->head];
     packet_size = FIELD_OFFSET(struct wined3d_cs_packet, data[packet->size]);
-    InterlockedExchange(&queue->head, (queue->head + packet_size) & (WINED3D_CS_QUEUE_SIZE - 1));
+    InterlockedExchange(&segment->head, (segment->head + packet_size) & (segment->size - 1));
+
+    ++cs->stats.commands;
+    cs->stats.bytes += packet_size;
 
     if (InterlockedCompareExchange(&cs->waiting_for_event, FALSE, TRUE))
         SetEvent(cs->event);
@@ -2706,38 +2775,90 @@ static void wined3d_cs_mt_submit(struct wined3d_cs *cs, enum wined3d_cs_queue_id
     wined3d_cs_queue_submit(&cs->queue[queue_id], cs);
 }
 
+/* Start a new segment of "size" bytes. Everything submitted to the current
+ * segment is still executed before the new one is looked at. */
+static BOOL wined3d_cs_queue_link_segment(struct wined3d_cs_queue *queue, SIZE_T size)
+{
+    struct wined3d_cs_queue_segment *segment = queue->write, *new_segment;
+
+    if (!(new_segment = wined3d_cs_queue_segment_create(size)))
+    {
+        WARN("Failed to allocate a %lu bytes queue segment.\n", (unsigned long)size);
+        return FALSE;
+    }
+
+    queue->write = new_segment;
+    queue->idle_count = 0;
+    InterlockedExchangePointer((void **)&segment->next, new_segment);
+
+    return TRUE;
+}
+
+static BOOL wined3d_cs_queue_grow(struct wined3d_cs_queue *queue, size_t min_size, struct wined3d_cs *cs)
+{
+    SIZE_T size = queue->write->size * 2;
+
+    while (size <= min_size)
+        size *= 2;
+    if (size > WINED3D_CS_QUEUE_MAX_SIZE)
+        return FALSE;
+
+    TRACE("Growing queue %p to %lu bytes.\n", queue, (unsigned long)size);
+    if (!wined3d_cs_queue_link_segment(queue, size))
+        return FALSE;
+    ++cs->stats.grows;
+
+    return TRUE;
+}
+
+/* The worker frees the larger segment once it gets to the new one. */
+static void wined3d_cs_queue_shrink(struct wined3d_cs_queue *queue)
+{
+    if (queue->write->size <= WINED3D_CS_QUEUE_SIZE || !wined3d_cs_queue_is_idle(queue)
+            || ++queue->idle_count < WINED3D_CS_QUEUE_SHRINK_COUNT)
+        return;
+
+    TRACE("Shrinking queue %p to %lu bytes.\n", queue, (unsigned long)WINED3D_CS_QUEUE_SIZE);
+    wined3d_cs_queue_link_segment(queue, WINED3D_CS_QUEUE_SIZE);
+}
+
 #if defined(STAGING_CSMT)
 static BOOL wined3d_cs_queue_check_space(struct wined3d_cs_queue *queue, size_t size)
 {
-    size_t queue_size = ARRAY_SIZE(queue->data);
+    const struct wined3d_cs_queue_segment *segment = queue->write;
     size_t header_size, packet_size, remaining;
 
     header_size = FIELD_OFFSET(struct wined3d_cs_packet, data[0]);
     size = (size + header_size - 1) & ~(header_size - 1);
     packet_size = FIELD_OFFSET(struct wined3d_cs_packet, data[size]);
 
-    remaining = queue_size - queue->head;
+    remaining = segment->size - segment->head;
     return (remaining >= packet_size);
 }
 
 #endif /* STAGING_CSMT */
 static void *wined3d_cs_queue_require_space(struct wined3d_cs_queue *queue, size_t size, struct wined3d_cs *cs)
 {
-    size_t queue_size = ARRAY_SIZE(queue->data);
+    struct wined3d_cs_queue_segment *segment = queue->write;
     size_t header_size, packet_size, remaining;
     struct wined3d_cs_packet *packet;
+    LONGLONG wait_start = 0;
 
     header_size = FIELD_OFFSET(struct wined3d_cs_packet, data[0]);
     size = (size + header_size - 1) & ~(header_size - 1);
     packet_size = FIELD_OFFSET(struct wined3d_cs_packet, data[size]);
-    if (packet_size >= WINED3D_CS_QUEUE_SIZE)
+    if (packet_size < WINED3D_CS_QUEUE_SIZE)
+        wined3d_cs_queue_shrink(queue);
+    segment = queue->write;
+    if (packet_size >= segment->size && !wined3d_cs_queue_grow(queue, packet_size, cs))
     {
-        ERR("Packet size %lu >= queue size %u.\n",
-                (unsigned long)packet_size, WINED3D_CS_QUEUE_SIZE);
+        ERR("Packet size %lu >= queue size %lu.\n",
+                (unsigned long)packet_size, (unsigned long)segment->size);
         return NULL;
     }
+    segment = queue->write;
 
-    remaining = queue_size - queue->head;
+    remaining = segment->size - segment->head;
     if (remaining < packet_size)
     {
         size_t nop_size = remaining - header_size;
@@ -2751,19 +2872,20 @@ static void *wined3d_cs_queue_require_space(struct wined3d_cs_queue *queue, size
             nop->opcode = WINED3D_CS_OP_NOP;
 
         wined3d_cs_queue_submit(queue, cs);
-        assert(!queue->head);
+        segment = queue->write;
+        assert(!segment->head);
     }
 
     for (;;)
     {
-        LONG tail = *(volatile LONG *)&queue->tail;
-        LONG head = queue->head;
+        LONG tail = *(volatile LONG *)&segment->tail;
+        LONG head = segment->head;
         LONG new_pos;
 
         /* Empty. */
         if (head == tail)
             break;
-        new_pos = (head + packet_size) & (WINED3D_CS_QUEUE_SIZE - 1);
+        new_pos = (head + packet_size) & (segment->size - 1);
         /* Head ahead of tail. We checked the remaining size above, so we only
          * need to make sure we don't make head equal to tail. */
         if (head > tail && (new_pos != tail))
@@ -2773,11 +2895,25 @@ static void *wined3d_cs_queue_require_space(struct wined3d_cs_queue *queue, size
         if (new_pos < tail && new_pos)
             break;
 
+        if (!wait_start)
+        {
+            /* Rather than waiting for the worker, continue in a new segment. */
+            if (wined3d_cs_queue_grow(queue, packet_size, cs))
+            {
+                segment = queue->write;
+                break;
+            }
+            ++cs->stats.stalls;
+            wait_start = wined3d_cs_get_time();
+        }
+
         TRACE("Waiting for free space. Head %u, tail %u, packet size %lu.\n",
                 head, tail, (unsigned long)packet_size);
     }
+    if (wait_start)
+        cs->stats.wait_time += wined3d_cs_get_time() - wait_start;
 
-    packet = (struct wined3d_cs_packet *)&queue->data[queue->head];
+    packet = (struct wined3d_cs_packet *)&segment->data[segment->head];
     packet->size = size;
     return packet->data;
 }
@@ -2802,11 +2938,18 @@ static void *wined3d_cs_mt_require_space(struct wined3d_cs *cs, size_t size, enu
 
 static void wined3d_cs_mt_finish(struct wined3d_cs *cs, enum wined3d_cs_queue_id queue_id)
 {
+    LONGLONG start;
+
     if (cs->thread_id == GetCurrentThreadId())
         return wined3d_cs_st_finish(cs, queue_id);
 
-    while (!wined3d_cs_queue_is_empty(&cs->queue[queue_id]))
+    if (wined3d_cs_queue_is_idle(&cs->queue[queue_id]))
+        return;
+
+    start = wined3d_cs_get_time();
+    while (!wined3d_cs_queue_is_idle(&cs->queue[queue_id]))
         wined3d_pause();
+    cs->stats.finish_time += wined3d_cs_get_time() - start;
 }
 
 static const struct wined3d_cs_ops wined3d_cs_mt_ops =
@@ -2835,7 +2978,8 @@ static void poll_queries(struct wined3d_cs *cs)
     }
 }
 
-static void wined3d_cs_wait_event(struct wined3d_cs *cs)
+/* Returns TRUE if the thread actually went to sleep. */
+static BOOL wined3d_cs_wait_event(struct wined3d_cs *cs)
 {
     InterlockedExchange(&cs->waiting_for_event, TRUE);
 
@@ -2849,15 +2993,39 @@ static void wined3d_cs_wait_event(struct wined3d_cs *cs)
     if (!(wined3d_cs_queue_is_empty(&cs->queue[WINED3D_CS_QUEUE_DEFAULT])
             && wined3d_cs_queue_is_empty(&cs->queue[WINED3D_CS_QUEUE_MAP]))
             && InterlockedCompareExchange(&cs->waiting_for_event, FALSE, TRUE))
-        return;
+        return FALSE;
 
     WaitForSingleObject(cs->event, INFINITE);
+    return TRUE;
+}
+
+/* Adjust how long the worker spins on an empty queue before going to sleep,
+ * based on how long the queue typically stays empty. "idle_count" is the
+ * number of spins before work arrived. When the thread slept, "spin_time" and
+ * "sleep_time" are the time spent spinning and sleeping. */
+static void wined3d_cs_update_spin_limit(struct wined3d_cs *cs, unsigned int idle_count,
+        LONGLONG spin_time, LONGLONG sleep_time)
+{
+    unsigned int sample;
+
+    if (!sleep_time)
+        sample = idle_count;
+    else if (sleep_time < spin_time)
+        /* Spinning a little longer would have avoided the wakeup latency. */
+        sample = min(cs->spin_limit, WINED3D_CS_SPIN_COUNT / 2) * 2;
+    else
+        sample = cs->spin_limit / 2;
+
+    cs->spin_average = cs->spin_average - cs->spin_average / 8 + sample / 8;
+    cs->spin_limit = min(max(cs->spin_average * 2, WINED3D_CS_MIN_SPIN_COUNT), WINED3D_CS_SPIN_COUNT);
 }
 
 static DWORD WINAPI wined3d_cs_run(void *ctx)
 {
+    struct wined3d_cs_queue_segment *segment;
     struct wined3d_cs_packet *packet;
     struct wined3d_cs_queue *queue;
+    LONGLONG idle_start = 0, spin_time = 0, sleep_time = 0, now;
     unsigned int spin_count = 0;
     struct wined3d_cs *cs = ctx;
     enum wined3d_cs_op opcode;
@@ -2882,15 +3050,38 @@ static DWORD WINAPI wined3d_cs_run(void *ctx)
             queue = &cs->queue[WINED3D_CS_QUEUE_DEFAULT];
             if (wined3d_cs_queue_is_empty(queue))
             {
-                if (++spin_count >= WINED3D_CS_SPIN_COUNT && list_empty(&cs->query_poll_list))
-                    wined3d_cs_wait_event(cs);
+                if (!spin_count++)
+                    idle_start = wined3d_cs_get_time();
+                if (spin_count >= cs->spin_limit && list_empty(&cs->query_poll_list))
+                {
+                    now = wined3d_cs_get_time();
+                    if (wined3d_cs_wait_event(cs))
+                    {
+                        spin_time = now - idle_start;
+                        sleep_time = max(wined3d_cs_get_time() - now, 1);
+                    }
+                }
                 continue;
             }
         }
-        spin_count = 0;
+        if (spin_count)
+        {
+            wined3d_cs_update_spin_limit(cs, spin_count, spin_time, sleep_time);
+            spin_count = 0;
+            spin_time = sleep_time = 0;
+        }
+
+        segment = queue->read;
+        tail = segment->tail;
+        if (tail == *(volatile LONG *)&segment->head)
+        {
+            /* Everything before the link to the next segment was executed. */
+            queue->read = segment->next;
+            HeapFree(GetProcessHeap(), 0, segment);
+            continue;
+        }
 
-        tail = queue->tail;
-        packet = (struct wined3d_cs_packet *)&queue->data[tail];
+        packet = (struct wined3d_cs_packet *)&segment->data[tail];
         if (packet->size)
         {
             opcode = *(const enum wined3d_cs_op *)packet->data;
@@ -2906,12 +3097,14 @@ static DWORD WINAPI wined3d_cs_run(void *ctx)
         }
 
         tail += FIELD_OFFSET(struct wined3d_cs_packet, data[packet->size]);
-        tail &= (WINED3D_CS_QUEUE_SIZE - 1);
-        InterlockedExchange(&queue->tail, tail);
+        tail &= (segment->size - 1);
+        InterlockedExchange(&segment->tail, tail);
     }
 
-    cs->queue[WINED3D_CS_QUEUE_MAP].tail = cs->queue[WINED3D_CS_QUEUE_MAP].head = 0;
-    cs->queue[WINED3D_CS_QUEUE_DEFAULT].tail = cs->queue[WINED3D_CS_QUEUE_DEFAULT].head = 0;
+    segment = cs->queue[WINED3D_CS_QUEUE_MAP].read;
+    segment->tail = segment->head = 0;
+    segment = cs->queue[WINED3D_CS_QUEUE_DEFAULT].read;
+    segment->tail = segment->head = 0;
     TRACE("Stopped.\n");
     FreeLibraryAndExitThread(cs->wined3d_module, 0);
 }
@@ -2920,6 +3113,7 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device)
 {
     const struct wined3d_gl_info *gl_info = &device->adapter->gl_info;
     struct wined3d_cs *cs;
+    unsigned int i;
 
     if (!(cs = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*cs))))
         return NULL;
@@ -2944,12 +3138,23 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device)
             && !RtlIsCriticalSectionLockedByThread(NtCurrentTeb()->Peb->LoaderLock))
     {
         cs->ops = &wined3d_cs_mt_ops;
+        cs->spin_limit = WINED3D_CS_SPIN_COUNT;
+        cs->spin_average = WINED3D_CS_SPIN_COUNT / 2;
+        QueryPerformanceFrequency(&cs->frequency);
+
+        for (i = 0; i < WINED3D_CS_QUEUE_COUNT; ++i)
+        {
+            if (!(cs->queue[i].read = cs->queue[i].write = wined3d_cs_queue_segment_create(WINED3D_CS_QUEUE_SIZE)))
+            {
+                ERR("Failed to allocate command stream queue.\n");
+                goto fail_queue;
+            }
+        }
 
         if (!(cs->event = CreateEventW(NULL, FALSE, FALSE, NULL)))
         {
             ERR("Failed to create command stream event.\n");
-            HeapFree(GetProcessHeap(), 0, cs->data);
-            goto fail;
+            goto fail_queue;
         }
 
         if (!(GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS,
@@ -2957,8 +3162,7 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device)
         {
             ERR("Failed to get wined3d module handle.\n");
             CloseHandle(cs->event);
-            HeapFree(GetProcessHeap(), 0, cs->data);
-            goto fail;
+            goto fail_queue;
         }
 
         if (!(cs->thread = CreateThread(NULL, 0, wined3d_cs_run, cs, 0, NULL)))
@@ -2966,13 +3170,16 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device)
             ERR("Failed to create wined3d command stream thread.\n");
             FreeLibrary(cs->wined3d_module);
             CloseHandle(cs->event);
-            HeapFree(GetProcessHeap(), 0, cs->data);
-            goto fail;
+            goto fail_queue;
         }
     }
 
     return cs;
 
+fail_queue:
+    for (i = 0; i < WINED3D_CS_QUEUE_COUNT; ++i)
+        wined3d_cs_queue_cleanup(&cs->queue[i]);
+    HeapFree(GetProcessHeap(), 0, cs->data);
 fail:
     state_cleanup(&cs->state);
     HeapFree(GetProcessHeap(), 0, cs->fb.render_targets);
@@ -2982,12 +3189,16 @@ fail:
 
 void wined3d_cs_destroy(struct wined3d_cs *cs)
 {
+    unsigned int i;
+
     if (cs->thread)
     {
         wined3d_cs_emit_stop(cs);
         CloseHandle(cs->thread);
         if (!CloseHandle(cs->event))
             ERR("Closing event failed.\n");
+        for (i = 0; i < WINED3D_CS_QUEUE_COUNT; ++i)
+            wined3d_cs_queue_cleanup(&cs->queue[i]);
     }
 
     state_cleanup(&cs->state);
@@ -142,6 +142,7 @@ static void draw_primitive_arrays(struct wined3d_context *context, const struct
         for (j = 0; j < instanced_element_count; ++j)
         {
             const struct wined3d_stream_info_element *element;
+            struct wined3d_buffer *buffer;
             unsigned int element_idx;
             const BYTE *ptr;
 
@@ -149,7 +150,13 @@ static void draw_primitive_arrays(struct wined3d_context *context, const struct
             element = &si->elements[element_idx];
             ptr = element->data.addr + element->stride * i;
             if (element->data.buffer_object)
-                ptr += (ULONG_PTR)wined3d_buffer_load_sysmem(state->streams[element->stream_idx].buffer, context);
+            {
+                /* The address includes the offset of the current slice of a
+                 * persistently mapped buffer; sysmem only holds one copy. */
+                buffer = state->streams[element->stream_idx].buffer;
+                ptr -= buffer->bo_offset;
+                ptr += (ULONG_PTR)wined3d_buffer_load_sysmem(buffer, context);
+            }
             ops->generic[element->format->emit_idx](element_idx, ptr);
         }
 
@@ -447,6 +454,7 @@ static void remove_vbos(struct wined3d_context *context,
         {
             struct wined3d_buffer *vb = state->streams[e->stream_idx].buffer;
             e->data.buffer_object = 0;
+            e->data.addr -= vb->bo_offset;
             e->data.addr += (ULONG_PTR)wined3d_buffer_load_sysmem(vb, context);
         }
     }
@@ -600,7 +608,7 @@ void draw_primitive(struct wined3d_device *device, const struct wined3d_state *s
         else
         {
             ib_fence = index_buffer->fence;
-            idx_data = NULL;
+            idx_data = (const BYTE *)(ULONG_PTR)index_buffer->bo_offset;
         }
         idx_data = (const BYTE *)idx_data + state->index_offset;
 
@@ -42,6 +42,7 @@
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d_shader);
 WINE_DECLARE_DEBUG_CHANNEL(d3d);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 WINE_DECLARE_DEBUG_CHANNEL(winediag);
 
 #define WINED3D_GLSL_SAMPLE_PROJECTED   0x01
@@ -132,6 +133,16 @@ struct shader_glsl_priv
     struct wine_rb_tree ffp_fragment_shaders;
     BOOL ffp_proj_control;
     BOOL legacy_lighting;
+
+    /* Shader variant statistics. */
+    unsigned int compiled_variants;
+    unsigned int precompiled_variants;
+    unsigned int precompile_hits;
+
+    /* Translation statistics, only gathered with d3d_perf tracing. */
+    unsigned int generated_shaders;
+    UINT64 generated_size;
+    UINT64 generate_time;
 };
 
 struct glsl_vs_program
@@ -274,12 +285,14 @@ struct glsl_ps_compiled_shader
     struct ps_compile_args          args;
     struct ps_np2fixup_info         np2fixup;
     GLuint                          id;
+    BOOL                            precompiled;
 };
 
 struct glsl_vs_compiled_shader
 {
     struct vs_compile_args          args;
     GLuint                          id;
+    BOOL                            precompiled;
 };
 
 struct glsl_hs_compiled_shader
@@ -495,6 +508,8 @@ void print_glsl_info_log(const struct wined3d_gl_info *gl_info, GLuint id, BOOL
     }
 }
 
+static BOOL shader_glsl_use_program_cache(const struct wined3d_gl_info *gl_info);
+
 /* Context activation is done by the caller. */
 static void shader_glsl_compile(const struct wined3d_gl_info *gl_info, GLuint shader, const char *src)
 {
@@ -510,11 +525,27 @@ static void shader_glsl_compile(const struct wined3d_gl_info *gl_info, GLuint sh
 
     GL_EXTCALL(glShaderSource(shader, 1, &src, NULL));
     checkGLcall("glShaderSource");
+
+    /* Compiled when linking, if the program isn't in the program cache. */
+    if (shader_glsl_use_program_cache(gl_info))
+        return;
+
     GL_EXTCALL(glCompileShader(shader));
     checkGLcall("glCompileShader");
     print_glsl_info_log(gl_info, shader, FALSE);
 }
 
+/* Context activation is done by the caller. */
+static GLuint shader_glsl_create_shader(const struct wined3d_gl_info *gl_info, GLenum type, const char *src)
+{
+    GLuint shader_id;
+
+    shader_id = GL_EXTCALL(glCreateShader(type));
+    shader_glsl_compile(gl_info, shader_id, src);
+
+    return shader_id;
+}
+
 /* Context activation is done by the caller. */
 static void shader_glsl_dump_program_source(const struct wined3d_gl_info *gl_info, GLuint program)
 {
@@ -586,6 +617,432 @@ void shader_glsl_validate_link(const struct wined3d_gl_info *gl_info, GLuint pro
     print_glsl_info_log(gl_info, program, TRUE);
 }
 
+/* On-disk GLSL program cache.
+ *
+ * Linked programs are stored as ARB_get_program_binary blobs, keyed by a hash
+ * of the GLSL source of the attached shaders and of the state bound before
+ * linking. When the cache is in use, shader objects are only compiled when a
+ * program using them has to be linked from source. */
+
+#define GLSL_PROGRAM_CACHE_MAGIC        0x50475733  /* "3WGP" */
+#define GLSL_PROGRAM_CACHE_VERSION      1
+#define GLSL_PROGRAM_CACHE_MAX_BINARY   (64 * 1024 * 1024)
+
+/* Flags mixed into the program key for state that isn't part of the GLSL source. */
+#define GLSL_PROGRAM_KEY_VS_SM4         0x00010000
+#define GLSL_PROGRAM_KEY_DUAL_BLEND     0x00020000
+#define GLSL_PROGRAM_KEY_COMPUTE        0x00040000
+#define GLSL_PROGRAM_KEY_NO_CACHE       0x80000000
+
+struct glsl_program_cache_header
+{
+    DWORD magic;
+    DWORD version;
+    UINT64 driver_hash;
+    UINT64 key;
+    DWORD format;
+    DWORD size;
+};
+
+struct glsl_program_cache_file
+{
+    FILETIME time;
+    UINT64 size;
+    char name[MAX_PATH];
+};
+
+static CRITICAL_SECTION glsl_program_cache_cs;
+static CRITICAL_SECTION_DEBUG glsl_program_cache_cs_debug =
+{
+    0, 0, &glsl_program_cache_cs,
+    {&glsl_program_cache_cs_debug.ProcessLocksList,
+    &glsl_program_cache_cs_debug.ProcessLocksList},
+    0, 0, {(DWORD_PTR)(__FILE__ ": glsl_program_cache_cs")}
+};
+static CRITICAL_SECTION glsl_program_cache_cs = {&glsl_program_cache_cs_debug, -1, 0, 0, 0, 0};
+
+static struct
+{
+    LONG state;             /* 0: not initialized, 1: enabled, -1: disabled */
+    char path[MAX_PATH];
+    UINT64 driver_hash;
+    UINT64 total_size;
+    UINT64 max_size;
+    LONG hits;
+    LONG misses;
+    LONG stores;
+    LONG evictions;
+}
+glsl_program_cache;
+
+static UINT64 glsl_hash_data(UINT64 hash, const void *data, SIZE_T size)
+{
+    const BYTE *ptr = data;
+
+    /* 64-bit FNV-1a */
+    while (size--)
+    {
+        hash ^= *ptr++;
+        hash *= ((UINT64)0x100 << 32) | 0x1b3;
+    }
+    return hash;
+}
+
+static UINT64 glsl_hash_init(void)
+{
+    return ((UINT64)0xcbf29ce4 << 32) | 0x84222325;
+}
+
+static UINT64 glsl_hash_string(UINT64 hash, const char *str)
+{
+    return str ? glsl_hash_data(hash, str, strlen(str)) : hash;
+}
+
+static void shader_glsl_program_cache_scan(void)
+{
+    WIN32_FIND_DATAA data;
+    char pattern[MAX_PATH];
+    HANDLE handle;
+
+    glsl_program_cache.total_size = 0;
+    snprintf(pattern, sizeof(pattern), "%s\\*.bin", glsl_program_cache.path);
+    if ((handle = FindFirstFileA(pattern, &data)) == INVALID_HANDLE_VALUE)
+        return;
+    do
+    {
+        glsl_program_cache.total_size += ((UINT64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+}
+
+static BOOL shader_glsl_program_cache_create_dir(void)
+{
+    static const char *const subdirs[] = {"\\wine", "\\wined3d"};
+    char *path = glsl_program_cache.path;
+    DWORD len, attr;
+    unsigned int i;
+
+    if (!(len = GetEnvironmentVariableA("LOCALAPPDATA", path, MAX_PATH)) || len >= MAX_PATH)
+        return FALSE;
+
+    for (i = 0; i < sizeof(subdirs) / sizeof(*subdirs); ++i)
+    {
+        if (strlen(path) + strlen(subdirs[i]) + 32 >= MAX_PATH)
+            return FALSE;
+        strcat(path, subdirs[i]);
+        if (!CreateDirectoryA(path, NULL) && GetLastError() != ERROR_ALREADY_EXISTS)
+            return FALSE;
+    }
+    attr = GetFileAttributesA(path);
+    return attr != INVALID_FILE_ATTRIBUTES && (attr & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+/* Context activation is done by the caller. */
+static BOOL shader_glsl_use_program_cache(const struct wined3d_gl_info *gl_info)
+{
+    GLint format_count = 0;
+    UINT64 hash;
+
+    if (!wined3d_settings.shader_cache_size || !gl_info->supported[ARB_GET_PROGRAM_BINARY])
+        return FALSE;
+    if (glsl_program_cache.state)
+        return glsl_program_cache.state > 0;
+
+    EnterCriticalSection(&glsl_program_cache_cs);
+    if (!glsl_program_cache.state)
+    {
+        glsl_program_cache.state = -1;
+
+        gl_info->gl_ops.gl.p_glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+        checkGLcall("glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS)");
+        if (format_count <= 0)
+            WARN("Driver doesn't support any program binary format, not using the program cache.\n");
+        else if (!shader_glsl_program_cache_create_dir())
+            WARN("Failed to create the program cache directory.\n");
+        else
+        {
+            /* Program binaries are only valid for the driver that created them. */
+            hash = glsl_hash_init();
+            hash = glsl_hash_string(hash, (const char *)gl_info->gl_ops.gl.p_glGetString(GL_VENDOR));
+            hash = glsl_hash_string(hash, (const char *)gl_info->gl_ops.gl.p_glGetString(GL_RENDERER));
+            hash = glsl_hash_string(hash, (const char *)gl_info->gl_ops.gl.p_glGetString(GL_VERSION));
+            glsl_program_cache.driver_hash = hash;
+            glsl_program_cache.max_size = (UINT64)wined3d_settings.shader_cache_size * 1024 * 1024;
+            shader_glsl_program_cache_scan();
+            TRACE("Using program cache %s, %s bytes.\n", debugstr_a(glsl_program_cache.path),
+                    wine_dbgstr_longlong(glsl_program_cache.total_size));
+            glsl_program_cache.state = 1;
+        }
+    }
+    LeaveCriticalSection(&glsl_program_cache_cs);
+
+    return glsl_program_cache.state > 0;
+}
+
+static void shader_glsl_program_cache_path(char *path, UINT64 key)
+{
+    snprintf(path, MAX_PATH, "%s\\%08x%08x.bin", glsl_program_cache.path,
+            (unsigned int)(key >> 32), (unsigned int)key);
+}
+
+static int glsl_program_cache_file_compare(const void *a, const void *b)
+{
+    const struct glsl_program_cache_file *f1 = a, *f2 = b;
+
+    return CompareFileTime(&f1->time, &f2->time);
+}
+
+/* Remove the least recently used programs until the cache is at 3/4 of its maximum size. */
+static void shader_glsl_program_cache_evict(void)
+{
+    struct glsl_program_cache_file *files = NULL, *new_files;
+    unsigned int count = 0, size = 0, i;
+    UINT64 target = glsl_program_cache.max_size / 4 * 3;
+    WIN32_FIND_DATAA data;
+    char path[MAX_PATH];
+    HANDLE handle;
+
+    snprintf(path, sizeof(path), "%s\\*.bin", glsl_program_cache.path);
+    if ((handle = FindFirstFileA(path, &data)) == INVALID_HANDLE_VALUE)
+        return;
+    do
+    {
+        if (count == size)
+        {
+            size = max(64, size * 2);
+            if (!(new_files = files ? HeapReAlloc(GetProcessHeap(), 0, files, size * sizeof(*files))
+                    : HeapAlloc(GetProcessHeap(), 0, size * sizeof(*files))))
+                break;
+            files = new_files;
+        }
+        files[count].time = data.ftLastWriteTime;
+        files[count].size = ((UINT64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+        lstrcpynA(files[count].name, data.cFileName, sizeof(files[count].name));
+        ++count;
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+
+    if (!files)
+        return;
+
+    qsort(files, count, sizeof(*files), glsl_program_cache_file_compare);
+    for (i = 0; i < count && glsl_program_cache.total_size > target; ++i)
+    {
+        snprintf(path, sizeof(path), "%s\\%s", glsl_program_cache.path, files[i].name);
+        if (!DeleteFileA(path))
+            continue;
+        glsl_program_cache.total_size -= min(files[i].size, glsl_program_cache.total_size);
+        ++glsl_program_cache.evictions;
+    }
+    TRACE("Evicted %u programs, cache size is now %s bytes.\n", i,
+            wine_dbgstr_longlong(glsl_program_cache.total_size));
+    HeapFree(GetProcessHeap(), 0, files);
+}
+
+/* Context activation is done by the caller. */
+static UINT64 shader_glsl_program_cache_key(const struct wined3d_gl_info *gl_info, GLuint program, DWORD flags)
+{
+    UINT64 hashes[8], hash;
+    GLuint shaders[8];
+    GLsizei count = 0;
+    GLint length, type, source_size = 0;
+    char *source = NULL, *new_source;
+    int i, j;
+
+    GL_EXTCALL(glGetProgramiv(program, GL_ATTACHED_SHADERS, &length));
+    if (length <= 0 || length > sizeof(shaders) / sizeof(*shaders))
+        return 0;
+    GL_EXTCALL(glGetAttachedShaders(program, sizeof(shaders) / sizeof(*shaders), &count, shaders));
+
+    for (i = 0; i < count; ++i)
+    {
+        GL_EXTCALL(glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type));
+        GL_EXTCALL(glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &length));
+        if (length > source_size)
+        {
+            if (!(new_source = HeapReAlloc(GetProcessHeap(), 0, source, length)))
+            {
+                HeapFree(GetProcessHeap(), 0, source);
+                return 0;
+            }
+            source = new_source;
+            source_size = length;
+        }
+        hash = glsl_hash_data(glsl_hash_init(), &type, sizeof(type));
+        if (length > 0)
+        {
+            GL_EXTCALL(glGetShaderSource(shaders[i], length, &length, source));
+            hash = glsl_hash_data(hash, source, length);
+        }
+
+        /* The order of attached shaders is implementation defined. */
+        for (j = i; j > 0 && hashes[j - 1] > hash; --j)
+            hashes[j] = hashes[j - 1];
+        hashes[j] = hash;
+    }
+    HeapFree(GetProcessHeap(), 0, source);
+    checkGLcall("get program sources");
+
+    hash = glsl_hash_data(glsl_hash_init(), hashes, count * sizeof(*hashes));
+    hash = glsl_hash_data(hash, &flags, sizeof(flags));
+    return hash ? hash : 1;
+}
+
+/* Context activation is done by the caller. */
+static BOOL shader_glsl_load_program_binary(const struct wined3d_gl_info *gl_info, GLuint program, UINT64 key)
+{
+    struct glsl_program_cache_header header;
+    char path[MAX_PATH];
+    GLint status = GL_FALSE;
+    FILETIME now;
+    void *data = NULL;
+    HANDLE file;
+    DWORD read;
+
+    shader_glsl_program_cache_path(path, key);
+    file = CreateFileA(path, GENERIC_READ | FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, 0, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        InterlockedIncrement(&glsl_program_cache.misses);
+        return FALSE;
+    }
+
+    if (ReadFile(file, &header, sizeof(header), &read, NULL) && read == sizeof(header)
+            && header.magic == GLSL_PROGRAM_CACHE_MAGIC && header.version == GLSL_PROGRAM_CACHE_VERSION
+            && header.driver_hash == glsl_program_cache.driver_hash && header.key == key
+            && header.size && header.size <= GLSL_PROGRAM_CACHE_MAX_BINARY
+            && (data = HeapAlloc(GetProcessHeap(), 0, header.size))
+            && ReadFile(file, data, header.size, &read, NULL) && read == header.size)
+    {
+        GL_EXTCALL(glProgramBinary(program, header.format, data, header.size));
+        checkGLcall("glProgramBinary");
+        GL_EXTCALL(glGetProgramiv(program, GL_LINK_STATUS, &status));
+    }
+    HeapFree(GetProcessHeap(), 0, data);
+
+    if (status)
+    {
+        /* Keep track of the last use for eviction. */
+        GetSystemTimeAsFileTime(&now);
+        SetFileTime(file, NULL, NULL, &now);
+        InterlockedIncrement(&glsl_program_cache.hits);
+        TRACE("Loaded program %u from the cache.\n", program);
+    }
+    else
+    {
+        WARN("Ignoring stale program cache entry %s.\n", debugstr_a(path));
+        InterlockedIncrement(&glsl_program_cache.misses);
+    }
+    CloseHandle(file);
+    return status;
+}
+
+/* Context activation is done by the caller. */
+static void shader_glsl_store_program_binary(const struct wined3d_gl_info *gl_info, GLuint program, UINT64 key)
+{
+    struct glsl_program_cache_header *header;
+    char path[MAX_PATH], tmp_path[MAX_PATH];
+    GLint status = GL_FALSE, size = 0;
+    GLenum format;
+    HANDLE file;
+    DWORD written;
+    BOOL ret;
+
+    GL_EXTCALL(glGetProgramiv(program, GL_LINK_STATUS, &status));
+    if (!status)
+        return;
+    GL_EXTCALL(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size));
+    if (size <= 0 || size > GLSL_PROGRAM_CACHE_MAX_BINARY
+            || !(header = HeapAlloc(GetProcessHeap(), 0, sizeof(*header) + size)))
+        return;
+    GL_EXTCALL(glGetProgramBinary(program, size, &size, &format, header + 1));
+    checkGLcall("glGetProgramBinary");
+
+    header->magic = GLSL_PROGRAM_CACHE_MAGIC;
+    header->version = GLSL_PROGRAM_CACHE_VERSION;
+    header->driver_hash = glsl_program_cache.driver_hash;
+    header->key = key;
+    header->format = format;
+    header->size = size;
+
+    /* Write to a temporary file first, other processes may be reading the cache. */
+    shader_glsl_program_cache_path(path, key);
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%x", path, GetCurrentThreadId());
+    file = CreateFileA(tmp_path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        HeapFree(GetProcessHeap(), 0, header);
+        return;
+    }
+    ret = WriteFile(file, header, sizeof(*header) + size, &written, NULL) && written == sizeof(*header) + size;
+    CloseHandle(file);
+    HeapFree(GetProcessHeap(), 0, header);
+    if (!ret || !MoveFileExA(tmp_path, path, MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFileA(tmp_path);
+        return;
+    }
+
+    EnterCriticalSection(&glsl_program_cache_cs);
+    ++glsl_program_cache.stores;
+    glsl_program_cache.total_size += sizeof(*header) + size;
+    if (glsl_program_cache.total_size > glsl_program_cache.max_size)
+        shader_glsl_program_cache_evict();
+    LeaveCriticalSection(&glsl_program_cache_cs);
+}
+
+/* Context activation is done by the caller. */
+static void shader_glsl_compile_deferred_shader(const struct wined3d_gl_info *gl_info, GLuint shader)
+{
+    GLint status;
+
+    GL_EXTCALL(glGetShaderiv(shader, GL_COMPILE_STATUS, &status));
+    if (status)
+        return;
+    TRACE("Compiling deferred shader object %u.\n", shader);
+    GL_EXTCALL(glCompileShader(shader));
+    checkGLcall("glCompileShader");
+    print_glsl_info_log(gl_info, shader, FALSE);
+}
+
+/* Context activation is done by the caller. */
+static void shader_glsl_compile_attached_shaders(const struct wined3d_gl_info *gl_info, GLuint program)
+{
+    GLuint shaders[8];
+    GLsizei count = 0;
+    int i;
+
+    GL_EXTCALL(glGetAttachedShaders(program, sizeof(shaders) / sizeof(*shaders), &count, shaders));
+    for (i = 0; i < count; ++i)
+        shader_glsl_compile_deferred_shader(gl_info, shaders[i]);
+}
+
+/* Context activation is done by the caller. */
+static void shader_glsl_link_program(const struct wined3d_gl_info *gl_info, GLuint program, DWORD key_flags)
+{
+    UINT64 key = 0;
+
+    if (shader_glsl_use_program_cache(gl_info))
+    {
+        if (!(key_flags & GLSL_PROGRAM_KEY_NO_CACHE)
+                && (key = shader_glsl_program_cache_key(gl_info, program, key_flags)))
+        {
+            if (shader_glsl_load_program_binary(gl_info, program, key))
+                return;
+            GL_EXTCALL(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+        }
+        shader_glsl_compile_attached_shaders(gl_info, program);
+    }
+
+    TRACE("Linking GLSL shader program %u.\n", program);
+    GL_EXTCALL(glLinkProgram(program));
+    shader_glsl_validate_link(gl_info, program);
+
+    if (key)
+        shader_glsl_store_program_binary(gl_info, program, key);
+}
+
 static BOOL shader_glsl_use_layout_qualifier(const struct wined3d_gl_info *gl_info)
 {
     /* Layout qualifiers were introduced in GLSL 1.40. The Nvidia Legacy GPU
@@ -7275,7 +7732,7 @@ static void shader_glsl_generate_ps_epilogue(const struct wined3d_gl_info *gl_in
 }
 
 /* Context activation is done by the caller. */
-static GLuint shader_glsl_generate_pshader(const struct wined3d_context *context,
+static BOOL shader_glsl_generate_pshader(const struct wined3d_context *context,
         struct wined3d_string_buffer *buffer, struct wined3d_string_buffer_list *string_buffers,
         const struct wined3d_shader *shader,
         const struct ps_compile_args *args, struct ps_np2fixup_info *np2fixup_info)
@@ -7287,7 +7744,6 @@ static GLuint shader_glsl_generate_pshader(const struct wined3d_context *context
     const BOOL legacy_syntax = needs_legacy_glsl_syntax(gl_info);
     unsigned int i, extra_constants_needed = 0;
     struct shader_glsl_ctx_priv priv_ctx;
-    GLuint shader_id;
     DWORD map;
 
     memset(&priv_ctx, 0, sizeof(priv_ctx));
@@ -7545,7 +8001,7 @@ static GLuint shader_glsl_generate_pshader(const struct wined3d_context *context
 
     /* Base Shader Body */
     if (FAILED(shader_generate_code(shader, buffer, reg_maps, &priv_ctx, NULL, NULL)))
-        return 0;
+        return FALSE;
 
     /* In SM4+ the shader epilogue is generated by the "ret" instruction. */
     if (reg_maps->shader_version.major < 4)
@@ -7553,11 +8009,7 @@ static GLuint shader_glsl_generate_pshader(const struct wined3d_context *context
 
     shader_addline(buffer, "}\n");
 
-    shader_id = GL_EXTCALL(glCreateShader(GL_FRAGMENT_SHADER));
-    TRACE("Compiling shader object %u.\n", shader_id);
-    shader_glsl_compile(gl_info, shader_id, buffer->buffer);
-
-    return shader_id;
+    return TRUE;
 }
 
 static void shader_glsl_generate_vs_epilogue(const struct wined3d_gl_info *gl_info,
@@ -7604,7 +8056,7 @@ static void shader_glsl_generate_vs_epilogue(const struct wined3d_gl_info *gl_in
 }
 
 /* Context activation is done by the caller. */
-static GLuint shader_glsl_generate_vshader(const struct wined3d_context *context,
+static BOOL shader_glsl_generate_vshader(const struct wined3d_context *context,
         struct shader_glsl_priv *priv, const struct wined3d_shader *shader, const struct vs_compile_args *args)
 {
     struct wined3d_string_buffer_list *string_buffers = &priv->string_buffers;
@@ -7613,7 +8065,6 @@ static GLuint shader_glsl_generate_vshader(const struct wined3d_context *context
     struct wined3d_string_buffer *buffer = &priv->shader_buffer;
     const struct wined3d_gl_info *gl_info = context->gl_info;
     struct shader_glsl_ctx_priv priv_ctx;
-    GLuint shader_id;
     unsigned int i;
 
     memset(&priv_ctx, 0, sizeof(priv_ctx));
@@ -7671,7 +8122,7 @@ static GLuint shader_glsl_generate_vshader(const struct wined3d_context *context
 
     /* Base Shader Body */
     if (FAILED(shader_generate_code(shader, buffer, reg_maps, &priv_ctx, NULL, NULL)))
-        return 0;
+        return FALSE;
 
     /* In SM4+ the shader epilogue is generated by the "ret" instruction. */
     if (reg_maps->shader_version.major < 4)
@@ -7679,11 +8130,7 @@ static GLuint shader_glsl_generate_vshader(const struct wined3d_context *context
 
     shader_addline(buffer, "}\n");
 
-    shader_id = GL_EXTCALL(glCreateShader(GL_VERTEX_SHADER));
-    TRACE("Compiling shader object %u.\n", shader_id);
-    shader_glsl_compile(gl_info, shader_id, buffer->buffer);
-
-    return shader_id;
+    return TRUE;
 }
 
 static void shader_glsl_generate_default_control_point_phase(const struct wined3d_shader *shader,
@@ -7735,7 +8182,7 @@ static void shader_glsl_generate_shader_phase_invocation(struct wined3d_string_b
     }
 }
 
-static GLuint shader_glsl_generate_hull_shader(const struct wined3d_context *context,
+static BOOL shader_glsl_generate_hull_shader(const struct wined3d_context *context,
         struct shader_glsl_priv *priv, const struct wined3d_shader *shader)
 {
     struct wined3d_string_buffer_list *string_buffers = &priv->string_buffers;
@@ -7745,7 +8192,6 @@ static GLuint shader_glsl_generate_hull_shader(const struct wined3d_context *con
     const struct wined3d_hull_shader *hs = &shader->u.hs;
     const struct wined3d_shader_phase *phase;
     struct shader_glsl_ctx_priv priv_ctx;
-    GLuint shader_id;
     unsigned int i;
 
     memset(&priv_ctx, 0, sizeof(priv_ctx));
@@ -7780,7 +8226,7 @@ static GLuint shader_glsl_generate_hull_shader(const struct wined3d_context *con
         for (i = 0; i < phase->temporary_count; ++i)
             shader_addline(buffer, "vec4 R%u;\n", i);
         if (FAILED(shader_generate_code(shader, buffer, reg_maps, &priv_ctx, phase->start, phase->end)))
-            return 0;
+            return FALSE;
         shader_addline(buffer, "setup_hs_output(hs_out);\n");
     }
     else
@@ -7793,14 +8239,14 @@ static GLuint shader_glsl_generate_hull_shader(const struct wined3d_context *con
     {
         if (FAILED(shader_glsl_generate_shader_phase(shader, buffer, reg_maps, &priv_ctx,
                 &hs->phases.fork[i], "fork", i)))
-            return 0;
+            return FALSE;
     }
 
     for (i = 0; i < hs->phases.join_count; ++i)
     {
         if (FAILED(shader_glsl_generate_shader_phase(shader, buffer, reg_maps, &priv_ctx,
                 &hs->phases.join[i], "join", i)))
-            return 0;
+            return FALSE;
     }
 
     shader_addline(buffer, "void main()\n{\n");
@@ -7814,11 +8260,7 @@ static GLuint shader_glsl_generate_hull_shader(const struct wined3d_context *con
     shader_addline(buffer, "setup_patch_constant_output();\n");
     shader_addline(buffer, "}\n");
 
-    shader_id = GL_EXTCALL(glCreateShader(GL_TESS_CONTROL_SHADER));
-    TRACE("Compiling shader object %u.\n", shader_id);
-    shader_glsl_compile(gl_info, shader_id, buffer->buffer);
-
-    return shader_id;
+    return TRUE;
 }
 
 static void shader_glsl_generate_ds_epilogue(const struct wined3d_gl_info *gl_info,
@@ -7831,7 +8273,7 @@ static void shader_glsl_generate_ds_epilogue(const struct wined3d_gl_info *gl_in
         shader_glsl_fixup_position(buffer);
 }
 
-static GLuint shader_glsl_generate_domain_shader(const struct wined3d_context *context,
+static BOOL shader_glsl_generate_domain_shader(const struct wined3d_context *context,
         struct shader_glsl_priv *priv, const struct wined3d_shader *shader, const struct ds_compile_args *args)
 {
     struct wined3d_string_buffer_list *string_buffers = &priv->string_buffers;
@@ -7839,7 +8281,6 @@ static GLuint shader_glsl_generate_domain_shader(const struct wined3d_context *c
     struct wined3d_string_buffer *buffer = &priv->shader_buffer;
     const struct wined3d_gl_info *gl_info = context->gl_info;
     struct shader_glsl_ctx_priv priv_ctx;
-    GLuint shader_id;
 
     memset(&priv_ctx, 0, sizeof(priv_ctx));
     priv_ctx.cur_ds_args = args;
@@ -7913,19 +8354,15 @@ static GLuint shader_glsl_generate_domain_shader(const struct wined3d_context *c
     shader_addline(buffer, "setup_patch_constant_input();\n");
 
     if (FAILED(shader_generate_code(shader, buffer, reg_maps, &priv_ctx, NULL, NULL)))
-        return 0;
+        return FALSE;
 
     shader_addline(buffer, "}\n");
 
-    shader_id = GL_EXTCALL(glCreateShader(GL_TESS_EVALUATION_SHADER));
-    TRACE("Compiling shader object %u.\n", shader_id);
-    shader_glsl_compile(gl_info, shader_id, buffer->buffer);
-
-    return shader_id;
+    return TRUE;
 }
 
 /* Context activation is done by the caller. */
-static GLuint shader_glsl_generate_geometry_shader(const struct wined3d_context *context,
+static BOOL shader_glsl_generate_geometry_shader(const struct wined3d_context *context,
         struct shader_glsl_priv *priv, const struct wined3d_shader *shader, const struct gs_compile_args *args)
 {
     struct wined3d_string_buffer_list *string_buffers = &priv->string_buffers;
@@ -7933,7 +8370,6 @@ static GLuint shader_glsl_generate_geometry_shader(const struct wined3d_context
     struct wined3d_string_buffer *buffer = &priv->shader_buffer;
     const struct wined3d_gl_info *gl_info = context->gl_info;
     struct shader_glsl_ctx_priv priv_ctx;
-    GLuint shader_id;
 
     memset(&priv_ctx, 0, sizeof(priv_ctx));
     priv_ctx.string_buffers = string_buffers;
@@ -7958,14 +8394,10 @@ static GLuint shader_glsl_generate_geometry_shader(const struct wined3d_context
     shader_glsl_generate_sm4_output_setup(priv, shader, args->output_count, gl_info, TRUE);
     shader_addline(buffer, "void main()\n{\n");
     if (FAILED(shader_generate_code(shader, buffer, reg_maps, &priv_ctx, NULL, NULL)))
-        return 0;
+        return FALSE;
     shader_addline(buffer, "}\n");
 
-    shader_id = GL_EXTCALL(glCreateShader(GL_GEOMETRY_SHADER));
-    TRACE("Compiling shader object %u.\n", shader_id);
-    shader_glsl_compile(gl_info, shader_id, buffer->buffer);
-
-    return shader_id;
+    return TRUE;
 }
 
 static void shader_glsl_generate_shader_epilogue(const struct wined3d_shader_context *ctx)
@@ -7996,7 +8428,7 @@ static void shader_glsl_generate_shader_epilogue(const struct wined3d_shader_con
 }
 
 /* Context activation is done by the caller. */
-static GLuint shader_glsl_generate_compute_shader(const struct wined3d_context *context,
+static BOOL shader_glsl_generate_compute_shader(const struct wined3d_context *context,
         struct wined3d_string_buffer *buffer, struct wined3d_string_buffer_list *string_buffers,
         const struct wined3d_shader *shader)
 {
@@ -8004,7 +8436,6 @@ static GLuint shader_glsl_generate_compute_shader(const struct wined3d_context *
     const struct wined3d_shader_reg_maps *reg_maps = &shader->reg_maps;
     const struct wined3d_gl_info *gl_info = context->gl_info;
     struct shader_glsl_ctx_priv priv_ctx;
-    GLuint shader_id;
     unsigned int i;
 
     memset(&priv_ctx, 0, sizeof(priv_ctx));
@@ -8030,17 +8461,35 @@ static GLuint shader_glsl_generate_compute_shader(const struct wined3d_context *
     shader_generate_code(shader, buffer, reg_maps, &priv_ctx, NULL, NULL);
     shader_addline(buffer, "}\n");
 
-    shader_id = GL_EXTCALL(glCreateShader(GL_COMPUTE_SHADER));
-    TRACE("Compiling shader object %u.\n", shader_id);
-    shader_glsl_compile(gl_info, shader_id, buffer->buffer);
+    return TRUE;
+}
 
-    return shader_id;
+static UINT64 shader_glsl_generate_begin(void)
+{
+    LARGE_INTEGER counter;
+
+    if (!TRACE_ON(d3d_perf))
+        return 0;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
 }
 
-static GLuint find_glsl_pshader(const struct wined3d_context *context,
-        struct wined3d_string_buffer *buffer, struct wined3d_string_buffer_list *string_buffers,
-        struct wined3d_shader *shader,
-        const struct ps_compile_args *args, const struct ps_np2fixup_info **np2fixup_info)
+static void shader_glsl_generate_end(struct shader_glsl_priv *priv,
+        const struct wined3d_string_buffer *buffer, UINT64 start)
+{
+    LARGE_INTEGER counter;
+
+    if (!TRACE_ON(d3d_perf) || !start)
+        return;
+    QueryPerformanceCounter(&counter);
+    ++priv->generated_shaders;
+    priv->generated_size += buffer->content_size;
+    priv->generate_time += counter.QuadPart - start;
+}
+
+static GLuint find_glsl_pshader(const struct wined3d_context *context, struct shader_glsl_priv *priv,
+        struct wined3d_shader *shader, const struct ps_compile_args *args,
+        const struct ps_np2fixup_info **np2fixup_info)
 {
     struct glsl_ps_compiled_shader *gl_shaders, *new_array;
     struct glsl_shader_private *shader_data;
@@ -8048,6 +8497,7 @@ static GLuint find_glsl_pshader(const struct wined3d_context *context,
     UINT i;
     DWORD new_size;
     GLuint ret;
+    UINT64 start;
 
     if (!shader->backend_data)
     {
@@ -8069,6 +8519,11 @@ static GLuint find_glsl_pshader(const struct wined3d_context *context,
     {
         if (!memcmp(&gl_shaders[i].args, args, sizeof(*args)))
         {
+            if (gl_shaders[i].precompiled)
+            {
+                gl_shaders[i].precompiled = FALSE;
+                ++priv->precompile_hits;
+            }
             if (args->np2_fixup)
                 *np2fixup_info = &gl_shaders[i].np2fixup;
             return gl_shaders[i].id;
@@ -8099,6 +8554,7 @@ static GLuint find_glsl_pshader(const struct wined3d_context *context,
     }
 
     gl_shaders[shader_data->num_gl_shaders].args = *args;
+    gl_shaders[shader_data->num_gl_shaders].precompiled = FALSE;
 
     np2fixup = &gl_shaders[shader_data->num_gl_shaders].np2fixup;
     memset(np2fixup, 0, sizeof(*np2fixup));
@@ -8106,9 +8562,17 @@ static GLuint find_glsl_pshader(const struct wined3d_context *context,
 
     pixelshader_update_resource_types(shader, args->tex_types);
 
-    string_buffer_clear(buffer);
-    ret = shader_glsl_generate_pshader(context, buffer, string_buffers, shader, args, np2fixup);
+    string_buffer_clear(&priv->shader_buffer);
+    start = shader_glsl_generate_begin();
+    ret = 0;
+    if (shader_glsl_generate_pshader(context, &priv->shader_buffer, &priv->string_buffers,
+            shader, args, np2fixup))
+    {
+        shader_glsl_generate_end(priv, &priv->shader_buffer, start);
+        ret = shader_glsl_create_shader(context->gl_info, GL_FRAGMENT_SHADER, priv->shader_buffer.buffer);
+    }
     gl_shaders[shader_data->num_gl_shaders++].id = ret;
+    ++priv->compiled_variants;
 
     return ret;
 }
@@ -8140,6 +8604,7 @@ static GLuint find_glsl_vshader(const struct wined3d_context *context, struct sh
     struct glsl_vs_compiled_shader *gl_shaders, *new_array;
     struct glsl_shader_private *shader_data;
     GLuint ret;
+    UINT64 start;
 
     if (!shader->backend_data)
     {
@@ -8160,7 +8625,14 @@ static GLuint find_glsl_vshader(const struct wined3d_context *context, struct sh
     for (i = 0; i < shader_data->num_gl_shaders; ++i)
     {
         if (vs_args_equal(&gl_shaders[i].args, args, use_map))
+        {
+            if (gl_shaders[i].precompiled)
+            {
+                gl_shaders[i].precompiled = FALSE;
+                ++priv->precompile_hits;
+            }
             return gl_shaders[i].id;
+        }
     }
 
     TRACE("No matching GL shader found for shader %p, compiling a new shader.\n", shader);
@@ -8188,10 +8660,18 @@ static GLuint find_glsl_vshader(const struct wined3d_context *context, struct sh
     }
 
     gl_shaders[shader_data->num_gl_shaders].args = *args;
+    gl_shaders[shader_data->num_gl_shaders].precompiled = FALSE;
 
     string_buffer_clear(&priv->shader_buffer);
-    ret = shader_glsl_generate_vshader(context, priv, shader, args);
+    start = shader_glsl_generate_begin();
+    ret = 0;
+    if (shader_glsl_generate_vshader(context, priv, shader, args))
+    {
+        shader_glsl_generate_end(priv, &priv->shader_buffer, start);
+        ret = shader_glsl_create_shader(context->gl_info, GL_VERTEX_SHADER, priv->shader_buffer.buffer);
+    }
     gl_shaders[shader_data->num_gl_shaders++].id = ret;
+    ++priv->compiled_variants;
 
     return ret;
 }
@@ -8203,6 +8683,7 @@ static GLuint find_glsl_hull_shader(const struct wined3d_context *context,
     struct glsl_shader_private *shader_data;
     unsigned int new_size;
     GLuint ret;
+    UINT64 start;
 
     if (!shader->backend_data)
     {
@@ -8236,7 +8717,13 @@ static GLuint find_glsl_hull_shader(const struct wined3d_context *context,
     gl_shaders = new_array;
 
     string_buffer_clear(&priv->shader_buffer);
-    ret = shader_glsl_generate_hull_shader(context, priv, shader);
+    start = shader_glsl_generate_begin();
+    ret = 0;
+    if (shader_glsl_generate_hull_shader(context, priv, shader))
+    {
+        shader_glsl_generate_end(priv, &priv->shader_buffer, start);
+        ret = shader_glsl_create_shader(context->gl_info, GL_TESS_CONTROL_SHADER, priv->shader_buffer.buffer);
+    }
     gl_shaders[shader_data->num_gl_shaders++].id = ret;
 
     return ret;
@@ -8249,6 +8736,7 @@ static GLuint find_glsl_domain_shader(const struct wined3d_context *context,
     struct glsl_shader_private *shader_data;
     unsigned int i, new_size;
     GLuint ret;
+    UINT64 start;
 
     if (!shader->backend_data)
     {
@@ -8291,7 +8779,13 @@ static GLuint find_glsl_domain_shader(const struct wined3d_context *context,
     gl_shaders = new_array;
 
     string_buffer_clear(&priv->shader_buffer);
-    ret = shader_glsl_generate_domain_shader(context, priv, shader, args);
+    start = shader_glsl_generate_begin();
+    ret = 0;
+    if (shader_glsl_generate_domain_shader(context, priv, shader, args))
+    {
+        shader_glsl_generate_end(priv, &priv->shader_buffer, start);
+        ret = shader_glsl_create_shader(context->gl_info, GL_TESS_EVALUATION_SHADER, priv->shader_buffer.buffer);
+    }
     gl_shaders[shader_data->num_gl_shaders].args = *args;
     gl_shaders[shader_data->num_gl_shaders++].id = ret;
 
@@ -8305,6 +8799,7 @@ static GLuint find_glsl_geometry_shader(const struct wined3d_context *context,
     struct glsl_shader_private *shader_data;
     unsigned int i, new_size;
     GLuint ret;
+    UINT64 start;
 
     if (!shader->backend_data)
     {
@@ -8347,7 +8842,13 @@ static GLuint find_glsl_geometry_shader(const struct wined3d_context *context,
     gl_shaders = new_array;
 
     string_buffer_clear(&priv->shader_buffer);
-    ret = shader_glsl_generate_geometry_shader(context, priv, shader, args);
+    start = shader_glsl_generate_begin();
+    ret = 0;
+    if (shader_glsl_generate_geometry_shader(context, priv, shader, args))
+    {
+        shader_glsl_generate_end(priv, &priv->shader_buffer, start);
+        ret = shader_glsl_create_shader(context->gl_info, GL_GEOMETRY_SHADER, priv->shader_buffer.buffer);
+    }
     gl_shaders[shader_data->num_gl_shaders].args = *args;
     gl_shaders[shader_data->num_gl_shaders++].id = ret;
 
@@ -9671,6 +10172,7 @@ static HRESULT shader_glsl_compile_compute_shader(struct shader_glsl_priv *priv,
     struct glsl_shader_private *shader_data;
     struct glsl_shader_prog_link *entry;
     GLuint shader_id, program_id;
+    UINT64 start;
 
     if (!(entry = HeapAlloc(GetProcessHeap(), 0, sizeof(*entry))))
     {
@@ -9701,7 +10203,10 @@ static HRESULT shader_glsl_compile_compute_shader(struct shader_glsl_priv *priv,
     TRACE("Compiling compute shader %p.\n", shader);
 
     string_buffer_clear(buffer);
-    shader_id = shader_glsl_generate_compute_shader(context, buffer, &priv->string_buffers, shader);
+    start = shader_glsl_generate_begin();
+    shader_glsl_generate_compute_shader(context, buffer, &priv->string_buffers, shader);
+    shader_glsl_generate_end(priv, buffer, start);
+    shader_id = shader_glsl_create_shader(context->gl_info, GL_COMPUTE_SHADER, buffer->buffer);
     gl_shaders[shader_data->num_gl_shaders++].id = shader_id;
 
     program_id = GL_EXTCALL(glCreateProgram());
@@ -9724,9 +10229,7 @@ static HRESULT shader_glsl_compile_compute_shader(struct shader_glsl_priv *priv,
 
     list_add_head(&shader->linked_programs, &entry->cs.shader_entry);
 
-    TRACE("Linking GLSL shader program %u.\n", program_id);
-    GL_EXTCALL(glLinkProgram(program_id));
-    shader_glsl_validate_link(gl_info, program_id);
+    shader_glsl_link_program(gl_info, program_id, GLSL_PROGRAM_KEY_COMPUTE);
 
     GL_EXTCALL(glUseProgram(program_id));
     checkGLcall("glUseProgram");
@@ -9807,6 +10310,7 @@ static void set_glsl_shader_program(const struct wined3d_context *context, const
     GLuint ps_id = 0;
     struct list *ps_list = NULL, *vs_list = NULL;
     WORD attribs_map;
+    DWORD key_flags = 0;
     struct wined3d_string_buffer *tmp_name;
 
     if (!(context->shader_update_mask & (1u << WINED3D_SHADER_TYPE_VERTEX)) && ctx_data->glsl_program)
@@ -9883,8 +10387,7 @@ static void set_glsl_shader_program(const struct wined3d_context *context, const
         struct ps_compile_args ps_compile_args;
         pshader = state->shader[WINED3D_SHADER_TYPE_PIXEL];
         find_ps_compile_args(state, pshader, context->stream_info.position_transformed, &ps_compile_args, context);
-        ps_id = find_glsl_pshader(context, &priv->shader_buffer, &priv->string_buffers,
-                pshader, &ps_compile_args, &np2fixup_info);
+        ps_id = find_glsl_pshader(context, priv, pshader, &ps_compile_args, &np2fixup_info);
         ps_list = &pshader->linked_programs;
     }
     else if (priv->fragment_pipe == &glsl_fragment_pipe
@@ -9945,6 +10448,8 @@ static void set_glsl_shader_program(const struct wined3d_context *context, const
     if (vshader)
     {
         attribs_map = vshader->reg_maps.input_registers;
+        if (vshader->reg_maps.shader_version.major >= 4)
+            key_flags |= GLSL_PROGRAM_KEY_VS_SM4;
         if (vshader->reg_maps.shader_version.major < 4)
         {
             reorder_shader_id = shader_glsl_generate_vs3_rasterizer_input_setup(priv, vshader, pshader,
@@ -9963,6 +10468,9 @@ static void set_glsl_shader_program(const struct wined3d_context *context, const
     {
         attribs_map = (1u << WINED3D_FFP_ATTRIBS_COUNT) - 1;
     }
+    key_flags |= attribs_map;
+    if (wined3d_dualblend_enabled(state, gl_info))
+        key_flags |= GLSL_PROGRAM_KEY_DUAL_BLEND;
 
     if (!shader_glsl_use_explicit_attrib_location(gl_info))
     {
@@ -10044,6 +10552,9 @@ static void set_glsl_shader_program(const struct wined3d_context *context, const
         checkGLcall("glAttachShader");
 
         shader_glsl_init_transform_feedback(context, priv, program_id, gshader);
+        /* Transform feedback varyings aren't part of the program key. */
+        if (gshader->u.gs.so_desc.element_count)
+            key_flags |= GLSL_PROGRAM_KEY_NO_CACHE;
 
         list_add_head(&gshader->linked_programs, &entry->gs.shader_entry);
     }
@@ -10059,9 +10570,7 @@ static void set_glsl_shader_program(const struct wined3d_context *context, const
     }
 
     /* Link the program */
-    TRACE("Linking GLSL shader program %u.\n", program_id);
-    GL_EXTCALL(glLinkProgram(program_id));
-    shader_glsl_validate_link(gl_info, program_id);
+    shader_glsl_link_program(gl_info, program_id, key_flags);
 
     shader_glsl_init_vs_uniform_locations(gl_info, priv, program_id, &entry->vs,
             vshader ? vshader->limits->constant_float : 0);
@@ -10205,19 +10714,272 @@ static void set_glsl_shader_program(const struct wined3d_context *context, const
     }
 }
 
+/* Translate and compile a new vertex or pixel shader for the current state,
+ * so that typically only linking is left for the first draw that uses it.
+ * This runs on the command stream thread, while the application keeps going. */
+static void shader_glsl_precompile_variant(struct shader_glsl_priv *priv, struct wined3d_shader *shader)
+{
+    const struct wined3d_state *state = &shader->device->cs->state;
+    enum wined3d_shader_type type = shader->reg_maps.shader_version.type;
+    const struct ps_np2fixup_info *np2fixup_info;
+    struct glsl_shader_private *shader_data;
+    struct wined3d_context *context;
+    struct vs_compile_args vs_args;
+    struct ps_compile_args ps_args;
+    unsigned int variant_count;
+    GLuint shader_id;
+
+    if (!wined3d_settings.shader_precompile || !shader->device->d3d_initialized)
+        return;
+    /* Projected texture fixups for ps_1_x look at the vertex declaration. */
+    if (type == WINED3D_SHADER_TYPE_PIXEL && !state->shader[WINED3D_SHADER_TYPE_VERTEX]
+            && !state->vertex_declaration)
+        return;
+
+    variant_count = (shader_data = shader->backend_data) ? shader_data->num_gl_shaders : 0;
+
+    context = context_acquire(shader->device, NULL, 0);
+    if (type == WINED3D_SHADER_TYPE_VERTEX)
+    {
+        find_vs_compile_args(state, shader, context->stream_info.swizzle_map, &vs_args, context->d3d_info);
+        shader_id = find_glsl_vshader(context, priv, shader, &vs_args);
+    }
+    else
+    {
+        find_ps_compile_args(state, shader, context->stream_info.position_transformed, &ps_args, context);
+        shader_id = find_glsl_pshader(context, priv, shader, &ps_args, &np2fixup_info);
+    }
+    /* With the program cache, shader_glsl_compile() leaves compiling to link
+     * time. Do it here instead, it's the expensive part. */
+    if (shader_id)
+        shader_glsl_compile_deferred_shader(context->gl_info, shader_id);
+    context_release(context);
+
+    if (!(shader_data = shader->backend_data) || shader_data->num_gl_shaders <= variant_count)
+        return;
+    if (type == WINED3D_SHADER_TYPE_VERTEX)
+        shader_data->gl_shaders.vs[shader_data->num_gl_shaders - 1].precompiled = TRUE;
+    else
+        shader_data->gl_shaders.ps[shader_data->num_gl_shaders - 1].precompiled = TRUE;
+    ++priv->precompiled_variants;
+}
+
 static void shader_glsl_precompile(void *shader_priv, struct wined3d_shader *shader)
 {
     struct wined3d_device *device = shader->device;
     struct wined3d_context *context;
 
-    if (shader->reg_maps.shader_version.type == WINED3D_SHADER_TYPE_COMPUTE)
+    switch (shader->reg_maps.shader_version.type)
     {
-        context = context_acquire(device, NULL, 0);
-        shader_glsl_compile_compute_shader(shader_priv, context, shader);
-        context_release(context);
+        case WINED3D_SHADER_TYPE_COMPUTE:
+            context = context_acquire(device, NULL, 0);
+            shader_glsl_compile_compute_shader(shader_priv, context, shader);
+            context_release(context);
+            break;
+
+        case WINED3D_SHADER_TYPE_VERTEX:
+        case WINED3D_SHADER_TYPE_PIXEL:
+            shader_glsl_precompile_variant(shader_priv, shader);
+            break;
+
+        default:
+            break;
     }
 }
 
+static const enum wined3d_gl_extension shader_glsl_offline_extensions[] =
+{
+    ARB_CLIP_CONTROL,
+    ARB_COMPUTE_SHADER,
+    ARB_CONSERVATIVE_DEPTH,
+    ARB_DERIVATIVE_CONTROL,
+    ARB_DRAW_INSTANCED,
+    ARB_EXPLICIT_ATTRIB_LOCATION,
+    ARB_FRAGMENT_COORD_CONVENTIONS,
+    ARB_FRAGMENT_LAYER_VIEWPORT,
+    ARB_GPU_SHADER5,
+    ARB_SAMPLER_OBJECTS,
+    ARB_SHADER_ATOMIC_COUNTERS,
+    ARB_SHADER_BIT_ENCODING,
+    ARB_SHADER_IMAGE_LOAD_STORE,
+    ARB_SHADER_IMAGE_SIZE,
+    ARB_SHADER_STORAGE_BUFFER_OBJECT,
+    ARB_SHADER_TEXTURE_LOD,
+    ARB_SHADING_LANGUAGE_420PACK,
+    ARB_SHADING_LANGUAGE_PACKING,
+    ARB_TESSELLATION_SHADER,
+    ARB_TEXTURE_CUBE_MAP_ARRAY,
+    ARB_TEXTURE_GATHER,
+    ARB_TEXTURE_QUERY_LEVELS,
+    ARB_TEXTURE_SWIZZLE,
+    ARB_TRANSFORM_FEEDBACK3,
+    ARB_UNIFORM_BUFFER_OBJECT,
+    EXT_TEXTURE_ARRAY,
+    WINED3D_GL_VERSION_3_2,
+};
+
+/* Set up an adapter for translating shaders without a GL context. It exposes
+ * the features of a GL 4.4 core profile, or of GL 2.1 for legacy GLSL. */
+void shader_glsl_init_offline_adapter(struct wined3d_adapter *adapter, BOOL legacy)
+{
+    struct wined3d_gl_info *gl_info = &adapter->gl_info;
+    struct wined3d_d3d_info *d3d_info = &adapter->d3d_info;
+    struct shader_caps shader_caps;
+    unsigned int i;
+
+    gl_info->supported[WINED3D_GL_EXT_NONE] = TRUE;
+    gl_info->supported[ARB_VERTEX_SHADER] = TRUE;
+    gl_info->supported[ARB_FRAGMENT_SHADER] = TRUE;
+    if (legacy)
+    {
+        gl_info->glsl_version = MAKEDWORD_VERSION(1, 20);
+        gl_info->supported[ARB_SHADER_TEXTURE_LOD] = TRUE;
+        gl_info->supported[ARB_TEXTURE_RECTANGLE] = TRUE;
+        gl_info->supported[WINED3D_GL_LEGACY_CONTEXT] = TRUE;
+    }
+    else
+    {
+        gl_info->glsl_version = MAKEDWORD_VERSION(4, 40);
+        for (i = 0; i < ARRAY_SIZE(shader_glsl_offline_extensions); ++i)
+            gl_info->supported[shader_glsl_offline_extensions[i]] = TRUE;
+    }
+
+    gl_info->limits.buffers = 8;
+    gl_info->limits.dual_buffers = 1;
+    gl_info->limits.textures = MAX_TEXTURES;
+    gl_info->limits.texture_coords = MAX_TEXTURES;
+    for (i = 0; i < WINED3D_SHADER_TYPE_COUNT; ++i)
+    {
+        gl_info->limits.uniform_blocks[i] = legacy ? 0 : WINED3D_MAX_CBS;
+        gl_info->limits.samplers[i] = legacy && i != WINED3D_SHADER_TYPE_PIXEL ? 0 : MAX_FRAGMENT_SAMPLERS;
+        gl_info->limits.combined_samplers += gl_info->limits.samplers[i];
+    }
+    gl_info->limits.graphics_samplers = gl_info->limits.combined_samplers
+            - gl_info->limits.samplers[WINED3D_SHADER_TYPE_COMPUTE];
+    gl_info->limits.user_clip_distances = 8;
+    gl_info->limits.vertex_attribs = MAX_ATTRIBS;
+    gl_info->limits.glsl_varyings = legacy ? 64 : 128;
+    gl_info->limits.glsl_vs_float_constants = 1024;
+    gl_info->limits.glsl_ps_float_constants = 1024;
+
+    glsl_shader_backend.shader_get_caps(gl_info, &shader_caps);
+    d3d_info->limits.vs_version = shader_caps.vs_version;
+    d3d_info->limits.hs_version = shader_caps.hs_version;
+    d3d_info->limits.ds_version = shader_caps.ds_version;
+    d3d_info->limits.gs_version = shader_caps.gs_version;
+    d3d_info->limits.ps_version = shader_caps.ps_version;
+    d3d_info->limits.cs_version = shader_caps.cs_version;
+    d3d_info->limits.vs_uniform_count = shader_caps.vs_uniform_count;
+    d3d_info->limits.ps_uniform_count = shader_caps.ps_uniform_count;
+    d3d_info->limits.varying_count = shader_caps.varying_count;
+}
+
+/* Generate the GLSL for a shader created on an offline adapter, with the
+ * compile arguments of a simple pipeline. No GL objects are created. */
+HRESULT shader_glsl_translate(struct wined3d_shader *shader, struct wined3d_shader_translation *translation)
+{
+    const struct wined3d_adapter *adapter = shader->device->adapter;
+    struct ps_np2fixup_info np2fixup_info;
+    struct wined3d_context *context;
+    struct shader_glsl_priv *priv;
+    struct vs_compile_args vs_args;
+    struct ps_compile_args ps_args;
+    struct ds_compile_args ds_args;
+    struct gs_compile_args gs_args;
+    HRESULT hr = WINED3D_OK;
+    unsigned int i;
+    BOOL ret;
+
+    if (!(context = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*context))))
+        return E_OUTOFMEMORY;
+    if (!(priv = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*priv))))
+    {
+        HeapFree(GetProcessHeap(), 0, context);
+        return E_OUTOFMEMORY;
+    }
+    if (!string_buffer_init(&priv->shader_buffer))
+    {
+        HeapFree(GetProcessHeap(), 0, priv);
+        HeapFree(GetProcessHeap(), 0, context);
+        return E_OUTOFMEMORY;
+    }
+    string_buffer_list_init(&priv->string_buffers);
+    context->gl_info = &adapter->gl_info;
+    context->d3d_info = &adapter->d3d_info;
+
+    switch (shader->reg_maps.shader_version.type)
+    {
+        case WINED3D_SHADER_TYPE_VERTEX:
+            memset(&vs_args, 0, sizeof(vs_args));
+            vs_args.fog_src = VS_FOG_COORD;
+            vs_args.per_vertex_point_size = shader->reg_maps.point_size;
+            vs_args.next_shader_type = WINED3D_SHADER_TYPE_PIXEL;
+            if (shader->reg_maps.shader_version.major >= 4)
+                vs_args.next_shader_input_count = shader->limits->packed_output;
+            ret = shader_glsl_generate_vshader(context, priv, shader, &vs_args);
+            break;
+
+        case WINED3D_SHADER_TYPE_PIXEL:
+            memset(&ps_args, 0, sizeof(ps_args));
+            for (i = 0; i < ARRAY_SIZE(ps_args.color_fixup); ++i)
+                ps_args.color_fixup[i] = COLOR_FIXUP_IDENTITY;
+            ps_args.vp_mode = vertexshader;
+            ps_args.render_offscreen = 1;
+            pixelshader_update_resource_types(shader, ps_args.tex_types);
+            memset(&np2fixup_info, 0, sizeof(np2fixup_info));
+            ret = shader_glsl_generate_pshader(context, &priv->shader_buffer, &priv->string_buffers,
+                    shader, &ps_args, &np2fixup_info);
+            break;
+
+        case WINED3D_SHADER_TYPE_HULL:
+            ret = shader_glsl_generate_hull_shader(context, priv, shader);
+            break;
+
+        case WINED3D_SHADER_TYPE_DOMAIN:
+            memset(&ds_args, 0, sizeof(ds_args));
+            ds_args.tessellator_output_primitive = WINED3D_TESSELLATOR_OUTPUT_TRIANGLE_CW;
+            ds_args.tessellator_partitioning = WINED3D_TESSELLATOR_PARTITIONING_INTEGER;
+            ds_args.output_count = shader->limits->packed_output;
+            ds_args.next_shader_type = WINED3D_SHADER_TYPE_PIXEL;
+            ds_args.render_offscreen = 1;
+            ret = shader_glsl_generate_domain_shader(context, priv, shader, &ds_args);
+            break;
+
+        case WINED3D_SHADER_TYPE_GEOMETRY:
+            gs_args.output_count = shader->limits->packed_output;
+            ret = shader_glsl_generate_geometry_shader(context, priv, shader, &gs_args);
+            break;
+
+        case WINED3D_SHADER_TYPE_COMPUTE:
+            ret = shader_glsl_generate_compute_shader(context, &priv->shader_buffer, &priv->string_buffers, shader);
+            break;
+
+        default:
+            FIXME("Unhandled shader type %#x.\n", shader->reg_maps.shader_version.type);
+            ret = FALSE;
+            break;
+    }
+
+    if (!ret)
+    {
+        hr = WINED3DERR_INVALIDCALL;
+    }
+    else
+    {
+        translation->glsl_size = priv->shader_buffer.content_size;
+        translation->string_buffer_count = priv->string_buffers.allocated;
+        if (translation->glsl && translation->glsl_buffer_size > translation->glsl_size)
+            memcpy(translation->glsl, priv->shader_buffer.buffer, translation->glsl_size + 1);
+    }
+
+    string_buffer_list_cleanup(&priv->string_buffers);
+    string_buffer_free(&priv->shader_buffer);
+    HeapFree(GetProcessHeap(), 0, priv);
+    HeapFree(GetProcessHeap(), 0, context);
+
+    return hr;
+}
+
 /* Context activation is done by the caller. */
 static void shader_glsl_select(void *shader_priv, struct wined3d_context *context,
         const struct wined3d_state *state)
@@ -10663,6 +11425,24 @@ static void shader_glsl_free(struct wined3d_device *device)
 {
     struct shader_glsl_priv *priv = device->shader_priv;
 
+    TRACE_(d3d_perf)("Compiled %u shader variants, %u at shader creation, %u of which were used by a draw.\n",
+            priv->compiled_variants, priv->precompiled_variants, priv->precompile_hits);
+    if (priv->generate_time)
+    {
+        LARGE_INTEGER freq;
+
+        QueryPerformanceFrequency(&freq);
+        TRACE_(d3d_perf)("Generated %u shaders, %s bytes of GLSL, in %.3f ms (%.1f shaders/s), "
+                "%u temporary string buffers allocated.\n", priv->generated_shaders,
+                wine_dbgstr_longlong(priv->generated_size), priv->generate_time * 1000.0 / freq.QuadPart,
+                priv->generated_shaders * (double)freq.QuadPart / priv->generate_time,
+                priv->string_buffers.allocated);
+    }
+    if (glsl_program_cache.state > 0)
+        TRACE_(d3d_perf)("GLSL program cache: %u hits, %u misses, %u stores, %u evictions.\n",
+                glsl_program_cache.hits, glsl_program_cache.misses,
+                glsl_program_cache.stores, glsl_program_cache.evictions);
+
     wine_rb_destroy(&priv->program_lookup, NULL, NULL);
     constant_heap_free(&priv->pconst_heap);
     constant_heap_free(&priv->vconst_heap);
@@ -11782,12 +12562,12 @@ static void glsl_fragment_pipe_alpha_test(struct wined3d_context *context,
 
     if (state->render_states[WINED3D_RS_ALPHATESTENABLE])
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_ALPHA_TEST);
+        context_enable_gl_cap(context, GL_ALPHA_TEST);
         checkGLcall("glEnable(GL_ALPHA_TEST)");
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_ALPHA_TEST);
+        context_disable_gl_cap(context, GL_ALPHA_TEST);
         checkGLcall("glDisable(GL_ALPHA_TEST)");
     }
 }
@@ -32,6 +32,7 @@
 #include "wined3d_private.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d_shader);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 
 /* pow, mul_high, sub_high, mul_low */
 const float wined3d_srgb_const0[] = {0.41666f, 1.055f, 0.055f, 12.92f};
@@ -505,6 +506,7 @@ struct wined3d_string_buffer *string_buffer_get(struct wined3d_string_buffer_lis
             HeapFree(GetProcessHeap(), 0, buffer);
             return NULL;
         }
+        ++list->allocated;
     }
     else
     {
@@ -550,6 +552,7 @@ void string_buffer_release(struct wined3d_string_buffer_list *list, struct wined
 void string_buffer_list_init(struct wined3d_string_buffer_list *list)
 {
     list_init(&list->list);
+    list->allocated = 0;
 }
 
 void string_buffer_list_cleanup(struct wined3d_string_buffer_list *list)
@@ -3210,10 +3213,16 @@ static HRESULT shader_set_function(struct wined3d_shader *shader, DWORD float_co
     HRESULT hr;
     unsigned int backend_version;
     const struct wined3d_d3d_info *d3d_info = &shader->device->adapter->d3d_info;
+    LARGE_INTEGER start, end, freq;
 
     TRACE("shader %p, float_const_count %u, type %#x, max_version %u.\n",
             shader, float_const_count, type, max_version);
 
+    /* The channel can be enabled while parsing, don't use an unset start time. */
+    start.QuadPart = 0;
+    if (TRACE_ON(d3d_perf))
+        QueryPerformanceCounter(&start);
+
     fe = shader->frontend;
     if (!(shader->frontend_data = fe->shader_init(shader->function,
             shader->functionLength, &shader->output_signature)))
@@ -3231,6 +3240,14 @@ static HRESULT shader_set_function(struct wined3d_shader *shader, DWORD float_co
             &shader->output_signature, float_const_count)))
         return hr;
 
+    if (TRACE_ON(d3d_perf) && start.QuadPart)
+    {
+        QueryPerformanceCounter(&end);
+        QueryPerformanceFrequency(&freq);
+        TRACE_(d3d_perf)("Parsed %u bytes of bytecode for shader %p in %.3f ms.\n", shader->functionLength,
+                shader, (end.QuadPart - start.QuadPart) * 1000.0 / freq.QuadPart);
+    }
+
     if (reg_maps->shader_version.type != type)
     {
         WARN("Wrong shader type %d.\n", reg_maps->shader_version.type);
@@ -3604,8 +3621,6 @@ static HRESULT shader_init(struct wined3d_shader *shader, struct wined3d_device
 
     shader->load_local_constsF = shader->lconst_inf_or_nan;
 
-    wined3d_cs_init_object(shader->device->cs, wined3d_shader_init_object, shader);
-
     return hr;
 }
 
@@ -4050,6 +4065,8 @@ HRESULT CDECL wined3d_shader_create_cs(struct wined3d_device *device, const stru
         return hr;
     }
 
+    wined3d_cs_init_object(device->cs, wined3d_shader_init_object, object);
+
     TRACE("Created compute shader %p.\n", object);
     *shader = object;
 
@@ -4075,6 +4092,8 @@ HRESULT CDECL wined3d_shader_create_ds(struct wined3d_device *device, const stru
         return hr;
     }
 
+    wined3d_cs_init_object(device->cs, wined3d_shader_init_object, object);
+
     TRACE("Created domain shader %p.\n", object);
     *shader = object;
 
@@ -4101,6 +4120,8 @@ HRESULT CDECL wined3d_shader_create_gs(struct wined3d_device *device, const stru
         return hr;
     }
 
+    wined3d_cs_init_object(device->cs, wined3d_shader_init_object, object);
+
     TRACE("Created geometry shader %p.\n", object);
     *shader = object;
 
@@ -4126,6 +4147,8 @@ HRESULT CDECL wined3d_shader_create_hs(struct wined3d_device *device, const stru
         return hr;
     }
 
+    wined3d_cs_init_object(device->cs, wined3d_shader_init_object, object);
+
     TRACE("Created hull shader %p.\n", object);
     *shader = object;
 
@@ -4152,6 +4175,8 @@ HRESULT CDECL wined3d_shader_create_ps(struct wined3d_device *device, const stru
         return hr;
     }
 
+    wined3d_cs_init_object(device->cs, wined3d_shader_init_object, object);
+
     TRACE("Created pixel shader %p.\n", object);
     *shader = object;
 
@@ -4178,8 +4203,87 @@ HRESULT CDECL wined3d_shader_create_vs(struct wined3d_device *device, const stru
         return hr;
     }
 
+    wined3d_cs_init_object(device->cs, wined3d_shader_init_object, object);
+
     TRACE("Created vertex shader %p.\n", object);
     *shader = object;
 
     return WINED3D_OK;
 }
+
+HRESULT CDECL wined3d_shader_translate(const struct wined3d_shader_desc *desc, DWORD flags,
+        struct wined3d_shader_translation *translation)
+{
+    const struct wined3d_shader_frontend *fe;
+    struct wined3d_shader_version shader_version;
+    struct wined3d_adapter *adapter;
+    struct wined3d_device *device;
+    struct wined3d_shader *shader;
+    const DWORD *ptr;
+    void *fe_data;
+    HRESULT hr;
+
+    TRACE("desc %p, flags %#x, translation %p.\n", desc, flags, translation);
+
+    if (!desc->byte_code || !(fe = shader_select_frontend(desc->format)))
+        return WINED3DERR_INVALIDCALL;
+    if (!(fe_data = fe->shader_init(desc->byte_code, desc->byte_code_size, &desc->output_signature)))
+        return WINED3DERR_INVALIDCALL;
+    fe->shader_read_header(fe_data, &ptr, &shader_version);
+    fe->shader_free(fe_data);
+
+    adapter = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*adapter));
+    device = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*device));
+    shader = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(*shader));
+    if (!adapter || !device || !shader)
+    {
+        HeapFree(GetProcessHeap(), 0, shader);
+        HeapFree(GetProcessHeap(), 0, device);
+        HeapFree(GetProcessHeap(), 0, adapter);
+        return E_OUTOFMEMORY;
+    }
+
+    /* The shader is only parsed and translated, it never reaches a command
+     * stream or a GL context. */
+    shader_glsl_init_offline_adapter(adapter, flags & WINED3D_SHADER_TRANSLATE_LEGACY_GLSL);
+    device->adapter = adapter;
+    device->shader_backend = &glsl_shader_backend;
+
+    switch (shader_version.type)
+    {
+        case WINED3D_SHADER_TYPE_VERTEX:
+            hr = vertex_shader_init(shader, device, desc, NULL, &wined3d_null_parent_ops);
+            break;
+        case WINED3D_SHADER_TYPE_HULL:
+            hr = hull_shader_init(shader, device, desc, NULL, &wined3d_null_parent_ops);
+            break;
+        case WINED3D_SHADER_TYPE_DOMAIN:
+            hr = domain_shader_init(shader, device, desc, NULL, &wined3d_null_parent_ops);
+            break;
+        case WINED3D_SHADER_TYPE_GEOMETRY:
+            hr = geometry_shader_init(shader, device, desc, NULL, NULL, &wined3d_null_parent_ops);
+            break;
+        case WINED3D_SHADER_TYPE_PIXEL:
+            hr = pixel_shader_init(shader, device, desc, NULL, &wined3d_null_parent_ops);
+            break;
+        case WINED3D_SHADER_TYPE_COMPUTE:
+            hr = compute_shader_init(shader, device, desc, NULL, &wined3d_null_parent_ops);
+            break;
+        default:
+            WARN("Unhandled shader type %#x.\n", shader_version.type);
+            hr = WINED3DERR_INVALIDCALL;
+            break;
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = shader_glsl_translate(shader, translation);
+        shader_cleanup(shader);
+    }
+
+    HeapFree(GetProcessHeap(), 0, shader);
+    HeapFree(GetProcessHeap(), 0, device);
+    HeapFree(GetProcessHeap(), 0, adapter);
+
+    return hr;
+}
@@ -149,12 +149,12 @@ static void state_lighting(struct wined3d_context *context, const struct wined3d
     if (state->render_states[WINED3D_RS_LIGHTING]
             && !context->stream_info.position_transformed)
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_LIGHTING);
+        context_enable_gl_cap(context, GL_LIGHTING);
         checkGLcall("glEnable GL_LIGHTING");
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_LIGHTING);
+        context_disable_gl_cap(context, GL_LIGHTING);
         checkGLcall("glDisable GL_LIGHTING");
     }
 }
@@ -174,15 +174,15 @@ static void state_zenable(struct wined3d_context *context, const struct wined3d_
     switch (zenable)
     {
         case WINED3D_ZB_FALSE:
-            gl_info->gl_ops.gl.p_glDisable(GL_DEPTH_TEST);
+            context_disable_gl_cap(context, GL_DEPTH_TEST);
             checkGLcall("glDisable GL_DEPTH_TEST");
             break;
         case WINED3D_ZB_TRUE:
-            gl_info->gl_ops.gl.p_glEnable(GL_DEPTH_TEST);
+            context_enable_gl_cap(context, GL_DEPTH_TEST);
             checkGLcall("glEnable GL_DEPTH_TEST");
             break;
         case WINED3D_ZB_USEW:
-            gl_info->gl_ops.gl.p_glEnable(GL_DEPTH_TEST);
+            context_enable_gl_cap(context, GL_DEPTH_TEST);
             checkGLcall("glEnable GL_DEPTH_TEST");
             FIXME("W buffer is not well handled\n");
             break;
@@ -204,17 +204,17 @@ static void state_cullmode(struct wined3d_context *context, const struct wined3d
     switch (state->render_states[WINED3D_RS_CULLMODE])
     {
         case WINED3D_CULL_NONE:
-            gl_info->gl_ops.gl.p_glDisable(GL_CULL_FACE);
+            context_disable_gl_cap(context, GL_CULL_FACE);
             checkGLcall("glDisable GL_CULL_FACE");
             break;
         case WINED3D_CULL_FRONT:
-            gl_info->gl_ops.gl.p_glEnable(GL_CULL_FACE);
+            context_enable_gl_cap(context, GL_CULL_FACE);
             checkGLcall("glEnable GL_CULL_FACE");
             gl_info->gl_ops.gl.p_glCullFace(GL_FRONT);
             checkGLcall("glCullFace(GL_FRONT)");
             break;
         case WINED3D_CULL_BACK:
-            gl_info->gl_ops.gl.p_glEnable(GL_CULL_FACE);
+            context_enable_gl_cap(context, GL_CULL_FACE);
             checkGLcall("glEnable GL_CULL_FACE");
             gl_info->gl_ops.gl.p_glCullFace(GL_BACK);
             checkGLcall("glCullFace(GL_BACK)");
@@ -254,12 +254,12 @@ static void state_ditherenable(struct wined3d_context *context, const struct win
 
     if (state->render_states[WINED3D_RS_DITHERENABLE])
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_DITHER);
+        context_enable_gl_cap(context, GL_DITHER);
         checkGLcall("glEnable GL_DITHER");
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_DITHER);
+        context_disable_gl_cap(context, GL_DITHER);
         checkGLcall("glDisable GL_DITHER");
     }
 }
@@ -499,12 +499,12 @@ static void state_blend(struct wined3d_context *context, const struct wined3d_st
 
     if (!enable_blend)
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_BLEND);
+        context_disable_gl_cap(context, GL_BLEND);
         checkGLcall("glDisable(GL_BLEND)");
         return;
     }
 
-    gl_info->gl_ops.gl.p_glEnable(GL_BLEND);
+    context_enable_gl_cap(context, GL_BLEND);
     checkGLcall("glEnable(GL_BLEND)");
 
     gl_blend_from_d3d(&src_blend, &dst_blend,
@@ -589,12 +589,12 @@ void state_alpha_test(struct wined3d_context *context, const struct wined3d_stat
     if (state->render_states[WINED3D_RS_ALPHATESTENABLE]
             || (state->render_states[WINED3D_RS_COLORKEYENABLE] && enable_ckey))
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_ALPHA_TEST);
+        context_enable_gl_cap(context, GL_ALPHA_TEST);
         checkGLcall("glEnable GL_ALPHA_TEST");
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_ALPHA_TEST);
+        context_disable_gl_cap(context, GL_ALPHA_TEST);
         checkGLcall("glDisable GL_ALPHA_TEST");
         /* Alpha test is disabled, don't bother setting the params - it will happen on the next
          * enable call
@@ -867,7 +867,7 @@ static void state_stencil(struct wined3d_context *context, const struct wined3d_
     /* No stencil test without a stencil buffer. */
     if (!state->fb->depth_stencil)
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_STENCIL_TEST);
+        context_disable_gl_cap(context, GL_STENCIL_TEST);
         checkGLcall("glDisable GL_STENCIL_TEST");
         return;
     }
@@ -896,7 +896,7 @@ static void state_stencil(struct wined3d_context *context, const struct wined3d_
 
     if (twosided_enable && onesided_enable)
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_STENCIL_TEST);
+        context_enable_gl_cap(context, GL_STENCIL_TEST);
         checkGLcall("glEnable GL_STENCIL_TEST");
 
         if (gl_info->supported[WINED3D_GL_VERSION_2_0])
@@ -945,7 +945,7 @@ static void state_stencil(struct wined3d_context *context, const struct wined3d_
         /* This code disables the ATI extension as well, since the standard stencil functions are equal
          * to calling the ATI functions with GL_FRONT_AND_BACK as face parameter
          */
-        gl_info->gl_ops.gl.p_glEnable(GL_STENCIL_TEST);
+        context_enable_gl_cap(context, GL_STENCIL_TEST);
         checkGLcall("glEnable GL_STENCIL_TEST");
         gl_info->gl_ops.gl.p_glStencilFunc(func, ref, mask);
         checkGLcall("glStencilFunc(...)");
@@ -954,7 +954,7 @@ static void state_stencil(struct wined3d_context *context, const struct wined3d_
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_STENCIL_TEST);
+        context_disable_gl_cap(context, GL_STENCIL_TEST);
         checkGLcall("glDisable GL_STENCIL_TEST");
     }
 }
@@ -1428,12 +1428,12 @@ static void state_normalize(struct wined3d_context *context, const struct wined3
     if (state->render_states[WINED3D_RS_NORMALIZENORMALS]
             && (context->stream_info.use_map & (1u << WINED3D_FFP_NORMAL)))
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_NORMALIZE);
+        context_enable_gl_cap(context, GL_NORMALIZE);
         checkGLcall("glEnable(GL_NORMALIZE);");
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_NORMALIZE);
+        context_disable_gl_cap(context, GL_NORMALIZE);
         checkGLcall("glDisable(GL_NORMALIZE);");
     }
 }
@@ -1685,12 +1685,12 @@ static void state_scissor(struct wined3d_context *context, const struct wined3d_
 
     if (state->render_states[WINED3D_RS_SCISSORTESTENABLE])
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_SCISSOR_TEST);
+        context_enable_gl_cap(context, GL_SCISSOR_TEST);
         checkGLcall("glEnable(GL_SCISSOR_TEST)");
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_SCISSOR_TEST);
+        context_disable_gl_cap(context, GL_SCISSOR_TEST);
         checkGLcall("glDisable(GL_SCISSOR_TEST)");
     }
 }
@@ -1730,7 +1730,7 @@ static void state_depthbias(struct wined3d_context *context, const struct wined3
         scale_bias.d = state->render_states[WINED3D_RS_SLOPESCALEDEPTHBIAS];
         const_bias.d = state->render_states[WINED3D_RS_DEPTHBIAS];
 
-        gl_info->gl_ops.gl.p_glEnable(GL_POLYGON_OFFSET_FILL);
+        context_enable_gl_cap(context, GL_POLYGON_OFFSET_FILL);
         checkGLcall("glEnable(GL_POLYGON_OFFSET_FILL)");
 
         if (context->d3d_info->wined3d_creation_flags & WINED3D_LEGACY_DEPTH_BIAS)
@@ -1769,7 +1769,7 @@ static void state_depthbias(struct wined3d_context *context, const struct wined3
     }
     else
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_POLYGON_OFFSET_FILL);
+        context_disable_gl_cap(context, GL_POLYGON_OFFSET_FILL);
         checkGLcall("glDisable(GL_POLYGON_OFFSET_FILL)");
     }
 }
@@ -1780,12 +1780,12 @@ static void state_depthclip(struct wined3d_context *context, const struct wined3
 
     if (state->render_states[WINED3D_RS_DEPTHCLIP])
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_DEPTH_CLAMP);
+        context_disable_gl_cap(context, GL_DEPTH_CLAMP);
         checkGLcall("glDisable(GL_DEPTH_CLAMP)");
     }
     else
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_DEPTH_CLAMP);
+        context_enable_gl_cap(context, GL_DEPTH_CLAMP);
         checkGLcall("glEnable(GL_DEPTH_CLAMP)");
     }
 }
@@ -4100,7 +4100,10 @@ static void load_numbered_arrays(struct wined3d_context *context,
              * figure out the system memory address. */
             const BYTE *ptr = element->data.addr;
             if (element->data.buffer_object)
+            {
+                ptr -= stream->buffer->bo_offset;
                 ptr += (ULONG_PTR)wined3d_buffer_load_sysmem(stream->buffer, context);
+            }
 
             if (context->numbered_array_mask & (1u << i))
                 unload_numbered_array(context, i);
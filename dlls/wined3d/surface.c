@@ -337,7 +337,7 @@ static void surface_depth_blt_fbo(const struct wined3d_device *device,
         context_invalidate_state(context, STATE_RENDER(WINED3D_RS_STENCILWRITEMASK));
     }
 
-    gl_info->gl_ops.gl.p_glDisable(GL_SCISSOR_TEST);
+    context_disable_gl_cap(context, GL_SCISSOR_TEST);
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_SCISSORTESTENABLE));
 
     gl_info->fbo_ops.glBlitFramebuffer(src_rect->left, src_rect->top, src_rect->right, src_rect->bottom,
@@ -468,7 +468,7 @@ static void surface_blt_fbo(const struct wined3d_device *device,
     for (i = 0; i < MAX_RENDER_TARGETS; ++i)
         context_invalidate_state(context, STATE_RENDER(WINED3D_RS_COLORWRITE(i)));
 
-    gl_info->gl_ops.gl.p_glDisable(GL_SCISSOR_TEST);
+    context_disable_gl_cap(context, GL_SCISSOR_TEST);
     context_invalidate_state(context, STATE_RENDER(WINED3D_RS_SCISSORTESTENABLE));
 
     gl_info->fbo_ops.glBlitFramebuffer(src_rect.left, src_rect.top, src_rect.right, src_rect.bottom,
@@ -1068,24 +1068,6 @@ static void convert_r32_float_r16_float(const BYTE *src, BYTE *dst,
 static void convert_r5g6b5_x8r8g8b8(const BYTE *src, BYTE *dst,
         DWORD pitch_in, DWORD pitch_out, unsigned int w, unsigned int h)
 {
-    static const unsigned char convert_5to8[] =
-    {
-        0x00, 0x08, 0x10, 0x19, 0x21, 0x29, 0x31, 0x3a,
-        0x42, 0x4a, 0x52, 0x5a, 0x63, 0x6b, 0x73, 0x7b,
-        0x84, 0x8c, 0x94, 0x9c, 0xa5, 0xad, 0xb5, 0xbd,
-        0xc5, 0xce, 0xd6, 0xde, 0xe6, 0xef, 0xf7, 0xff,
-    };
-    static const unsigned char convert_6to8[] =
-    {
-        0x00, 0x04, 0x08, 0x0c, 0x10, 0x14, 0x18, 0x1c,
-        0x20, 0x24, 0x28, 0x2d, 0x31, 0x35, 0x39, 0x3d,
-        0x41, 0x45, 0x49, 0x4d, 0x51, 0x55, 0x59, 0x5d,
-        0x61, 0x65, 0x69, 0x6d, 0x71, 0x75, 0x79, 0x7d,
-        0x82, 0x86, 0x8a, 0x8e, 0x92, 0x96, 0x9a, 0x9e,
-        0xa2, 0xa6, 0xaa, 0xae, 0xb2, 0xb6, 0xba, 0xbe,
-        0xc2, 0xc6, 0xca, 0xce, 0xd2, 0xd7, 0xdb, 0xdf,
-        0xe3, 0xe7, 0xeb, 0xef, 0xf3, 0xf7, 0xfb, 0xff,
-    };
     unsigned int x, y;
 
     TRACE("Converting %ux%u pixels, pitches %u %u.\n", w, h, pitch_in, pitch_out);
@@ -1096,11 +1078,13 @@ static void convert_r5g6b5_x8r8g8b8(const BYTE *src, BYTE *dst,
         DWORD *dst_line = (DWORD *)(dst + y * pitch_out);
         for (x = 0; x < w; ++x)
         {
-            WORD pixel = src_line[x];
-            dst_line[x] = 0xff000000u
-                    | convert_5to8[(pixel & 0xf800u) >> 11] << 16
-                    | convert_6to8[(pixel & 0x07e0u) >> 5] << 8
-                    | convert_5to8[(pixel & 0x001fu)];
+            /* These compute round(x * 255 / 31) and round(x * 255 / 63)
+             * without table lookups. */
+            DWORD pixel = src_line[x];
+            DWORD r = (((pixel & 0xf800u) >> 11) * 527 + 23) >> 6;
+            DWORD g = (((pixel & 0x07e0u) >> 5) * 259 + 33) >> 6;
+            DWORD b = ((pixel & 0x001fu) * 527 + 23) >> 6;
+            dst_line[x] = 0xff000000u | r << 16 | g << 8 | b;
         }
     }
 }
@@ -2437,7 +2421,7 @@ static BOOL surface_load_texture(struct wined3d_surface *surface,
             context_release(context);
             return FALSE;
         }
-        format.convert(src_mem, dst_mem, src_row_pitch, src_slice_pitch,
+        wined3d_format_convert(&format, src_mem, dst_mem, src_row_pitch, src_slice_pitch,
                 dst_row_pitch, dst_slice_pitch, width, height, 1);
         src_row_pitch = dst_row_pitch;
         context_unmap_bo_address(context, &data, GL_PIXEL_UNPACK_BUFFER);
@@ -2463,7 +2447,7 @@ static BOOL surface_load_texture(struct wined3d_surface *surface,
         }
         if (texture->swapchain && texture->swapchain->palette)
             palette = texture->swapchain->palette;
-        conversion->convert(src_mem, src_row_pitch, dst_mem, dst_row_pitch,
+        wined3d_format_convert_color_key(conversion, src_mem, src_row_pitch, dst_mem, dst_row_pitch,
                 width, height, palette, &texture->async.gl_color_key);
         src_row_pitch = dst_row_pitch;
         context_unmap_bo_address(context, &data, GL_PIXEL_UNPACK_BUFFER);
@@ -2841,7 +2825,7 @@ static void ffp_blitter_blit(struct wined3d_blitter *blitter, enum wined3d_blit_
 
     if (op == WINED3D_BLIT_OP_COLOR_BLIT_ALPHATEST || color_key)
     {
-        gl_info->gl_ops.gl.p_glEnable(GL_ALPHA_TEST);
+        context_enable_gl_cap(context, GL_ALPHA_TEST);
         checkGLcall("glEnable(GL_ALPHA_TEST)");
     }
 
@@ -2862,7 +2846,7 @@ static void ffp_blitter_blit(struct wined3d_blitter *blitter, enum wined3d_blit_
 
     if (op == WINED3D_BLIT_OP_COLOR_BLIT_ALPHATEST || color_key)
     {
-        gl_info->gl_ops.gl.p_glDisable(GL_ALPHA_TEST);
+        context_disable_gl_cap(context, GL_ALPHA_TEST);
         checkGLcall("glDisable(GL_ALPHA_TEST)");
     }
 
@@ -25,6 +25,7 @@
 #include "wined3d_private.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 WINE_DECLARE_DEBUG_CHANNEL(fps);
 
 static void wined3d_swapchain_destroy_object(void *object)
@@ -495,6 +496,10 @@ static void swapchain_gl_present(struct wined3d_swapchain *swapchain,
     wined3d_swapchain_rotate(swapchain, context);
 
     TRACE("SwapBuffers called, Starting new frame\n");
+    TRACE_(d3d_perf)("Context %p: %u GL capability changes issued, %u redundant ones filtered.\n",
+            context, context->gl_cap_calls, context->gl_cap_calls_filtered);
+    context->gl_cap_calls = 0;
+    context->gl_cap_calls_filtered = 0;
     /* FPS support */
     if (TRACE_ON(fps))
     {
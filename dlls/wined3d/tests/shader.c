@@ -0,0 +1,677 @@
+/*
+ * Offline shader translation tests
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+/* Besides the tests, this can run a corpus of shaders through the front ends
+ * and the GLSL generator, without a GPU:
+ *
+ *   shader bench <directory> [iterations]
+ *       Translates every file in the directory, D3D9 byte code or DXBC, and
+ *       reports the throughput.
+ *   shader fuzz <seed> <iterations> [directory]
+ *       Translates randomly mutated copies of the corpus, or of the built-in
+ *       shaders. The iteration is traced before each translation, so that a
+ *       crash can be reproduced with the same seed. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "windef.h"
+#include "winbase.h"
+#include "wine/test.h"
+
+#define ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
+
+#define MAKE_TAG(ch0, ch1, ch2, ch3) \
+    ((DWORD)(ch0) | ((DWORD)(ch1) << 8) | \
+    ((DWORD)(ch2) << 16) | ((DWORD)(ch3) << 24 ))
+#define TAG_DXBC MAKE_TAG('D', 'X', 'B', 'C')
+#define TAG_ISGN MAKE_TAG('I', 'S', 'G', 'N')
+#define TAG_OSGN MAKE_TAG('O', 'S', 'G', 'N')
+#define TAG_OSG5 MAKE_TAG('O', 'S', 'G', '5')
+#define TAG_PCSG MAKE_TAG('P', 'C', 'S', 'G')
+#define TAG_SHDR MAKE_TAG('S', 'H', 'D', 'R')
+#define TAG_SHEX MAKE_TAG('S', 'H', 'E', 'X')
+
+/* From wine/wined3d.h, which needs config.h and can't be used in tests. */
+#define WINED3D_OK                              S_OK
+#define WINED3DERR_INVALIDCALL                  MAKE_HRESULT(1, 0x876, 2156)
+
+#define WINED3D_SHADER_TRANSLATE_LEGACY_GLSL    0x00000001
+
+enum wined3d_shader_byte_code_format
+{
+    WINED3D_SHADER_BYTE_CODE_FORMAT_SM1     = 0,
+    WINED3D_SHADER_BYTE_CODE_FORMAT_SM4     = 1,
+};
+
+struct wined3d_shader_signature_element
+{
+    const char *semantic_name;
+    unsigned int semantic_idx;
+    unsigned int stream_idx;
+    unsigned int sysval_semantic;
+    unsigned int component_type;
+    unsigned int register_idx;
+    DWORD mask;
+};
+
+struct wined3d_shader_signature
+{
+    UINT element_count;
+    struct wined3d_shader_signature_element *elements;
+};
+
+struct wined3d_shader_desc
+{
+    const DWORD *byte_code;
+    size_t byte_code_size;
+    enum wined3d_shader_byte_code_format format;
+    struct wined3d_shader_signature input_signature;
+    struct wined3d_shader_signature output_signature;
+    struct wined3d_shader_signature patch_constant_signature;
+    unsigned int max_version;
+};
+
+struct wined3d_shader_translation
+{
+    char *glsl;
+    unsigned int glsl_buffer_size;
+    unsigned int glsl_size;
+    unsigned int string_buffer_count;
+};
+
+HRESULT __cdecl wined3d_shader_translate(const struct wined3d_shader_desc *desc, DWORD flags,
+        struct wined3d_shader_translation *translation);
+
+struct shader
+{
+    const char *name;
+    const DWORD *code;
+    SIZE_T size;
+};
+
+static const DWORD vs_1_1[] =
+{
+    0xfffe0101,                                                             /* vs_1_1                       */
+    0x0000001f, 0x80000000, 0x900f0000,                                     /* dcl_position0 v0             */
+    0x00000009, 0xc0010000, 0x90e40000, 0xa0e40000,                         /* dp4 oPos.x, v0, c0           */
+    0x00000009, 0xc0020000, 0x90e40000, 0xa0e40001,                         /* dp4 oPos.y, v0, c1           */
+    0x00000009, 0xc0040000, 0x90e40000, 0xa0e40002,                         /* dp4 oPos.z, v0, c2           */
+    0x00000009, 0xc0080000, 0x90e40000, 0xa0e40003,                         /* dp4 oPos.w, v0, c3           */
+    0x0000ffff,                                                             /* end                          */
+};
+
+static const DWORD ps_1_1[] =
+{
+    0xffff0101,                                                             /* ps_1_1                       */
+    0x00000051, 0xa00f0001, 0x3f800000, 0x00000000, 0x00000000, 0x00000000, /* def c1 = 1.0, 0.0, 0.0, 0.0  */
+    0x00000042, 0xb00f0000,                                                 /* tex t0                       */
+    0x00000008, 0x800f0000, 0xa0e40001, 0xa0e40000,                         /* dp3 r0, c1, c0               */
+    0x00000005, 0x800f0000, 0x90e40000, 0x80e40000,                         /* mul r0, v0, r0               */
+    0x00000005, 0x800f0000, 0xb0e40000, 0x80e40000,                         /* mul r0, t0, r0               */
+    0x0000ffff,                                                             /* end                          */
+};
+
+static const DWORD ps_3_0[] =
+{
+    0xffff0300,                             /* ps_3_0                   */
+    0x0200001f, 0x80000005, 0x900f0000,     /* dcl_texcoord0, v0        */
+    0x02000001, 0x800f0800, 0x90e40000,     /* mov oC0, v0              */
+    0x0000ffff                              /* end                      */
+};
+
+#if 0
+float4 light;
+float4x4 mat;
+
+struct input
+{
+    float4 position : POSITION;
+    float3 normal : NORMAL;
+};
+
+struct output
+{
+    float4 position : POSITION;
+    float4 diffuse : COLOR;
+};
+
+output main(const input v)
+{
+    output o;
+
+    o.position = mul(v.position, mat);
+    o.diffuse = dot((float3)light, v.normal);
+
+    return o;
+}
+#endif
+static const DWORD vs_2_0[] =
+{
+    0xfffe0200, 0x002bfffe, 0x42415443, 0x0000001c, 0x00000077, 0xfffe0200, 0x00000002,
+    0x0000001c, 0x00000100, 0x00000070, 0x00000044, 0x00040002, 0x00000001, 0x0000004c,
+    0x00000000, 0x0000005c, 0x00000002, 0x00000004, 0x00000060, 0x00000000, 0x6867696c,
+    0xabab0074, 0x00030001, 0x00040001, 0x00000001, 0x00000000, 0x0074616d, 0x00030003,
+    0x00040004, 0x00000001, 0x00000000, 0x325f7376, 0x4d00305f, 0x6f726369, 0x74666f73,
+    0x29522820, 0x534c4820, 0x6853204c, 0x72656461, 0x6d6f4320, 0x656c6970, 0x2e392072,
+    0x392e3932, 0x332e3235, 0x00313131, 0x0200001f, 0x80000000, 0x900f0000, 0x0200001f,
+    0x80000003, 0x900f0001, 0x03000009, 0xc0010000, 0x90e40000, 0xa0e40000, 0x03000009,
+    0xc0020000, 0x90e40000, 0xa0e40001, 0x03000009, 0xc0040000, 0x90e40000, 0xa0e40002,
+    0x03000009, 0xc0080000, 0x90e40000, 0xa0e40003, 0x03000008, 0xd00f0000, 0xa0e40004,
+    0x90e40001, 0x0000ffff,
+};
+
+static const DWORD vs_4_0[] =
+{
+    0x43425844, 0x3ae813ca, 0x0f034b91, 0x790f3226, 0x6b4a718a, 0x00000001, 0x000001c0,
+    0x00000003, 0x0000002c, 0x0000007c, 0x000000cc, 0x4e475349, 0x00000048, 0x00000002,
+    0x00000008, 0x00000038, 0x00000000, 0x00000000, 0x00000003, 0x00000000, 0x00000f0f,
+    0x00000041, 0x00000000, 0x00000000, 0x00000003, 0x00000001, 0x00000707, 0x49534f50,
+    0x4e4f4954, 0x524f4e00, 0x004c414d, 0x4e47534f, 0x00000048, 0x00000002, 0x00000008,
+    0x00000038, 0x00000000, 0x00000000, 0x00000003, 0x00000000, 0x0000000f, 0x00000041,
+    0x00000000, 0x00000000, 0x00000003, 0x00000001, 0x0000000f, 0x49534f50, 0x4e4f4954,
+    0x4c4f4300, 0xab00524f, 0x52444853, 0x000000ec, 0x00010040, 0x0000003b, 0x04000059,
+    0x00208e46, 0x00000000, 0x00000005, 0x0300005f, 0x001010f2, 0x00000000, 0x0300005f,
+    0x00101072, 0x00000001, 0x03000065, 0x001020f2, 0x00000000, 0x03000065, 0x001020f2,
+    0x00000001, 0x08000011, 0x00102012, 0x00000000, 0x00101e46, 0x00000000, 0x00208e46,
+    0x00000000, 0x00000001, 0x08000011, 0x00102022, 0x00000000, 0x00101e46, 0x00000000,
+    0x00208e46, 0x00000000, 0x00000002, 0x08000011, 0x00102042, 0x00000000, 0x00101e46,
+    0x00000000, 0x00208e46, 0x00000000, 0x00000003, 0x08000011, 0x00102082, 0x00000000,
+    0x00101e46, 0x00000000, 0x00208e46, 0x00000000, 0x00000004, 0x08000010, 0x001020f2,
+    0x00000001, 0x00208246, 0x00000000, 0x00000000, 0x00101246, 0x00000001, 0x0100003e,
+};
+
+#if 0
+float4 main(const float4 color : COLOR) : SV_TARGET
+{
+    float4 o;
+
+    o = color;
+
+    return o;
+}
+#endif
+static const DWORD ps_4_0[] =
+{
+    0x43425844, 0x08c2b568, 0x17d33120, 0xb7d82948, 0x13a570fb, 0x00000001, 0x000000d0, 0x00000003,
+    0x0000002c, 0x0000005c, 0x00000090, 0x4e475349, 0x00000028, 0x00000001, 0x00000008, 0x00000020,
+    0x00000000, 0x00000000, 0x00000003, 0x00000000, 0x00000f0f, 0x4f4c4f43, 0xabab0052, 0x4e47534f,
+    0x0000002c, 0x00000001, 0x00000008, 0x00000020, 0x00000000, 0x00000000, 0x00000003, 0x00000000,
+    0x0000000f, 0x545f5653, 0x45475241, 0xabab0054, 0x52444853, 0x00000038, 0x00000040, 0x0000000e,
+    0x03001062, 0x001010f2, 0x00000000, 0x03000065, 0x001020f2, 0x00000000, 0x05000036, 0x001020f2,
+    0x00000000, 0x00101e46, 0x00000000, 0x0100003e,
+};
+
+#if 0
+struct gs_out
+{
+    float4 pos : SV_POSITION;
+};
+
+[maxvertexcount(4)]
+void main(point float4 vin[1] : POSITION, inout TriangleStream<gs_out> vout)
+{
+    float offset = 0.1 * vin[0].w;
+    gs_out v;
+
+    v.pos = float4(vin[0].x - offset, vin[0].y - offset, vin[0].z, vin[0].w);
+    vout.Append(v);
+    v.pos = float4(vin[0].x - offset, vin[0].y + offset, vin[0].z, vin[0].w);
+    vout.Append(v);
+    v.pos = float4(vin[0].x + offset, vin[0].y - offset, vin[0].z, vin[0].w);
+    vout.Append(v);
+    v.pos = float4(vin[0].x + offset, vin[0].y + offset, vin[0].z, vin[0].w);
+    vout.Append(v);
+}
+#endif
+static const DWORD gs_4_0[] =
+{
+    0x43425844, 0x000ee786, 0xc624c269, 0x885a5cbe, 0x444b3b1f, 0x00000001, 0x0000023c, 0x00000003,
+    0x0000002c, 0x00000060, 0x00000094, 0x4e475349, 0x0000002c, 0x00000001, 0x00000008, 0x00000020,
+    0x00000000, 0x00000000, 0x00000003, 0x00000000, 0x00000f0f, 0x49534f50, 0x4e4f4954, 0xababab00,
+    0x4e47534f, 0x0000002c, 0x00000001, 0x00000008, 0x00000020, 0x00000000, 0x00000001, 0x00000003,
+    0x00000000, 0x0000000f, 0x505f5653, 0x5449534f, 0x004e4f49, 0x52444853, 0x000001a0, 0x00020040,
+    0x00000068, 0x0400005f, 0x002010f2, 0x00000001, 0x00000000, 0x02000068, 0x00000001, 0x0100085d,
+    0x0100285c, 0x04000067, 0x001020f2, 0x00000000, 0x00000001, 0x0200005e, 0x00000004, 0x0f000032,
+    0x00100032, 0x00000000, 0x80201ff6, 0x00000041, 0x00000000, 0x00000000, 0x00004002, 0x3dcccccd,
+    0x3dcccccd, 0x00000000, 0x00000000, 0x00201046, 0x00000000, 0x00000000, 0x05000036, 0x00102032,
+    0x00000000, 0x00100046, 0x00000000, 0x06000036, 0x001020c2, 0x00000000, 0x00201ea6, 0x00000000,
+    0x00000000, 0x01000013, 0x05000036, 0x00102012, 0x00000000, 0x0010000a, 0x00000000, 0x0e000032,
+    0x00100052, 0x00000000, 0x00201ff6, 0x00000000, 0x00000000, 0x00004002, 0x3dcccccd, 0x00000000,
+    0x3dcccccd, 0x00000000, 0x00201106, 0x00000000, 0x00000000, 0x05000036, 0x00102022, 0x00000000,
+    0x0010002a, 0x00000000, 0x06000036, 0x001020c2, 0x00000000, 0x00201ea6, 0x00000000, 0x00000000,
+    0x01000013, 0x05000036, 0x00102012, 0x00000000, 0x0010000a, 0x00000000, 0x05000036, 0x00102022,
+    0x00000000, 0x0010001a, 0x00000000, 0x06000036, 0x001020c2, 0x00000000, 0x00201ea6, 0x00000000,
+    0x00000000, 0x01000013, 0x05000036, 0x00102032, 0x00000000, 0x00100086, 0x00000000, 0x06000036,
+    0x001020c2, 0x00000000, 0x00201ea6, 0x00000000, 0x00000000, 0x01000013, 0x0100003e,
+};
+
+static const struct shader builtin_shaders[] =
+{
+    {"vs_1_1", vs_1_1, sizeof(vs_1_1)},
+    {"ps_1_1", ps_1_1, sizeof(ps_1_1)},
+    {"vs_2_0", vs_2_0, sizeof(vs_2_0)},
+    {"ps_3_0", ps_3_0, sizeof(ps_3_0)},
+    {"vs_4_0", vs_4_0, sizeof(vs_4_0)},
+    {"ps_4_0", ps_4_0, sizeof(ps_4_0)},
+    {"gs_4_0", gs_4_0, sizeof(gs_4_0)},
+};
+
+static void free_signature(struct wined3d_shader_signature *s)
+{
+    HeapFree(GetProcessHeap(), 0, s->elements);
+    s->elements = NULL;
+    s->element_count = 0;
+}
+
+static BOOL parse_signature(DWORD tag, const char *data, DWORD size, struct wined3d_shader_signature *s)
+{
+    unsigned int i, element_size = tag == TAG_OSG5 ? 7 : 6;
+    const DWORD *ptr = (const DWORD *)data;
+    DWORD count, name_offset;
+
+    if (size < 2 * sizeof(DWORD))
+        return FALSE;
+    count = ptr[0];
+    ptr += 2;
+    if (count > (size - 2 * sizeof(DWORD)) / (element_size * sizeof(DWORD)))
+        return FALSE;
+
+    free_signature(s);
+    if (!(s->elements = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, count * sizeof(*s->elements))))
+        return FALSE;
+    s->element_count = count;
+
+    for (i = 0; i < count; ++i)
+    {
+        if (tag == TAG_OSG5)
+            s->elements[i].stream_idx = *ptr++;
+        name_offset = *ptr++;
+        if (name_offset >= size || !memchr(data + name_offset, 0, size - name_offset))
+        {
+            free_signature(s);
+            return FALSE;
+        }
+        s->elements[i].semantic_name = data + name_offset;
+        s->elements[i].semantic_idx = *ptr++;
+        s->elements[i].sysval_semantic = *ptr++;
+        s->elements[i].component_type = *ptr++;
+        s->elements[i].register_idx = *ptr++;
+        s->elements[i].mask = *ptr++;
+    }
+
+    return TRUE;
+}
+
+static void free_shader_desc(struct wined3d_shader_desc *desc)
+{
+    free_signature(&desc->input_signature);
+    free_signature(&desc->output_signature);
+    free_signature(&desc->patch_constant_signature);
+}
+
+/* D3D9 byte code is used as is, DXBC is split into the shader code and the
+ * signatures the way d3d11 does it. */
+static BOOL init_shader_desc(struct wined3d_shader_desc *desc, const void *code, SIZE_T size)
+{
+    const char *data = code;
+    DWORD chunk_count, offset, tag, chunk_size;
+    unsigned int i;
+    BOOL ret = TRUE;
+
+    memset(desc, 0, sizeof(*desc));
+    if (size < sizeof(DWORD) || size % sizeof(DWORD))
+        return FALSE;
+
+    if (*(const DWORD *)data != TAG_DXBC)
+    {
+        desc->byte_code = code;
+        desc->byte_code_size = size;
+        desc->format = WINED3D_SHADER_BYTE_CODE_FORMAT_SM1;
+        desc->max_version = 3;
+        return TRUE;
+    }
+
+    if (size < 8 * sizeof(DWORD))
+        return FALSE;
+    chunk_count = ((const DWORD *)data)[7];
+    if (chunk_count > (size - 8 * sizeof(DWORD)) / sizeof(DWORD))
+        return FALSE;
+
+    for (i = 0; i < chunk_count && ret; ++i)
+    {
+        offset = ((const DWORD *)data)[8 + i];
+        if (offset % sizeof(DWORD) || offset > size - 2 * sizeof(DWORD))
+        {
+            ret = FALSE;
+            break;
+        }
+        tag = *(const DWORD *)(data + offset);
+        chunk_size = *(const DWORD *)(data + offset + sizeof(DWORD));
+        offset += 2 * sizeof(DWORD);
+        if (chunk_size > size - offset)
+        {
+            ret = FALSE;
+            break;
+        }
+
+        switch (tag)
+        {
+            case TAG_ISGN:
+                ret = parse_signature(tag, data + offset, chunk_size, &desc->input_signature);
+                break;
+            case TAG_OSGN:
+            case TAG_OSG5:
+                ret = parse_signature(tag, data + offset, chunk_size, &desc->output_signature);
+                break;
+            case TAG_PCSG:
+                ret = parse_signature(tag, data + offset, chunk_size, &desc->patch_constant_signature);
+                break;
+            case TAG_SHDR:
+            case TAG_SHEX:
+                desc->byte_code = (const DWORD *)(data + offset);
+                desc->byte_code_size = chunk_size;
+                desc->format = WINED3D_SHADER_BYTE_CODE_FORMAT_SM4;
+                desc->max_version = 5;
+                break;
+        }
+    }
+
+    if (!ret || !desc->byte_code)
+    {
+        free_shader_desc(desc);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void test_translate(void)
+{
+    struct wined3d_shader_translation translation;
+    struct wined3d_shader_desc desc;
+    char glsl[8192];
+    unsigned int i;
+    HRESULT hr;
+
+    for (i = 0; i < ARRAY_SIZE(builtin_shaders); ++i)
+    {
+        const struct shader *shader = &builtin_shaders[i];
+
+        ok(init_shader_desc(&desc, shader->code, shader->size), "Failed to parse %s.\n", shader->name);
+
+        memset(&translation, 0, sizeof(translation));
+        translation.glsl = glsl;
+        translation.glsl_buffer_size = sizeof(glsl);
+        hr = wined3d_shader_translate(&desc, 0, &translation);
+        ok(hr == WINED3D_OK, "Got unexpected hr %#x for %s.\n", hr, shader->name);
+        ok(translation.glsl_size && translation.glsl_size < sizeof(glsl),
+                "Got unexpected size %u for %s.\n", translation.glsl_size, shader->name);
+        ok(strlen(glsl) == translation.glsl_size, "Got unexpected length %u for %s.\n",
+                (unsigned int)strlen(glsl), shader->name);
+        ok(!strncmp(glsl, "#version ", 9), "Got unexpected GLSL for %s:\n%s", shader->name, glsl);
+        ok(!!strstr(glsl, "void main()"), "Got unexpected GLSL for %s:\n%s", shader->name, glsl);
+
+        /* Without a buffer, only the size is returned. */
+        memset(&translation, 0, sizeof(translation));
+        hr = wined3d_shader_translate(&desc, 0, &translation);
+        ok(hr == WINED3D_OK, "Got unexpected hr %#x for %s.\n", hr, shader->name);
+        ok(translation.glsl_size == strlen(glsl), "Got unexpected size %u for %s.\n",
+                translation.glsl_size, shader->name);
+
+        if (desc.format == WINED3D_SHADER_BYTE_CODE_FORMAT_SM1)
+        {
+            memset(&translation, 0, sizeof(translation));
+            translation.glsl = glsl;
+            translation.glsl_buffer_size = sizeof(glsl);
+            hr = wined3d_shader_translate(&desc, WINED3D_SHADER_TRANSLATE_LEGACY_GLSL, &translation);
+            ok(hr == WINED3D_OK, "Got unexpected hr %#x for legacy %s.\n", hr, shader->name);
+            ok(!strncmp(glsl, "#version 120\n", 13), "Got unexpected GLSL for legacy %s:\n%s",
+                    shader->name, glsl);
+        }
+
+        free_shader_desc(&desc);
+    }
+
+    ok(init_shader_desc(&desc, vs_4_0, sizeof(vs_4_0)), "Failed to parse vs_4_0.\n");
+    desc.max_version = 3;
+    memset(&translation, 0, sizeof(translation));
+    hr = wined3d_shader_translate(&desc, 0, &translation);
+    ok(hr == WINED3DERR_INVALIDCALL, "Got unexpected hr %#x.\n", hr);
+    free_shader_desc(&desc);
+
+    memset(&desc, 0, sizeof(desc));
+    hr = wined3d_shader_translate(&desc, 0, &translation);
+    ok(hr == WINED3DERR_INVALIDCALL, "Got unexpected hr %#x.\n", hr);
+}
+
+struct corpus
+{
+    unsigned int count;
+    struct shader *shaders;
+};
+
+static void free_corpus(struct corpus *corpus)
+{
+    unsigned int i;
+
+    for (i = 0; i < corpus->count; ++i)
+        HeapFree(GetProcessHeap(), 0, (void *)corpus->shaders[i].code);
+    HeapFree(GetProcessHeap(), 0, corpus->shaders);
+}
+
+static BOOL load_corpus(struct corpus *corpus, const char *directory)
+{
+    char path[MAX_PATH], *name;
+    WIN32_FIND_DATAA data;
+    DWORD read;
+    HANDLE find, file;
+    void *code;
+
+    corpus->count = 0;
+    corpus->shaders = NULL;
+
+    sprintf(path, "%s\\*", directory);
+    if ((find = FindFirstFileA(path, &data)) == INVALID_HANDLE_VALUE)
+        return FALSE;
+    do
+    {
+        if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) || !data.nFileSizeLow || data.nFileSizeHigh)
+            continue;
+
+        sprintf(path, "%s\\%s", directory, data.cFileName);
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            continue;
+        code = HeapAlloc(GetProcessHeap(), 0, data.nFileSizeLow);
+        name = HeapAlloc(GetProcessHeap(), 0, strlen(data.cFileName) + 1);
+        if (!ReadFile(file, code, data.nFileSizeLow, &read, NULL) || read != data.nFileSizeLow)
+        {
+            HeapFree(GetProcessHeap(), 0, name);
+            HeapFree(GetProcessHeap(), 0, code);
+            CloseHandle(file);
+            continue;
+        }
+        CloseHandle(file);
+        strcpy(name, data.cFileName);
+
+        if (!corpus->shaders)
+            corpus->shaders = HeapAlloc(GetProcessHeap(), 0, sizeof(*corpus->shaders));
+        else
+            corpus->shaders = HeapReAlloc(GetProcessHeap(), 0, corpus->shaders,
+                    (corpus->count + 1) * sizeof(*corpus->shaders));
+        corpus->shaders[corpus->count].name = name;
+        corpus->shaders[corpus->count].code = code;
+        corpus->shaders[corpus->count].size = data.nFileSizeLow;
+        ++corpus->count;
+    } while (FindNextFileA(find, &data));
+    FindClose(find);
+
+    return TRUE;
+}
+
+static void benchmark(const struct shader *shaders, unsigned int count, unsigned int iterations)
+{
+    struct wined3d_shader_translation translation;
+    unsigned int i, j, translated = 0, failed = 0;
+    ULONGLONG glsl_size = 0, byte_code_size = 0;
+    unsigned int string_buffer_count = 0;
+    LARGE_INTEGER start, end, freq;
+    struct wined3d_shader_desc desc;
+    double time;
+
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&start);
+    for (i = 0; i < iterations; ++i)
+    {
+        for (j = 0; j < count; ++j)
+        {
+            if (!init_shader_desc(&desc, shaders[j].code, shaders[j].size))
+            {
+                ++failed;
+                continue;
+            }
+            memset(&translation, 0, sizeof(translation));
+            if (SUCCEEDED(wined3d_shader_translate(&desc, 0, &translation)))
+            {
+                ++translated;
+                byte_code_size += shaders[j].size;
+                glsl_size += translation.glsl_size;
+                string_buffer_count += translation.string_buffer_count;
+            }
+            else
+            {
+                ++failed;
+            }
+            free_shader_desc(&desc);
+        }
+    }
+    QueryPerformanceCounter(&end);
+
+    time = (end.QuadPart - start.QuadPart) / (double)freq.QuadPart;
+    trace("Translated %u shaders (%u failed) in %.3f ms: %.1f shaders/s, %.1f KiB/s of byte code, "
+            "%.1f KiB of GLSL, %u temporary string buffers.\n", translated, failed, time * 1000.0,
+            time > 0.0 ? translated / time : 0.0, time > 0.0 ? byte_code_size / 1024.0 / time : 0.0,
+            glsl_size / 1024.0, string_buffer_count);
+}
+
+static unsigned int fuzz_random(unsigned int *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 0x7fff;
+}
+
+static void fuzz(const struct shader *shaders, unsigned int count, unsigned int seed, unsigned int iterations)
+{
+    struct wined3d_shader_translation translation;
+    unsigned int i, j, k, mutations, translated = 0;
+    struct wined3d_shader_desc desc;
+    const struct shader *shader;
+    DWORD *code;
+    SIZE_T size;
+
+    for (i = 0; i < iterations; ++i)
+    {
+        shader = &shaders[fuzz_random(&seed) % count];
+        if (shader->size < sizeof(DWORD))
+            continue;
+        size = shader->size / sizeof(DWORD);
+        /* Keep room for an end token, so that the D3D9 front end stops. */
+        code = HeapAlloc(GetProcessHeap(), 0, (size + 1) * sizeof(DWORD));
+        memcpy(code, shader->code, size * sizeof(DWORD));
+
+        mutations = 1 + fuzz_random(&seed) % 4;
+        for (j = 0; j < mutations; ++j)
+        {
+            k = fuzz_random(&seed) % size;
+            switch (fuzz_random(&seed) % 4)
+            {
+                case 0:
+                    code[k] ^= 1u << (fuzz_random(&seed) % 32);
+                    break;
+                case 1:
+                    code[k] = (code[k] & 0xffff0000) | (fuzz_random(&seed) & 0xffff);
+                    break;
+                case 2:
+                    code[k] = code[fuzz_random(&seed) % size];
+                    break;
+                case 3:
+                    if (k > 1)
+                        size = k;
+                    break;
+            }
+        }
+        /* The first word selects the format, keep it. */
+        code[0] = shader->code[0];
+        code[size] = 0x0000ffff;
+
+        trace("Iteration %u, %s.\n", i, shader->name);
+        if (init_shader_desc(&desc, code, (size + 1) * sizeof(DWORD)))
+        {
+            memset(&translation, 0, sizeof(translation));
+            if (SUCCEEDED(wined3d_shader_translate(&desc, 0, &translation)))
+                ++translated;
+            free_shader_desc(&desc);
+        }
+        HeapFree(GetProcessHeap(), 0, code);
+    }
+
+    trace("Fuzzed %u shaders, %u of them translated.\n", iterations, translated);
+}
+
+START_TEST(shader)
+{
+    struct corpus corpus;
+    char **argv;
+    int argc;
+
+    argc = winetest_get_mainargs(&argv);
+
+    if (argc >= 4 && !strcmp(argv[2], "bench"))
+    {
+        if (!load_corpus(&corpus, argv[3]) || !corpus.count)
+        {
+            skip("No shaders in %s.\n", argv[3]);
+            return;
+        }
+        benchmark(corpus.shaders, corpus.count, argc >= 5 ? atoi(argv[4]) : 1);
+        free_corpus(&corpus);
+        return;
+    }
+
+    if (argc >= 5 && !strcmp(argv[2], "fuzz"))
+    {
+        if (argc >= 6)
+        {
+            if (!load_corpus(&corpus, argv[5]) || !corpus.count)
+            {
+                skip("No shaders in %s.\n", argv[5]);
+                return;
+            }
+            fuzz(corpus.shaders, corpus.count, atoi(argv[3]), atoi(argv[4]));
+            free_corpus(&corpus);
+        }
+        else
+        {
+            fuzz(builtin_shaders, ARRAY_SIZE(builtin_shaders), atoi(argv[3]), atoi(argv[4]));
+        }
+        return;
+    }
+
+    test_translate();
+    benchmark(builtin_shaders, ARRAY_SIZE(builtin_shaders), 100);
+}
@@ -2925,7 +2925,7 @@ static void texture3d_upload_data(struct wined3d_texture *texture, unsigned int
         dst_slice_pitch = dst_row_pitch * update_h;
 
         converted_mem = wined3d_calloc(update_d, dst_slice_pitch);
-        format->convert(data->addr, converted_mem, row_pitch, slice_pitch,
+        wined3d_format_convert(format, data->addr, converted_mem, row_pitch, slice_pitch,
                 dst_row_pitch, dst_slice_pitch, update_w, update_h, update_d);
         mem = converted_mem;
     }
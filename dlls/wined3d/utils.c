@@ -30,8 +30,10 @@
 #include <stdio.h>
 
 #include "wined3d_private.h"
+#include "wine/bands.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 
 #define WINED3D_FORMAT_FOURCC_BASE (WINED3DFMT_BC7_UNORM_SRGB + 1)
 
@@ -439,20 +441,18 @@ static void convert_l4a4_unorm(const BYTE *src, BYTE *dst, UINT src_row_pitch, U
      */
     unsigned int x, y, z;
     const unsigned char *Source;
-    unsigned char *Dest;
+    WORD *Dest;
 
     for (z = 0; z < depth; z++)
     {
         for (y = 0; y < height; y++)
         {
             Source = src + z * src_slice_pitch + y * src_row_pitch;
-            Dest = dst + z * dst_slice_pitch + y * dst_row_pitch;
+            Dest = (WORD *)(dst + z * dst_slice_pitch + y * dst_row_pitch);
             for (x = 0; x < width; x++ )
             {
-                unsigned char color = (*Source++);
-                /* A */ Dest[1] = (color & 0xf0u) << 0;
-                /* L */ Dest[0] = (color & 0x0fu) << 4;
-                Dest += 2;
+                /* A in the high byte, L in the low byte. */
+                Dest[x] = (Source[x] & 0xf0u) << 8 | (Source[x] & 0x0fu) << 4;
             }
         }
     }
@@ -605,7 +605,7 @@ static void convert_r8g8_snorm_l8x8_unorm(const BYTE *src, BYTE *dst, UINT src_r
 {
     unsigned int x, y, z;
     const DWORD *Source;
-    unsigned char *Dest;
+    DWORD *Dest;
 
     /* Doesn't work correctly with the fixed function pipeline, but can work in
      * shaders if the shader is adjusted. (There's no use for this format in gl's
@@ -616,14 +616,14 @@ static void convert_r8g8_snorm_l8x8_unorm(const BYTE *src, BYTE *dst, UINT src_r
         for (y = 0; y < height; y++)
         {
             Source = (const DWORD *)(src + z * src_slice_pitch + y * src_row_pitch);
-            Dest = dst + z * dst_slice_pitch + y * dst_row_pitch;
+            Dest = (DWORD *)(dst + z * dst_slice_pitch + y * dst_row_pitch);
             for (x = 0; x < width; x++ )
             {
-                LONG color = (*Source++);
-                /* B */ Dest[0] = ((color >> 16) & 0xff);       /* L */
-                /* G */ Dest[1] = ((color >> 8 ) & 0xff) + 128; /* V */
-                /* R */ Dest[2] = (color         & 0xff) + 128; /* U */
-                Dest += 4;
+                /* Adding 128 to a byte is the same as flipping its top bit. */
+                DWORD color = Source[x];
+                Dest[x] = ((color >> 16) & 0xff)                /* B = L */
+                        | ((color & 0x0000ff00) ^ 0x00008000)   /* G = V */
+                        | ((color & 0x000000ff) ^ 0x00000080) << 16; /* R = U */
             }
         }
     }
@@ -634,7 +634,7 @@ static void convert_r8g8_snorm_l8x8_unorm_nv(const BYTE *src, BYTE *dst, UINT sr
 {
     unsigned int x, y, z;
     const DWORD *Source;
-    unsigned char *Dest;
+    DWORD *Dest;
 
     /* This implementation works with the fixed function pipeline and shaders
      * without further modification after converting the surface.
@@ -644,15 +644,11 @@ static void convert_r8g8_snorm_l8x8_unorm_nv(const BYTE *src, BYTE *dst, UINT sr
         for (y = 0; y < height; y++)
         {
             Source = (const DWORD *)(src + z * src_slice_pitch + y * src_row_pitch);
-            Dest = dst + z * dst_slice_pitch + y * dst_row_pitch;
+            Dest = (DWORD *)(dst + z * dst_slice_pitch + y * dst_row_pitch);
             for (x = 0; x < width; x++ )
             {
-                LONG color = (*Source++);
-                /* L */ Dest[2] = ((color >> 16) & 0xff);   /* L */
-                /* V */ Dest[1] = ((color >> 8 ) & 0xff);   /* V */
-                /* U */ Dest[0] = (color         & 0xff);   /* U */
-                /* I */ Dest[3] = 255;                      /* X */
-                Dest += 4;
+                /* U, V and L keep their positions, I replaces X. */
+                Dest[x] = Source[x] | 0xff000000;
             }
         }
     }
@@ -663,22 +659,22 @@ static void convert_r8g8b8a8_snorm(const BYTE *src, BYTE *dst, UINT src_row_pitc
 {
     unsigned int x, y, z;
     const DWORD *Source;
-    unsigned char *Dest;
+    DWORD *Dest;
 
     for (z = 0; z < depth; z++)
     {
         for (y = 0; y < height; y++)
         {
             Source = (const DWORD *)(src + z * src_slice_pitch + y * src_row_pitch);
-            Dest = dst + z * dst_slice_pitch + y * dst_row_pitch;
+            Dest = (DWORD *)(dst + z * dst_slice_pitch + y * dst_row_pitch);
             for (x = 0; x < width; x++ )
             {
-                LONG color = (*Source++);
-                /* B */ Dest[0] = ((color >> 16) & 0xff) + 128; /* W */
-                /* G */ Dest[1] = ((color >> 8 ) & 0xff) + 128; /* V */
-                /* R */ Dest[2] = (color         & 0xff) + 128; /* U */
-                /* A */ Dest[3] = ((color >> 24) & 0xff) + 128; /* Q */
-                Dest += 4;
+                /* Swap U and W, then add 128 to every channel by flipping
+                 * the top bit of each byte. */
+                DWORD color = Source[x];
+                Dest[x] = ((color & 0xff00ff00)
+                        | (color & 0x00ff0000) >> 16
+                        | (color & 0x000000ff) << 16) ^ 0x80808080;
             }
         }
     }
@@ -3778,6 +3774,118 @@ UINT wined3d_format_calculate_size(const struct wined3d_format *format, UINT ali
     return slice_pitch * depth;
 }
 
+/* Large conversions are split into bands of rows, or of slices for volumes,
+ * which are converted on the thread pool. The converters handle each row
+ * independently, so the result doesn't depend on how the image is split. */
+struct wined3d_convert_job
+{
+    const struct wined3d_format *format;
+    const struct wined3d_color_key_conversion *conversion;
+    const struct wined3d_palette *palette;
+    const struct wined3d_color_key *color_key;
+    const BYTE *src;
+    BYTE *dst;
+    unsigned int src_row_pitch, src_slice_pitch;
+    unsigned int dst_row_pitch, dst_slice_pitch;
+    unsigned int width, height, depth;
+    unsigned int band_size;
+};
+
+static void wined3d_convert_job_run_band(void *param, unsigned int band)
+{
+    const struct wined3d_convert_job *job = param;
+    unsigned int start = band * job->band_size;
+
+    if (job->conversion)
+    {
+        unsigned int count = min(job->band_size, job->height - start);
+
+        job->conversion->convert(job->src + start * job->src_row_pitch, job->src_row_pitch,
+                job->dst + start * job->dst_row_pitch, job->dst_row_pitch,
+                job->width, count, job->palette, job->color_key);
+    }
+    else if (job->depth > 1)
+    {
+        unsigned int count = min(job->band_size, job->depth - start);
+
+        job->format->convert(job->src + start * job->src_slice_pitch,
+                job->dst + start * job->dst_slice_pitch, job->src_row_pitch, job->src_slice_pitch,
+                job->dst_row_pitch, job->dst_slice_pitch, job->width, job->height, count);
+    }
+    else
+    {
+        unsigned int count = min(job->band_size, job->height - start);
+
+        job->format->convert(job->src + start * job->src_row_pitch,
+                job->dst + start * job->dst_row_pitch, job->src_row_pitch, job->src_slice_pitch,
+                job->dst_row_pitch, job->dst_slice_pitch, job->width, count, 1);
+    }
+}
+
+static void wined3d_convert_job_execute(struct wined3d_convert_job *job)
+{
+    unsigned int units, unit_size, count;
+
+    if (job->depth > 1)
+    {
+        units = job->depth;
+        unit_size = job->width * job->height;
+    }
+    else
+    {
+        units = job->height;
+        unit_size = job->width;
+    }
+
+    count = wine_split_bands(units, unit_size, wined3d_settings.convert_threads, &job->band_size);
+    if (count > 1)
+        TRACE_(d3d_perf)("Converting %ux%ux%u texels in %u bands.\n", job->width, job->height, job->depth, count);
+
+    wine_run_bands(wined3d_convert_job_run_band, job, count, wined3d_settings.convert_threads);
+}
+
+void wined3d_format_convert(const struct wined3d_format *format, const BYTE *src, BYTE *dst,
+        unsigned int src_row_pitch, unsigned int src_slice_pitch, unsigned int dst_row_pitch,
+        unsigned int dst_slice_pitch, unsigned int width, unsigned int height, unsigned int depth)
+{
+    struct wined3d_convert_job job;
+
+    memset(&job, 0, sizeof(job));
+    job.format = format;
+    job.src = src;
+    job.dst = dst;
+    job.src_row_pitch = src_row_pitch;
+    job.src_slice_pitch = src_slice_pitch;
+    job.dst_row_pitch = dst_row_pitch;
+    job.dst_slice_pitch = dst_slice_pitch;
+    job.width = width;
+    job.height = height;
+    job.depth = depth;
+
+    wined3d_convert_job_execute(&job);
+}
+
+void wined3d_format_convert_color_key(const struct wined3d_color_key_conversion *conversion,
+        const BYTE *src, unsigned int src_pitch, BYTE *dst, unsigned int dst_pitch, unsigned int width,
+        unsigned int height, const struct wined3d_palette *palette, const struct wined3d_color_key *color_key)
+{
+    struct wined3d_convert_job job;
+
+    memset(&job, 0, sizeof(job));
+    job.conversion = conversion;
+    job.palette = palette;
+    job.color_key = color_key;
+    job.src = src;
+    job.dst = dst;
+    job.src_row_pitch = src_pitch;
+    job.dst_row_pitch = dst_pitch;
+    job.width = width;
+    job.height = height;
+    job.depth = 1;
+
+    wined3d_convert_job_execute(&job);
+}
+
 /*****************************************************************************
  * Trace formatting of useful values
  */
@@ -252,6 +252,7 @@
 @ cdecl wined3d_shader_get_parent(ptr)
 @ cdecl wined3d_shader_incref(ptr)
 @ cdecl wined3d_shader_set_local_constants_float(ptr long ptr long)
+@ cdecl wined3d_shader_translate(ptr long ptr)
 
 @ cdecl wined3d_shader_resource_view_create(ptr ptr ptr ptr ptr)
 @ cdecl wined3d_shader_resource_view_decref(ptr)
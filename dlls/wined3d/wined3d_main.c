@@ -94,6 +94,9 @@ struct wined3d_settings wined3d_settings =
     ~0U,            /* No PS shader model limit by default. */
     ~0u,            /* No CS shader model limit by default. */
     FALSE,          /* 3D support enabled by default. */
+    128,            /* 128 MB on-disk shader program cache. */
+    TRUE,           /* Translate shaders when they are created. */
+    0,              /* Convert large textures on one thread per CPU. */
 };
 
 struct wined3d * CDECL wined3d_create(DWORD flags)
@@ -317,6 +320,16 @@ static BOOL wined3d_dll_init(HINSTANCE hInstDLL)
             TRACE("Limiting PS shader model to %u.\n", wined3d_settings.max_sm_ps);
         if (!get_config_key_dword(hkey, appkey, "MaxShaderModelCS", &wined3d_settings.max_sm_cs))
             TRACE("Limiting CS shader model to %u.\n", wined3d_settings.max_sm_cs);
+        if (!get_config_key_dword(hkey, appkey, "ShaderCacheSize", &wined3d_settings.shader_cache_size))
+            TRACE("Limiting the shader cache to %u MB.\n", wined3d_settings.shader_cache_size);
+        if (!get_config_key(hkey, appkey, "ShaderPrecompile", buffer, size)
+                && !strcmp(buffer, "disabled"))
+        {
+            TRACE("Deferring shader translation to draw time.\n");
+            wined3d_settings.shader_precompile = FALSE;
+        }
+        if (!get_config_key_dword(hkey, appkey, "ConvertThreads", &wined3d_settings.convert_threads))
+            TRACE("Converting textures on up to %u threads.\n", wined3d_settings.convert_threads);
         if (!get_config_key(hkey, appkey, "DirectDrawRenderer", buffer, size)
                 && !strcmp(buffer, "gdi"))
         {
@@ -328,6 +341,14 @@ static BOOL wined3d_dll_init(HINSTANCE hInstDLL)
     if (appkey) RegCloseKey( appkey );
     if (hkey) RegCloseKey( hkey );
 
+    if (!wined3d_settings.convert_threads)
+    {
+        SYSTEM_INFO info;
+
+        GetSystemInfo(&info);
+        wined3d_settings.convert_threads = info.dwNumberOfProcessors;
+    }
+
     wined3d_dxtn_init();
 
     return TRUE;
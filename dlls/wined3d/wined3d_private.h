@@ -400,6 +400,9 @@ struct wined3d_settings
     unsigned int max_sm_ps;
     unsigned int max_sm_cs;
     BOOL no_3d;
+    unsigned int shader_cache_size;
+    BOOL shader_precompile;
+    unsigned int convert_threads;
 };
 
 extern struct wined3d_settings wined3d_settings DECLSPEC_HIDDEN;
@@ -1902,6 +1905,13 @@ struct wined3d_context
     DWORD active_texture;
     DWORD *texture_type;
 
+    /* Shadow of the GL capabilities tracked by context_set_gl_cap(). Only
+     * the bits in gl_caps_known reflect the current GL state. */
+    DWORD gl_caps_known;
+    DWORD gl_caps_enabled;
+    unsigned int gl_cap_calls;
+    unsigned int gl_cap_calls_filtered;
+
     UINT instance_count;
 
     /* The actual opengl context */
@@ -3469,12 +3479,39 @@ enum wined3d_push_constants
 
 #define WINED3D_CS_QUERY_POLL_INTERVAL  10u
 #define WINED3D_CS_QUEUE_SIZE           0x100000u
+#define WINED3D_CS_QUEUE_MAX_SIZE       0x4000000u
+#define WINED3D_CS_QUEUE_SHRINK_COUNT   1024u
 #define WINED3D_CS_SPIN_COUNT           10000000u
+#define WINED3D_CS_MIN_SPIN_COUNT       1000u
 
-struct wined3d_cs_queue
+/* A queue is a chain of ring buffers. When the application thread runs out
+ * of space in the current segment, it starts a larger one and links it from
+ * the old one instead of waiting for the worker thread. The worker frees a
+ * segment once it has moved on to the next one. Once the application thread
+ * has found the queue idle WINED3D_CS_QUEUE_SHRINK_COUNT times since it last
+ * grew, it goes back to a segment of the initial size. */
+struct wined3d_cs_queue_segment
 {
     LONG head, tail;
-    BYTE data[WINED3D_CS_QUEUE_SIZE];
+    struct wined3d_cs_queue_segment *next;
+    SIZE_T size;
+    BYTE data[1];
+};
+
+struct wined3d_cs_queue
+{
+    struct wined3d_cs_queue_segment *read, *write;
+    unsigned int idle_count;
+};
+
+struct wined3d_cs_stats
+{
+    unsigned int commands;
+    SIZE_T bytes;
+    unsigned int stalls;
+    unsigned int grows;
+    LONGLONG wait_time;
+    LONGLONG finish_time;
 };
 
 struct wined3d_cs_ops
@@ -3507,6 +3544,10 @@ struct wined3d_cs
     HANDLE event;
     BOOL waiting_for_event;
     LONG pending_presents;
+
+    unsigned int spin_limit, spin_average;
+    struct wined3d_cs_stats stats;
+    LARGE_INTEGER frequency;
 };
 
 struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device) DECLSPEC_HIDDEN;
@@ -3635,6 +3676,8 @@ struct wined3d_map_range
     UINT size;
 };
 
+#define WINED3D_BUFFER_SLICE_COUNT 3
+
 struct wined3d_buffer
 {
     struct wined3d_resource resource;
@@ -3653,6 +3696,12 @@ struct wined3d_buffer
     SIZE_T maps_size, modified_areas;
     struct wined3d_fence *fence;
 
+    /* Persistently mapped dynamic buffers. The buffer object holds several
+     * copies of the buffer, the current one starts at "bo_offset". */
+    BYTE *persistent_map;
+    unsigned int bo_offset, slice_size, slice;
+    struct wined3d_fence *slice_fences[WINED3D_BUFFER_SLICE_COUNT];
+
     /* conversion stuff */
     UINT decl_change_count, full_conversion_count;
     UINT draw_count;
@@ -3916,6 +3965,7 @@ struct wined3d_shader_limits
 struct wined3d_string_buffer_list
 {
     struct list list;
+    unsigned int allocated;
 };
 
 struct wined3d_string_buffer *string_buffer_get(struct wined3d_string_buffer_list *list) DECLSPEC_HIDDEN;
@@ -4054,6 +4104,10 @@ void find_ds_compile_args(const struct wined3d_state *state, const struct wined3
 void find_gs_compile_args(const struct wined3d_state *state, const struct wined3d_shader *shader,
         struct gs_compile_args *args) DECLSPEC_HIDDEN;
 
+void shader_glsl_init_offline_adapter(struct wined3d_adapter *adapter, BOOL legacy) DECLSPEC_HIDDEN;
+HRESULT shader_glsl_translate(struct wined3d_shader *shader,
+        struct wined3d_shader_translation *translation) DECLSPEC_HIDDEN;
+
 void string_buffer_clear(struct wined3d_string_buffer *buffer) DECLSPEC_HIDDEN;
 BOOL string_buffer_init(struct wined3d_string_buffer *buffer) DECLSPEC_HIDDEN;
 void string_buffer_free(struct wined3d_string_buffer *buffer) DECLSPEC_HIDDEN;
@@ -4278,6 +4332,13 @@ void wined3d_format_calculate_pitch(const struct wined3d_format *format, unsigne
         unsigned int width, unsigned int height, unsigned int *row_pitch, unsigned int *slice_pitch) DECLSPEC_HIDDEN;
 UINT wined3d_format_calculate_size(const struct wined3d_format *format,
         UINT alignment, UINT width, UINT height, UINT depth) DECLSPEC_HIDDEN;
+void wined3d_format_convert(const struct wined3d_format *format, const BYTE *src, BYTE *dst,
+        unsigned int src_row_pitch, unsigned int src_slice_pitch, unsigned int dst_row_pitch,
+        unsigned int dst_slice_pitch, unsigned int width, unsigned int height, unsigned int depth) DECLSPEC_HIDDEN;
+void wined3d_format_convert_color_key(const struct wined3d_color_key_conversion *conversion,
+        const BYTE *src, unsigned int src_pitch, BYTE *dst, unsigned int dst_pitch, unsigned int width,
+        unsigned int height, const struct wined3d_palette *palette,
+        const struct wined3d_color_key *color_key) DECLSPEC_HIDDEN;
 DWORD wined3d_format_convert_from_float(const struct wined3d_format *format,
         const struct wined3d_color *color) DECLSPEC_HIDDEN;
 void wined3d_format_get_float_color_key(const struct wined3d_format *format,
@@ -4320,6 +4381,63 @@ static inline void context_apply_state(struct wined3d_context *context,
     state_table[rep].apply(context, state, rep);
 }
 
+static inline DWORD context_get_gl_cap_bit(GLenum cap)
+{
+    switch (cap)
+    {
+        case GL_ALPHA_TEST:             return 0x0001;
+        case GL_BLEND:                  return 0x0002;
+        case GL_CULL_FACE:              return 0x0004;
+        case GL_DEPTH_CLAMP:            return 0x0008;
+        case GL_DEPTH_TEST:             return 0x0010;
+        case GL_DITHER:                 return 0x0020;
+        case GL_LIGHTING:               return 0x0040;
+        case GL_NORMALIZE:              return 0x0080;
+        case GL_POLYGON_OFFSET_FILL:    return 0x0100;
+        case GL_SCISSOR_TEST:           return 0x0200;
+        case GL_STENCIL_TEST:           return 0x0400;
+        default:                        return 0;
+    }
+}
+
+/* glEnable()/glDisable() that skips the call if the capability is already
+ * known to be in the requested state. All changes to the tracked
+ * capabilities on a wined3d context need to go through this. */
+static inline void context_set_gl_cap(struct wined3d_context *context, GLenum cap, BOOL enable)
+{
+    const struct wined3d_gl_info *gl_info = context->gl_info;
+    DWORD bit = context_get_gl_cap_bit(cap);
+
+    if (context->gl_caps_known & bit && !(context->gl_caps_enabled & bit) == !enable)
+    {
+        ++context->gl_cap_calls_filtered;
+        return;
+    }
+
+    if (enable)
+    {
+        gl_info->gl_ops.gl.p_glEnable(cap);
+        context->gl_caps_enabled |= bit;
+    }
+    else
+    {
+        gl_info->gl_ops.gl.p_glDisable(cap);
+        context->gl_caps_enabled &= ~bit;
+    }
+    context->gl_caps_known |= bit;
+    ++context->gl_cap_calls;
+}
+
+static inline void context_enable_gl_cap(struct wined3d_context *context, GLenum cap)
+{
+    context_set_gl_cap(context, cap, TRUE);
+}
+
+static inline void context_disable_gl_cap(struct wined3d_context *context, GLenum cap)
+{
+    context_set_gl_cap(context, cap, FALSE);
+}
+
 static inline BOOL needs_separate_srgb_gl_texture(const struct wined3d_context *context,
         const struct wined3d_texture *texture)
 {
@@ -0,0 +1,108 @@
+/*
+ * Splitting large image operations into bands run on the thread pool
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#ifndef __WINE_WINE_BANDS_H
+#define __WINE_WINE_BANDS_H
+
+/* An image operation is split into bands of rows (or slices), and the bands
+ * are processed concurrently on the thread pool.  The caller guarantees that
+ * bands are independent, so the result doesn't depend on the split. */
+
+#define WINE_BAND_MIN_SIZE  (256 * 256)  /* smaller operations are processed sequentially */
+#define WINE_BAND_SIZE      (64 * 64)    /* preferred number of elements per band */
+#define WINE_MAX_BANDS      64
+
+struct wine_band_job
+{
+    void  (*run)( void *param, unsigned int band );
+    void   *param;
+    LONG    count;
+    LONG    next;
+    LONG    refcount;
+    HANDLE  done;
+};
+
+/* Splits units (rows or slices) of unit_size elements each into bands.
+ * Returns the number of bands, and the number of units per band in band_size. */
+static inline unsigned int wine_split_bands( unsigned int units, unsigned int unit_size,
+                                             unsigned int threads, unsigned int *band_size )
+{
+    unsigned int size;
+
+    *band_size = units;
+    if (!units) return 0;
+    if (threads <= 1 || !unit_size || (ULONGLONG)units * unit_size < WINE_BAND_MIN_SIZE) return 1;
+
+    size = WINE_BAND_SIZE / unit_size;
+    if (!size) size = 1;
+    if (size < (units + WINE_MAX_BANDS - 1) / WINE_MAX_BANDS) size = (units + WINE_MAX_BANDS - 1) / WINE_MAX_BANDS;
+    *band_size = size;
+    return (units + size - 1) / size;
+}
+
+static inline void wine_band_job_process( struct wine_band_job *job )
+{
+    LONG band;
+
+    while ((band = InterlockedIncrement( &job->next ) - 1) < job->count)
+        job->run( job->param, band );
+}
+
+static inline void wine_band_job_release( struct wine_band_job *job )
+{
+    if (!InterlockedDecrement( &job->refcount )) SetEvent( job->done );
+}
+
+static inline void CALLBACK wine_band_job_worker( TP_CALLBACK_INSTANCE *instance, void *context )
+{
+    struct wine_band_job *job = context;
+
+    wine_band_job_process( job );
+    wine_band_job_release( job );
+}
+
+/* Runs all the bands on up to threads threads.  The calling thread takes part
+ * and returns once every band is done. */
+static inline void wine_run_bands( void (*run)( void *param, unsigned int band ), void *param,
+                                   unsigned int count, unsigned int threads )
+{
+    struct wine_band_job job;
+    unsigned int i, workers = (threads < count ? threads : count);
+
+    if (workers <= 1 || !(job.done = CreateEventW( NULL, TRUE, FALSE, NULL )))
+    {
+        for (i = 0; i < count; i++) run( param, i );
+        return;
+    }
+
+    job.run      = run;
+    job.param    = param;
+    job.count    = count;
+    job.next     = 0;
+    job.refcount = workers--;
+
+    for (i = 0; i < workers; i++)
+        if (!TrySubmitThreadpoolCallback( wine_band_job_worker, &job, NULL )) wine_band_job_release( &job );
+
+    /* the job lives on the stack, wait until every worker has released it */
+    wine_band_job_process( &job );
+    if (InterlockedDecrement( &job.refcount )) WaitForSingleObject( job.done, INFINITE );
+    CloseHandle( job.done );
+}
+
+#endif  /* __WINE_WINE_BANDS_H */
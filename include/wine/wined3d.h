@@ -1572,6 +1572,8 @@ enum wined3d_shader_byte_code_format
 #define WINED3D_VIEW_TEXTURE_CUBE                               0x00000008
 #define WINED3D_VIEW_TEXTURE_ARRAY                              0x00000010
 
+#define WINED3D_SHADER_TRANSLATE_LEGACY_GLSL                    0x00000001
+
 struct wined3d_display_mode
 {
     UINT width;
@@ -2047,6 +2049,14 @@ struct wined3d_shader_desc
     unsigned int max_version;
 };
 
+struct wined3d_shader_translation
+{
+    char *glsl;
+    unsigned int glsl_buffer_size;
+    unsigned int glsl_size;
+    unsigned int string_buffer_count;
+};
+
 struct wined3d_stream_output_element
 {
     unsigned int stream_idx;
@@ -2631,6 +2641,8 @@ void * __cdecl wined3d_shader_get_parent(const struct wined3d_shader *shader);
 ULONG __cdecl wined3d_shader_incref(struct wined3d_shader *shader);
 HRESULT __cdecl wined3d_shader_set_local_constants_float(struct wined3d_shader *shader,
         UINT start_idx, const float *src_data, UINT vector4f_count);
+HRESULT __cdecl wined3d_shader_translate(const struct wined3d_shader_desc *desc, DWORD flags,
+        struct wined3d_shader_translation *translation);
 
 HRESULT __cdecl wined3d_shader_resource_view_create(const struct wined3d_view_desc *desc,
         struct wined3d_resource *resource, void *parent, const struct wined3d_parent_ops *parent_ops,